@@ -37,7 +37,8 @@ EventImpl::~EventImpl ()
 }
 
 EventImpl::EventImpl ()
-  : m_cancel (false)
+  : m_cancel (false),
+    m_schedulerIndex (0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -65,6 +65,19 @@ public:
    * Checked by the simulation engine before calling Invoke().
    */
   bool IsCancelled (void);
+  /**
+   * Record the position of this event in the event list.
+   *
+   * Only used by schedulers which locate an event through its
+   * position rather than by searching for it, see IndexedHeapScheduler.
+   *
+   * \param [in] index The position of this event.
+   */
+  inline void SetSchedulerIndex (uint32_t index);
+  /**
+   * \returns The position recorded by SetSchedulerIndex().
+   */
+  inline uint32_t GetSchedulerIndex (void) const;
 
 protected:
   /**
@@ -77,8 +90,21 @@ protected:
 
 private:
   bool m_cancel;  /**< Has this event been cancelled. */
+  uint32_t m_schedulerIndex;  /**< Position of this event in the event list. */
 };
 
+void
+EventImpl::SetSchedulerIndex (uint32_t index)
+{
+  m_schedulerIndex = index;
+}
+
+uint32_t
+EventImpl::GetSchedulerIndex (void) const
+{
+  return m_schedulerIndex;
+}
+
 } // namespace ns3
 
 #endif /* EVENT_IMPL_H */
@@ -0,0 +1,168 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2017 Regents of the University of California
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "indexed-heap-scheduler.h"
+#include "event-impl.h"
+#include "assert.h"
+#include "log.h"
+
+/**
+ * \file
+ * \ingroup scheduler
+ * Implementation of ns3::IndexedHeapScheduler class.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("IndexedHeapScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED (IndexedHeapScheduler);
+
+TypeId
+IndexedHeapScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::IndexedHeapScheduler")
+    .SetParent<Scheduler> ()
+    .SetGroupName ("Core")
+    .AddConstructor<IndexedHeapScheduler> ()
+  ;
+  return tid;
+}
+
+IndexedHeapScheduler::IndexedHeapScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+IndexedHeapScheduler::~IndexedHeapScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+IndexedHeapScheduler::Place (uint32_t index, const Event &ev)
+{
+  m_heap[index] = ev;
+  ev.impl->SetSchedulerIndex (index);
+}
+
+void
+IndexedHeapScheduler::SiftUp (uint32_t index, const Event &ev)
+{
+  while (index > 0)
+    {
+      uint32_t parent = (index - 1) / 2;
+      if (!(ev.key < m_heap[parent].key))
+        {
+          break;
+        }
+      Place (index, m_heap[parent]);
+      index = parent;
+    }
+  Place (index, ev);
+}
+
+void
+IndexedHeapScheduler::SiftDown (uint32_t index, const Event &ev)
+{
+  uint32_t size = m_heap.size ();
+  while (true)
+    {
+      uint32_t child = 2 * index + 1;
+      if (child >= size)
+        {
+          break;
+        }
+      if (child + 1 < size && m_heap[child + 1].key < m_heap[child].key)
+        {
+          ++child;
+        }
+      if (!(m_heap[child].key < ev.key))
+        {
+          break;
+        }
+      Place (index, m_heap[child]);
+      index = child;
+    }
+  Place (index, ev);
+}
+
+void
+IndexedHeapScheduler::RemoveAt (uint32_t index)
+{
+  Event last = m_heap.back ();
+  m_heap.pop_back ();
+  if (index == m_heap.size ())
+    {
+      // the removed event was the last one
+      return;
+    }
+  if (index > 0 && last.key < m_heap[(index - 1) / 2].key)
+    {
+      SiftUp (index, last);
+    }
+  else
+    {
+      SiftDown (index, last);
+    }
+}
+
+void
+IndexedHeapScheduler::Insert (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << &ev);
+  m_heap.push_back (ev);
+  SiftUp (m_heap.size () - 1, ev);
+}
+
+bool
+IndexedHeapScheduler::IsEmpty (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_heap.empty ();
+}
+
+Scheduler::Event
+IndexedHeapScheduler::PeekNext (void) const
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!m_heap.empty ());
+  return m_heap.front ();
+}
+
+Scheduler::Event
+IndexedHeapScheduler::RemoveNext (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!m_heap.empty ());
+  Event next = m_heap.front ();
+  RemoveAt (0);
+  return next;
+}
+
+void
+IndexedHeapScheduler::Remove (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << &ev);
+  uint32_t index = ev.impl->GetSchedulerIndex ();
+  NS_ASSERT (index < m_heap.size ());
+  NS_ASSERT (m_heap[index].impl == ev.impl && m_heap[index].key.m_uid == ev.key.m_uid);
+  RemoveAt (index);
+}
+
+} // namespace ns3
@@ -0,0 +1,111 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2017 Regents of the University of California
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef INDEXED_HEAP_SCHEDULER_H
+#define INDEXED_HEAP_SCHEDULER_H
+
+#include "scheduler.h"
+#include <stdint.h>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::IndexedHeapScheduler declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup scheduler
+ * \brief a binary heap event scheduler with O(log n) removal
+ *
+ * The event list is a binary heap, like in HeapScheduler, but every
+ * event keeps track of its own position in the heap (see
+ * EventImpl::SetSchedulerIndex). Removing an arbitrary event, which
+ * HeapScheduler does by searching the whole heap, therefore costs
+ * only the O(log n) restoration of the heap order.
+ *
+ * This makes a difference for workloads which remove (rather than
+ * merely cancel) most of the events they schedule before they expire,
+ * such as protocol timers which are rescheduled on every packet.
+ *
+ * Unlike HeapScheduler, the heap is indexed from 0, and entries are
+ * moved into a hole rather than swapped, so that each moved entry has
+ * its position updated once.
+ */
+class IndexedHeapScheduler : public Scheduler
+{
+public:
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Constructor. */
+  IndexedHeapScheduler ();
+  /** Destructor. */
+  virtual ~IndexedHeapScheduler ();
+
+  // Inherited
+  virtual void Insert (const Scheduler::Event &ev);
+  virtual bool IsEmpty (void) const;
+  virtual Scheduler::Event PeekNext (void) const;
+  virtual Scheduler::Event RemoveNext (void);
+  virtual void Remove (const Scheduler::Event &ev);
+
+private:
+  /** Event list type:  vector of Events, managed as a heap. */
+  typedef std::vector<Scheduler::Event> BinaryHeap;
+
+  /**
+   * Store an event at a given position and record the position in the event.
+   *
+   * \param [in] index The position.
+   * \param [in] ev The event.
+   */
+  inline void Place (uint32_t index, const Scheduler::Event &ev);
+  /**
+   * Move an event from a hole towards the root until its parent is smaller.
+   *
+   * \param [in] index The position of the hole.
+   * \param [in] ev The event to place.
+   */
+  void SiftUp (uint32_t index, const Scheduler::Event &ev);
+  /**
+   * Move an event from a hole towards the bottom until its children are larger.
+   *
+   * \param [in] index The position of the hole.
+   * \param [in] ev The event to place.
+   */
+  void SiftDown (uint32_t index, const Scheduler::Event &ev);
+  /**
+   * Remove the event at a given position.
+   *
+   * \param [in] index The position of the event to remove.
+   */
+  void RemoveAt (uint32_t index);
+
+  /** The event list. */
+  BinaryHeap m_heap;
+};
+
+} // namespace ns3
+
+#endif /* INDEXED_HEAP_SCHEDULER_H */
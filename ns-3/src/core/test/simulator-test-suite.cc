@@ -21,9 +21,12 @@
 #include "ns3/simulator.h"
 #include "ns3/list-scheduler.h"
 #include "ns3/heap-scheduler.h"
+#include "ns3/indexed-heap-scheduler.h"
 #include "ns3/map-scheduler.h"
 #include "ns3/calendar-scheduler.h"
 
+#include <vector>
+
 using namespace ns3;
 
 class SimulatorEventsTestCase : public TestCase
@@ -168,6 +171,80 @@ SimulatorEventsTestCase::DoRun (void)
   NS_TEST_EXPECT_MSG_EQ (m_destroy, true, "Event should have run");
 }
 
+class SimulatorRemoveTestCase : public TestCase
+{
+public:
+  SimulatorRemoveTestCase (ObjectFactory schedulerFactory);
+  virtual void DoRun (void);
+  void Event (uint32_t i);
+  std::vector<EventId> m_ids;
+  std::vector<bool> m_removed;
+  uint32_t m_nRun;
+  uint64_t m_lastNs;
+  bool m_inOrder;
+  ObjectFactory m_schedulerFactory;
+};
+
+SimulatorRemoveTestCase::SimulatorRemoveTestCase (ObjectFactory schedulerFactory)
+  : TestCase ("Check that removing many events is working with " +
+              schedulerFactory.GetTypeId ().GetName ()),
+    m_schedulerFactory (schedulerFactory)
+{
+}
+
+void
+SimulatorRemoveTestCase::Event (uint32_t i)
+{
+  if (m_removed[i] || Now ().GetNanoSeconds () < m_lastNs)
+    {
+      m_inOrder = false;
+    }
+  m_lastNs = Now ().GetNanoSeconds ();
+  ++m_nRun;
+  // remove a not yet expired event from time to time while running
+  uint32_t j = (i * 7919) % m_ids.size ();
+  if (!m_removed[j] && !m_ids[j].IsExpired ())
+    {
+      Simulator::Remove (m_ids[j]);
+      m_removed[j] = true;
+    }
+}
+
+void
+SimulatorRemoveTestCase::DoRun (void)
+{
+  const uint32_t nEvents = 1000;
+  m_nRun = 0;
+  m_lastNs = 0;
+  m_inOrder = true;
+  m_ids.clear ();
+  m_removed.assign (nEvents, false);
+
+  Simulator::SetScheduler (m_schedulerFactory);
+
+  for (uint32_t i = 0; i < nEvents; ++i)
+    {
+      // several events share each timestamp
+      m_ids.push_back (Simulator::Schedule (NanoSeconds ((i * 37) % 101),
+                                            &SimulatorRemoveTestCase::Event, this, i));
+    }
+  for (uint32_t i = 0; i < nEvents; i += 3)
+    {
+      Simulator::Remove (m_ids[i]);
+      m_removed[i] = true;
+    }
+  uint32_t nRemoved = 0;
+  Simulator::Run ();
+  for (uint32_t i = 0; i < nEvents; ++i)
+    {
+      nRemoved += m_removed[i];
+      NS_TEST_EXPECT_MSG_EQ (m_ids[i].IsExpired (), true, "Event " << i << " is still pending");
+    }
+  NS_TEST_EXPECT_MSG_EQ (m_inOrder, true, "Events did not run in order, or removed events ran");
+  NS_TEST_EXPECT_MSG_EQ (m_nRun + nRemoved, nEvents, "Some events neither ran nor were removed");
+  Simulator::Destroy ();
+}
+
 class SimulatorTemplateTestCase : public TestCase
 {
 public:
@@ -473,7 +550,18 @@ public:
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
     factory.SetTypeId (HeapScheduler::GetTypeId ());
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (IndexedHeapScheduler::GetTypeId ());
+    AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
     factory.SetTypeId (CalendarScheduler::GetTypeId ());
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+
+    factory.SetTypeId (MapScheduler::GetTypeId ());
+    AddTestCase (new SimulatorRemoveTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (HeapScheduler::GetTypeId ());
+    AddTestCase (new SimulatorRemoveTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (IndexedHeapScheduler::GetTypeId ());
+    AddTestCase (new SimulatorRemoveTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (CalendarScheduler::GetTypeId ());
+    AddTestCase (new SimulatorRemoveTestCase (factory), TestCase::QUICK);
   }
 } g_simulatorTestSuite;
@@ -240,6 +240,7 @@ public:
     std::string schedulerTypes[] = {
       "ns3::ListScheduler",
       "ns3::HeapScheduler",
+      "ns3::IndexedHeapScheduler",
       "ns3::MapScheduler",
       "ns3::CalendarScheduler"
     };
@@ -0,0 +1,150 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *
+ * This example measures the cost of loading a large ns-2 movement trace
+ * with Ns2MobilityHelper.
+ *
+ *  - behavior:
+ *      - A synthetic trace is written to traceFile: nodeNum nodes start at
+ *        random positions, and every node receives a new setdest every
+ *        interval seconds until duration.
+ *      - The trace is installed on nodeNum nodes, and the simulation is run
+ *        until duration.
+ *  - expected output: the number of lines of the trace, the wall-clock time
+ *    spent in Install () and in Simulator::Run (), the resident memory
+ *    after Install (), and the number of course changes of the nodes.
+ *
+ * Usage of ns2-mobility-helper-benchmark:
+ *
+ *  ./waf --run "ns2-mobility-helper-benchmark \
+ *        --nodeNum=500 --duration=1000 --interval=1"
+ */
+
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <unistd.h>
+
+#include "ns3/core-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/ns2-mobility-helper.h"
+
+using namespace ns3;
+
+// Resident memory of this process in bytes, or 0 where /proc is not available
+static uint64_t
+GetResidentMemory (void)
+{
+  std::ifstream statm ("/proc/self/statm");
+  uint64_t size = 0;
+  uint64_t resident = 0;
+  statm >> size >> resident;
+  return resident * sysconf (_SC_PAGESIZE);
+}
+
+// Wall-clock seconds elapsed since start
+static double
+GetElapsed (const timespec &start)
+{
+  timespec now;
+  clock_gettime (CLOCK_MONOTONIC, &now);
+  return (now.tv_sec - start.tv_sec) + (now.tv_nsec - start.tv_nsec) * 1e-9;
+}
+
+static uint64_t g_courseChanges = 0;
+
+// Counts the movements executed
+static void
+CourseChange (std::string context, Ptr<const MobilityModel> mobility)
+{
+  ++g_courseChanges;
+}
+
+// Write a trace where each node moves to a random destination every interval
+static uint64_t
+WriteTrace (std::string traceFile, uint32_t nodeNum, double duration, double interval)
+{
+  Ptr<UniformRandomVariable> coord = CreateObject<UniformRandomVariable> ();
+  coord->SetAttribute ("Max", DoubleValue (1000));
+  Ptr<UniformRandomVariable> speed = CreateObject<UniformRandomVariable> ();
+  speed->SetAttribute ("Min", DoubleValue (1));
+  speed->SetAttribute ("Max", DoubleValue (30));
+
+  std::ofstream os (traceFile.c_str ());
+  uint64_t nLines = 0;
+  for (uint32_t i = 0; i < nodeNum; ++i)
+    {
+      os << "$node_(" << i << ") set X_ " << coord->GetValue () << "\n";
+      os << "$node_(" << i << ") set Y_ " << coord->GetValue () << "\n";
+      os << "$node_(" << i << ") set Z_ 0\n";
+      nLines += 3;
+    }
+  for (double at = 0; at < duration; at += interval)
+    {
+      for (uint32_t i = 0; i < nodeNum; ++i)
+        {
+          os << "$ns_ at " << at << " \"$node_(" << i << ") setdest "
+             << coord->GetValue () << " " << coord->GetValue () << " "
+             << speed->GetValue () << "\"\n";
+          ++nLines;
+        }
+    }
+  return nLines;
+}
+
+int main (int argc, char *argv[])
+{
+  std::string traceFile = "ns2-mobility-helper-benchmark.ns_movements";
+  uint32_t nodeNum = 500;
+  double duration = 1000;
+  double interval = 1;
+
+  CommandLine cmd;
+  cmd.AddValue ("traceFile", "Ns2 movement trace file to write", traceFile);
+  cmd.AddValue ("nodeNum", "Number of nodes", nodeNum);
+  cmd.AddValue ("duration", "Duration of the trace and of the simulation", duration);
+  cmd.AddValue ("interval", "Interval between two setdest of a node", interval);
+  cmd.Parse (argc, argv);
+
+  uint64_t nLines = WriteTrace (traceFile, nodeNum, duration, interval);
+
+  NodeContainer nodes;
+  nodes.Create (nodeNum);
+  uint64_t initialMemory = GetResidentMemory ();
+
+  timespec start;
+  clock_gettime (CLOCK_MONOTONIC, &start);
+  Ns2MobilityHelper ns2 = Ns2MobilityHelper (traceFile);
+  ns2.Install ();
+  double installTime = GetElapsed (start);
+  uint64_t installMemory = GetResidentMemory () - initialMemory;
+
+  Config::Connect ("/NodeList/*/$ns3::MobilityModel/CourseChange",
+                   MakeCallback (&CourseChange));
+
+  clock_gettime (CLOCK_MONOTONIC, &start);
+  Simulator::Stop (Seconds (duration));
+  Simulator::Run ();
+  double runTime = GetElapsed (start);
+  Simulator::Destroy ();
+
+  std::cout << "lines=" << nLines
+            << " install=" << installTime << "s"
+            << " installMemory=" << installMemory / 1024 << "kB"
+            << " run=" << runTime << "s"
+            << " courseChanges=" << g_courseChanges << std::endl;
+  return 0;
+}
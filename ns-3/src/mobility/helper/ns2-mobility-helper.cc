@@ -38,12 +38,15 @@
  */
 
 
+#include <algorithm>
 #include <fstream>
 #include <sstream>
 #include <map>
+#include <vector>
 #include "ns3/log.h"
 #include "ns3/unused.h"
 #include "ns3/simulator.h"
+#include "ns3/simple-ref-count.h"
 #include "ns3/node-list.h"
 #include "ns3/node.h"
 #include "ns3/constant-velocity-mobility-model.h"
@@ -76,10 +79,15 @@ struct ParseResult
   std::vector<bool> has_dval; //!< points if a tokens has a double value
   std::vector<std::string> svals;  //!< string value for each token
 };
+/**
+ * Index of no movement in Ns2NodeMovements::m_movements
+ */
+static const std::size_t NO_MOVEMENT = static_cast<std::size_t> (-1);
+
 /**
  * Keeps last movement schedule. If new movement occurs during
  * a current one, node stopping must be cancels (stored in a proper
- * event ID), actually reached point must be calculated and new
+ * movement index), actually reached point must be calculated and new
  * velocity must be calculated in accordance with actually reached
  * destination.
  */
@@ -88,18 +96,65 @@ struct DestinationPoint
   Vector m_startPosition;     //!< Start position of last movement
   Vector m_speed;             //!< Speed of the last movement (needed to derive reached destination at next schedule = start + velocity * actuallyTravelled)
   Vector m_finalPosition;     //!< Final destination to be reached before next schedule. Replaced with actually reached if needed.
-  EventId m_stopEvent;        //!< Event scheduling node's stop. May be canceled if needed.
+  std::size_t m_stopMovement; //!< Movement stopping the node, or NO_MOVEMENT. May be canceled if needed.
   double m_travelStartTime;   //!< Travel start time is needed to calculate actually traveled time
   double m_targetArrivalTime; //!< When a station arrives to a destination
   DestinationPoint () :
     m_startPosition (Vector (0,0,0)),
     m_speed (Vector (0,0,0)),
     m_finalPosition (Vector (0,0,0)),
+    m_stopMovement (NO_MOVEMENT),
     m_travelStartTime (0),
     m_targetArrivalTime (0)
   {};
 };
 
+/**
+ * Line of the trace which sets a position or schedules a movement,
+ * kept between the two passes over the parsed trace
+ */
+struct Ns2TraceLine
+{
+  /// Kind of line
+  enum Type
+  {
+    INITIAL_POSITION, //!< line like $node_(0) set X_ 151.05
+    SETDEST,          //!< line like $ns_ at 1 "$node_(0) setdest 2 3 4"
+    SET_POSITION      //!< line like $ns_ at 4 "$node_(0) set X_ 28"
+  };
+
+  int m_nodeId;       //!< Node id
+  Type m_type;        //!< Kind of line
+  char m_coord;       //!< Coordinate set by INITIAL_POSITION and SET_POSITION lines: 'X', 'Y' or 'Z'
+  double m_at;        //!< Time of SETDEST and SET_POSITION lines
+  double m_values[3]; //!< Coordinate value, or destination x, y and speed of SETDEST lines
+};
+
+/**
+ * Position or velocity change of a node
+ */
+struct Ns2Movement
+{
+  Time m_at;          //!< Time of the change, relative to the installation of the trace
+  Vector m_value;     //!< New position or velocity
+  bool m_isPosition;  //!< Whether m_value is a position or a velocity
+  bool m_isCanceled;  //!< Whether a later line of the trace canceled this change
+};
+
+/**
+ * Movements of a node in time order.  Only the next movement of each node
+ * is scheduled; it schedules the following one when it is executed, so that
+ * the event queue holds one mobility event per node instead of the whole trace.
+ */
+class Ns2NodeMovements : public SimpleRefCount<Ns2NodeMovements>
+{
+public:
+  Ptr<ConstantVelocityMobilityModel> m_model; //!< Mobility model of the node
+  std::vector<Ns2Movement> m_movements;       //!< Movements in time order, once the trace is parsed
+  std::size_t m_next;                         //!< Index of the next movement to execute
+  Time m_start;                               //!< Simulation time at which the trace was installed
+};
+
 
 /**
  * Parses a line of ns2 mobility
@@ -168,7 +223,7 @@ static bool IsSchedMobilityPos (ParseResult pr);
 /**
  * Set waypoints and speed for movement.
  */
-static DestinationPoint SetMovement (Ptr<ConstantVelocityMobilityModel> model, Vector lastPos, double at,
+static DestinationPoint SetMovement (Ns2NodeMovements& node, Vector lastPos, double at,
                                      double xFinalPosition, double yFinalPosition, double speed);
 
 /**
@@ -179,7 +234,28 @@ static Vector SetInitialPosition (Ptr<ConstantVelocityMobilityModel> model, std:
 /** 
  * Schedule a set of position for a node
  */
-static Vector SetSchedPosition (Ptr<ConstantVelocityMobilityModel> model, double at, std::string coord, double coordVal);
+static Vector SetSchedPosition (Ns2NodeMovements& node, double at, std::string coord, double coordVal);
+
+/**
+ * Add a position or velocity change to the movements of a node
+ * \return index of the movement
+ */
+static std::size_t AddMovement (Ns2NodeMovements& node, double at, Vector value, bool isPosition);
+
+/**
+ * Cancel a movement of a node, if any
+ */
+static void CancelMovement (Ns2NodeMovements& node, std::size_t index);
+
+/**
+ * Sort the movements of a node, and schedule the first one
+ */
+static void StartMovements (Ptr<Ns2NodeMovements> node);
+
+/**
+ * Execute the next movement of a node, and schedule the following one
+ */
+static void DoMovement (Ptr<Ns2NodeMovements> node);
 
 
 Ns2MobilityHelper::Ns2MobilityHelper (std::string filename)
@@ -215,24 +291,22 @@ void
 Ns2MobilityHelper::ConfigNodesMovements (const ObjectStore &store) const
 {
   std::map<int, DestinationPoint> last_pos;    // Stores previous movement scheduled for each node
+  std::map<int, Ptr<Ns2NodeMovements> > nodes; // Movements of each node
+  std::vector<Ns2TraceLine> lines;             // Valid lines of the file, in order
 
   //*****************************************************************
-  // Parse the file the first time to get the initial node positions.
+  // Parse the file once, and keep the lines setting positions or
+  // scheduling movements.
   //*****************************************************************
 
-  // Look through the whole the file for the the initial node
-  // positions to make this helper robust to handle trace files with
-  // the initial node positions at the end.
   std::ifstream file (m_filename.c_str (), std::ios::in);
   if (file.is_open ())
     {
-      while (!file.eof () )
+      std::string line;
+      while (std::getline (file, line))
         {
           int         iNodeId = 0;
           std::string nodeId;
-          std::string line;
-
-          getline (file, line);
 
           // ignore empty lines
           if (line.empty ())
@@ -242,10 +316,10 @@ Ns2MobilityHelper::ConfigNodesMovements (const ObjectStore &store) const
 
           ParseResult pr = ParseNs2Line (line); // Parse line and obtain tokens
 
-          // Check if the line corresponds with setting the initial
-          // node positions
-          if (pr.tokens.size () != 4)
+          // Check if the line corresponds with one of the three types of line
+          if (pr.tokens.size () != 4 && pr.tokens.size () != 7 && pr.tokens.size () != 8)
             {
+              NS_LOG_ERROR ("Line has not correct number of parameters (corrupted file?): " << line << "\n");
               continue;
             }
 
@@ -259,15 +333,28 @@ Ns2MobilityHelper::ConfigNodesMovements (const ObjectStore &store) const
             }
 
           // get mobility model of node
-          Ptr<ConstantVelocityMobilityModel> model = GetMobilityModel (nodeId,store);
-
-          // if model not exists, continue
-          if (model == 0)
+          if (nodes.find (iNodeId) == nodes.end ())
             {
-              NS_LOG_ERROR ("Unknown node ID (corrupted file?): " << nodeId << "\n");
-              continue;
+              Ptr<ConstantVelocityMobilityModel> model = GetMobilityModel (nodeId,store);
+
+              // if model not exists, continue
+              if (model == 0)
+                {
+                  NS_LOG_ERROR ("Unknown node ID (corrupted file?): " << nodeId << "\n");
+                  continue;
+                }
+
+              Ptr<Ns2NodeMovements> node = Create<Ns2NodeMovements> ();
+              node->m_model = model;
+              node->m_next = 0;
+              node->m_start = Simulator::Now ();
+              nodes[iNodeId] = node;
             }
 
+          Ns2TraceLine traceLine;
+          traceLine.m_nodeId = iNodeId;
+          traceLine.m_coord = 0;
+          traceLine.m_at = 0;
 
           /*
            * In this case a initial position is being seted
@@ -275,157 +362,132 @@ Ns2MobilityHelper::ConfigNodesMovements (const ObjectStore &store) const
            */
           if (IsSetInitialPos (pr))
             {
-              DestinationPoint point;
-              //                                                    coord         coord value
-              point.m_finalPosition = SetInitialPosition (model, pr.tokens[2], pr.dvals[3]);
-              last_pos[iNodeId] = point;
-
-              // Log new position
-              NS_LOG_DEBUG ("Positions after parse for node " << iNodeId << " " << nodeId <<
-                            " position = " << last_pos[iNodeId].m_finalPosition);
-            }
-        }
-      file.close ();
-    }
-
-  //*****************************************************************
-  // Parse the file a second time to get the rest of its values
-  //*****************************************************************
-
-  // The reason the file is parsed again is to make this helper robust
-  // to handle trace files with the initial node positions at the end.
-  file.open (m_filename.c_str (), std::ios::in);
-  if (file.is_open ())
-    {
-      while (!file.eof () )
-        {
-          int         iNodeId = 0;
-          std::string nodeId;
-          std::string line;
-
-          getline (file, line);
-
-          // ignore empty lines
-          if (line.empty ())
-            {
+              traceLine.m_type = Ns2TraceLine::INITIAL_POSITION;
+              traceLine.m_coord = pr.tokens[2][0];
+              traceLine.m_values[0] = pr.dvals[3];
+              lines.push_back (traceLine);
               continue;
             }
 
-          ParseResult pr = ParseNs2Line (line); // Parse line and obtain tokens
-
-          // Check if the line corresponds with one of the three types of line
-          if (pr.tokens.size () != 4 && pr.tokens.size () != 7 && pr.tokens.size () != 8)
+          // This is a scheduled event, so time at should be present
+          if (!IsNumber (pr.tokens[2]))
             {
-              NS_LOG_ERROR ("Line has not correct number of parameters (corrupted file?): " << line << "\n");
+              NS_LOG_WARN ("Time is not a number: " << pr.tokens[2]);
               continue;
             }
 
-          // Get the node Id
-          nodeId  = GetNodeIdString (pr);
-          iNodeId = GetNodeIdInt (pr);
-          if (iNodeId == -1)
+          traceLine.m_at = pr.dvals[2]; // set time at
+
+          if ( traceLine.m_at < 0 )
             {
-              NS_LOG_ERROR ("Node number couldn't be obtained (corrupted file?): " << line << "\n");
+              NS_LOG_WARN ("Time is less than cero: " << traceLine.m_at);
               continue;
             }
 
-          // get mobility model of node
-          Ptr<ConstantVelocityMobilityModel> model = GetMobilityModel (nodeId,store);
-
-          // if model not exists, continue
-          if (model == 0)
+          /*
+           * In this case a new waypoint is added
+           * line like $ns_ at 1 "$node_(0) setdest 2 3 4"
+           */
+          if (IsSchedMobilityPos (pr))
             {
-              NS_LOG_ERROR ("Unknown node ID (corrupted file?): " << nodeId << "\n");
-              continue;
+              traceLine.m_type = Ns2TraceLine::SETDEST;
+              traceLine.m_values[0] = pr.dvals[5];
+              traceLine.m_values[1] = pr.dvals[6];
+              traceLine.m_values[2] = pr.dvals[7];
+              lines.push_back (traceLine);
             }
 
-
           /*
-           * In this case a initial position is being seted
-           * line like $node_(0) set X_ 151.05190721688197
+           * Scheduled set position
+           * line like $ns_ at 4.634906291962 "$node_(0) set X_ 28.675920486450"
            */
-          if (IsSetInitialPos (pr))
+          else if (IsSchedSetPos (pr))
             {
-              // This is the second time this file has been parsed,
-              // and the initial node positions were already set the
-              // first time.  So, do nothing this time with this line.
-              continue;
+              traceLine.m_type = Ns2TraceLine::SET_POSITION;
+              traceLine.m_coord = pr.tokens[5][0];
+              traceLine.m_values[0] = pr.dvals[6];
+              lines.push_back (traceLine);
             }
-
-          else // NOW EVENTS TO BE SCHEDULED
+          else
             {
+              NS_LOG_WARN ("Format Line is not correct: " << line << "\n");
+            }
+        }
+      file.close ();
+    }
 
-              // This is a scheduled event, so time at should be present
-              double at;
-
-              if (!IsNumber (pr.tokens[2]))
-                {
-                  NS_LOG_WARN ("Time is not a number: " << pr.tokens[2]);
-                  continue;
-                }
-
-              at = pr.dvals[2]; // set time at
-
-              if ( at < 0 )
-                {
-                  NS_LOG_WARN ("Time is less than cero: " << at);
-                  continue;
-                }
+  //*****************************************************************
+  // Set the initial node positions first, to make this helper robust
+  // to handle trace files with the initial node positions at the end.
+  //*****************************************************************
 
+  for (std::vector<Ns2TraceLine>::const_iterator i = lines.begin (); i != lines.end (); ++i)
+    {
+      if (i->m_type != Ns2TraceLine::INITIAL_POSITION)
+        {
+          continue;
+        }
+      int iNodeId = i->m_nodeId;
+      DestinationPoint point;
+      //                                                                   coord         coord value
+      point.m_finalPosition = SetInitialPosition (nodes[iNodeId]->m_model, std::string (1, i->m_coord) + "_", i->m_values[0]);
+      last_pos[iNodeId] = point;
+
+      // Log new position
+      NS_LOG_DEBUG ("Positions after parse for node " << iNodeId <<
+                    " position = " << last_pos[iNodeId].m_finalPosition);
+    }
 
+  //*****************************************************************
+  // Then compute the movements of each node
+  //*****************************************************************
 
-              /*
-               * In this case a new waypoint is added
-               * line like $ns_ at 1 "$node_(0) setdest 2 3 4"
-               */
-              if (IsSchedMobilityPos (pr))
-                {
-                  if (last_pos[iNodeId].m_targetArrivalTime > at)
-                    {
-                      NS_LOG_LOGIC ("Did not reach a destination! stoptime = " << last_pos[iNodeId].m_targetArrivalTime << ", at = "<<  at);
-                      double actuallytraveled = at - last_pos[iNodeId].m_travelStartTime;
-                      Vector reached = Vector (
-                          last_pos[iNodeId].m_startPosition.x + last_pos[iNodeId].m_speed.x * actuallytraveled,
-                          last_pos[iNodeId].m_startPosition.y + last_pos[iNodeId].m_speed.y * actuallytraveled,
-                          0
-                          );
-                      NS_LOG_LOGIC ("Final point = " << last_pos[iNodeId].m_finalPosition << ", actually reached = " << reached);
-                      last_pos[iNodeId].m_stopEvent.Cancel ();
-                      last_pos[iNodeId].m_finalPosition = reached;
-                    }
-                  //                                     last position     time  X coord     Y coord      velocity
-                  last_pos[iNodeId] = SetMovement (model, last_pos[iNodeId].m_finalPosition, at, pr.dvals[5], pr.dvals[6], pr.dvals[7]);
-
-                  // Log new position
-                  NS_LOG_DEBUG ("Positions after parse for node " << iNodeId << " " << nodeId << " position =" << last_pos[iNodeId].m_finalPosition);
-                }
+  for (std::vector<Ns2TraceLine>::const_iterator i = lines.begin (); i != lines.end (); ++i)
+    {
+      int iNodeId = i->m_nodeId;
+      double at = i->m_at;
+      Ns2NodeMovements &node = *nodes[iNodeId];
 
+      if (i->m_type == Ns2TraceLine::SETDEST)
+        {
+          if (last_pos[iNodeId].m_targetArrivalTime > at)
+            {
+              NS_LOG_LOGIC ("Did not reach a destination! stoptime = " << last_pos[iNodeId].m_targetArrivalTime << ", at = "<<  at);
+              double actuallytraveled = at - last_pos[iNodeId].m_travelStartTime;
+              Vector reached = Vector (
+                  last_pos[iNodeId].m_startPosition.x + last_pos[iNodeId].m_speed.x * actuallytraveled,
+                  last_pos[iNodeId].m_startPosition.y + last_pos[iNodeId].m_speed.y * actuallytraveled,
+                  0
+                  );
+              NS_LOG_LOGIC ("Final point = " << last_pos[iNodeId].m_finalPosition << ", actually reached = " << reached);
+              CancelMovement (node, last_pos[iNodeId].m_stopMovement);
+              last_pos[iNodeId].m_finalPosition = reached;
+            }
+          //                                    last position     time  X coord          Y coord          velocity
+          last_pos[iNodeId] = SetMovement (node, last_pos[iNodeId].m_finalPosition, at, i->m_values[0], i->m_values[1], i->m_values[2]);
 
-              /*
-               * Scheduled set position
-               * line like $ns_ at 4.634906291962 "$node_(0) set X_ 28.675920486450"
-               */
-              else if (IsSchedSetPos (pr))
-                {
-                  //                                         time  coordinate   coord value
-                  last_pos[iNodeId].m_finalPosition = SetSchedPosition (model, at, pr.tokens[5], pr.dvals[6]);
-                  if (last_pos[iNodeId].m_targetArrivalTime > at)
-                    {
-                      last_pos[iNodeId].m_stopEvent.Cancel ();
-                    }
-                  last_pos[iNodeId].m_targetArrivalTime = at;
-                  last_pos[iNodeId].m_travelStartTime = at;
-                  // Log new position
-                  NS_LOG_DEBUG ("Positions after parse for node " << iNodeId << " " << nodeId <<
-                                " position =" << last_pos[iNodeId].m_finalPosition);
-                }
-              else
-                {
-                  NS_LOG_WARN ("Format Line is not correct: " << line << "\n");
-                }
+          // Log new position
+          NS_LOG_DEBUG ("Positions after parse for node " << iNodeId << " position =" << last_pos[iNodeId].m_finalPosition);
+        }
+      else if (i->m_type == Ns2TraceLine::SET_POSITION)
+        {
+          //                                                        time  coordinate                        coord value
+          last_pos[iNodeId].m_finalPosition = SetSchedPosition (node, at, std::string (1, i->m_coord) + "_", i->m_values[0]);
+          if (last_pos[iNodeId].m_targetArrivalTime > at)
+            {
+              CancelMovement (node, last_pos[iNodeId].m_stopMovement);
             }
+          last_pos[iNodeId].m_targetArrivalTime = at;
+          last_pos[iNodeId].m_travelStartTime = at;
+          // Log new position
+          NS_LOG_DEBUG ("Positions after parse for node " << iNodeId <<
+                        " position =" << last_pos[iNodeId].m_finalPosition);
         }
-      file.close ();
+    }
+
+  for (std::map<int, Ptr<Ns2NodeMovements> >::const_iterator i = nodes.begin (); i != nodes.end (); ++i)
+    {
+      StartMovements (i->second);
     }
 }
 
@@ -730,7 +792,7 @@ IsSchedMobilityPos (ParseResult pr)
 }
 
 DestinationPoint
-SetMovement (Ptr<ConstantVelocityMobilityModel> model, Vector last_pos, double at,
+SetMovement (Ns2NodeMovements& node, Vector last_pos, double at,
              double xFinalPosition, double yFinalPosition, double speed)
 {
   DestinationPoint retval;
@@ -742,8 +804,7 @@ SetMovement (Ptr<ConstantVelocityMobilityModel> model, Vector last_pos, double a
   if (speed == 0)
     {
       // We have to maintain last position, and stop the movement
-      retval.m_stopEvent = Simulator::Schedule (Seconds (at), &ConstantVelocityMobilityModel::SetVelocity, model,
-                                                Vector (0, 0, 0));
+      retval.m_stopMovement = AddMovement (node, at, Vector (0, 0, 0), false);
       return retval;
     }
   if (speed > 0)
@@ -766,8 +827,8 @@ SetMovement (Ptr<ConstantVelocityMobilityModel> model, Vector last_pos, double a
       NS_LOG_DEBUG ("Calculated Speed: X=" << xSpeed << " Y=" << ySpeed << " Z=" << zSpeed);
 
       // Set the Values
-      Simulator::Schedule (Seconds (at), &ConstantVelocityMobilityModel::SetVelocity, model, Vector (xSpeed, ySpeed, zSpeed));
-      retval.m_stopEvent = Simulator::Schedule (Seconds (at + time), &ConstantVelocityMobilityModel::SetVelocity, model, Vector (0, 0, 0));
+      AddMovement (node, at, Vector (xSpeed, ySpeed, zSpeed), false);
+      retval.m_stopMovement = AddMovement (node, at + time, Vector (0, 0, 0), false);
       retval.m_finalPosition.x += xSpeed * time;
       retval.m_finalPosition.y += ySpeed * time;
       retval.m_targetArrivalTime += time;
@@ -791,8 +852,10 @@ SetInitialPosition (Ptr<ConstantVelocityMobilityModel> model, std::string coord,
 
 // Schedule a set of position for a node
 Vector
-SetSchedPosition (Ptr<ConstantVelocityMobilityModel> model, double at, std::string coord, double coordVal)
+SetSchedPosition (Ns2NodeMovements& node, double at, std::string coord, double coordVal)
 {
+  Ptr<ConstantVelocityMobilityModel> model = node.m_model;
+
   // update position
   model->SetPosition (SetOneInitialCoord (model->GetPosition (), coord, coordVal));
 
@@ -802,11 +865,89 @@ SetSchedPosition (Ptr<ConstantVelocityMobilityModel> model, double at, std::stri
   position.z = model->GetPosition ().z;
 
   // Chedule next positions
-  Simulator::Schedule (Seconds (at), &ConstantVelocityMobilityModel::SetPosition, model,position);
+  AddMovement (node, at, position, true);
 
   return position;
 }
 
+std::size_t
+AddMovement (Ns2NodeMovements& node, double at, Vector value, bool isPosition)
+{
+  Ns2Movement movement;
+  movement.m_at = Seconds (at);
+  movement.m_value = value;
+  movement.m_isPosition = isPosition;
+  movement.m_isCanceled = false;
+  node.m_movements.push_back (movement);
+  return node.m_movements.size () - 1;
+}
+
+void
+CancelMovement (Ns2NodeMovements& node, std::size_t index)
+{
+  if (index != NO_MOVEMENT)
+    {
+      node.m_movements[index].m_isCanceled = true;
+    }
+}
+
+/**
+ * \return true if the first movement happens before the second one
+ */
+static bool
+IsEarlierMovement (const Ns2Movement& first, const Ns2Movement& second)
+{
+  return first.m_at < second.m_at;
+}
+
+/**
+ * \return true if the movement was canceled
+ */
+static bool
+IsCanceledMovement (const Ns2Movement& movement)
+{
+  return movement.m_isCanceled;
+}
+
+void
+StartMovements (Ptr<Ns2NodeMovements> node)
+{
+  std::vector<Ns2Movement> &movements = node->m_movements;
+  movements.erase (std::remove_if (movements.begin (), movements.end (), IsCanceledMovement),
+                   movements.end ());
+  // movements of a node at the same time keep the order of the trace
+  std::stable_sort (movements.begin (), movements.end (), IsEarlierMovement);
+  std::vector<Ns2Movement> (movements).swap (movements);
+
+  node->m_next = 0;
+  if (!movements.empty ())
+    {
+      Simulator::Schedule (node->m_start + movements[0].m_at - Simulator::Now (), &DoMovement, node);
+    }
+}
+
+void
+DoMovement (Ptr<Ns2NodeMovements> node)
+{
+  const Ns2Movement &movement = node->m_movements[node->m_next];
+  if (movement.m_isPosition)
+    {
+      node->m_model->SetPosition (movement.m_value);
+    }
+  else
+    {
+      node->m_model->SetVelocity (movement.m_value);
+    }
+
+  // the next movement is scheduled now, so at its timestamp it runs after the
+  // events scheduled until now, unlike when the whole trace was scheduled by Install ()
+  ++node->m_next;
+  if (node->m_next < node->m_movements.size ())
+    {
+      Simulator::Schedule (node->m_start + node->m_movements[node->m_next].m_at - Simulator::Now (), &DoMovement, node);
+    }
+}
+
 void
 Ns2MobilityHelper::Install (void) const
 {
@@ -69,6 +69,16 @@ class ConstantVelocityMobilityModel;
  *
  *  See usage example in examples/mobility/ns2-mobility-trace.cc
  *
+ * The trace file is read once when the helper is installed. The movements
+ * of each node are kept in memory in time order, and only the next movement
+ * of each node is scheduled in the simulator, by the movement before it.
+ * Hence a movement runs after the other events of the same timestamp that
+ * were scheduled before the previous movement of its node ran, instead of
+ * before every event scheduled after Install (). Movements of a node keep
+ * the order of the trace; movements of different nodes at the same time
+ * may run in any order. Code that must observe a node after it moved at
+ * time t should use the CourseChange trace source, or run after t.
+ *
  * \bug Rounding errors may cause movement to diverge from the mobility
  * pattern in ns-2 (using the same trace).
  * See https://www.nsnam.org/bugzilla/show_bug.cgi?id=1316
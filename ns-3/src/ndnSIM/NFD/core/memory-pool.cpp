@@ -0,0 +1,128 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2016,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "memory-pool.hpp"
+
+namespace nfd {
+
+constexpr size_t MemoryPool::GRANULARITY;
+constexpr size_t MemoryPool::MIN_CHUNK_SIZE;
+
+MemoryPool::MemoryPool(size_t maxBlockSize, size_t chunkSize)
+  : m_maxBlockSize((maxBlockSize + GRANULARITY - 1) / GRANULARITY * GRANULARITY)
+  , m_chunkSize(std::max(chunkSize, m_maxBlockSize))
+  , m_freeLists(m_maxBlockSize / GRANULARITY, nullptr)
+  , m_nextChunkSizes(m_freeLists.size(), std::min(m_chunkSize, MIN_CHUNK_SIZE))
+{
+}
+
+MemoryPool::~MemoryPool()
+{
+  for (char* chunk : m_chunks) {
+    ::operator delete(chunk);
+  }
+}
+
+void*
+MemoryPool::allocate(size_t size)
+{
+  ++m_stats.nAllocations;
+  if (size == 0 || size > m_maxBlockSize) {
+    ++m_stats.nSystemAllocations;
+    return ::operator new(size);
+  }
+
+  size_t sizeClass = (size - 1) / GRANULARITY;
+  if (m_freeLists[sizeClass] == nullptr) {
+    this->refill(sizeClass);
+  }
+
+  FreeBlock* block = m_freeLists[sizeClass];
+  m_freeLists[sizeClass] = block->next;
+  m_stats.nBytesInUse += (sizeClass + 1) * GRANULARITY;
+  return block;
+}
+
+void
+MemoryPool::deallocate(void* p, size_t size) noexcept
+{
+  if (p == nullptr) {
+    return;
+  }
+
+  ++m_stats.nDeallocations;
+  if (size == 0 || size > m_maxBlockSize) {
+    ::operator delete(p);
+    return;
+  }
+
+  size_t sizeClass = (size - 1) / GRANULARITY;
+  auto block = static_cast<FreeBlock*>(p);
+  block->next = m_freeLists[sizeClass];
+  m_freeLists[sizeClass] = block;
+  m_stats.nBytesInUse -= (sizeClass + 1) * GRANULARITY;
+}
+
+void
+MemoryPool::refill(size_t sizeClass)
+{
+  size_t blockSize = (sizeClass + 1) * GRANULARITY;
+  size_t nBlocks = std::max<size_t>(m_nextChunkSizes[sizeClass] / blockSize, 1);
+  m_nextChunkSizes[sizeClass] = std::min(m_chunkSize, m_nextChunkSizes[sizeClass] * 2);
+
+  char* chunk = static_cast<char*>(::operator new(nBlocks * blockSize));
+  m_chunks.push_back(chunk);
+  ++m_stats.nSystemAllocations;
+  m_stats.nBytesReserved += nBlocks * blockSize;
+
+  // thread the new blocks in address order, so that consecutive allocations are adjacent
+  FreeBlock* next = m_freeLists[sizeClass];
+  for (size_t i = nBlocks; i > 0; --i) {
+    auto block = reinterpret_cast<FreeBlock*>(chunk + (i - 1) * blockSize);
+    block->next = next;
+    next = block;
+  }
+  m_freeLists[sizeClass] = next;
+}
+
+const shared_ptr<MemoryPool>&
+MemoryPool::getDefault()
+{
+  // never destroyed: objects allocated from it may be released during static destruction
+  static auto pool = new shared_ptr<MemoryPool>(make_shared<MemoryPool>());
+  return *pool;
+}
+
+std::ostream&
+operator<<(std::ostream& os, const MemoryPool::Stats& stats)
+{
+  return os << stats.nAllocations << " allocations, "
+            << stats.nDeallocations << " deallocations, "
+            << stats.nSystemAllocations << " system allocations, "
+            << stats.nBytesInUse << " bytes in use, "
+            << stats.nBytesReserved << " bytes reserved";
+}
+
+} // namespace nfd
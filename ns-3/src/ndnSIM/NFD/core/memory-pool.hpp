@@ -0,0 +1,319 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2017,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_CORE_MEMORY_POOL_HPP
+#define NFD_CORE_MEMORY_POOL_HPP
+
+#include "common.hpp"
+
+#include <type_traits>
+
+namespace nfd {
+
+/** \brief a pool of fixed-size memory blocks
+ *
+ *  Requests up to getMaxBlockSize() bytes are rounded up to a multiple of GRANULARITY and served
+ *  from a free list of that size class; free lists are refilled by carving a chunk obtained
+ *  from the system. The first chunk of each size class is small, and each refill doubles the
+ *  chunk size up to the configured maximum, so that a pool serving only a few objects (e.g. the
+ *  tables of a small simulated node) stays small. Released blocks go back to their free list,
+ *  so that a steady stream of same-sized objects (PIT entries, in/out-records, name tree nodes)
+ *  is served without calling the global allocator. Chunks are returned to the system only when
+ *  the pool is destroyed.
+ *  Larger requests are passed through to the global allocator.
+ *
+ *  \warning MemoryPool is not thread-safe.
+ */
+class MemoryPool : noncopyable
+{
+public:
+  /** \brief allocation counters
+   */
+  struct Stats
+  {
+    uint64_t nAllocations = 0; ///< number of blocks handed out
+    uint64_t nDeallocations = 0; ///< number of blocks returned
+    uint64_t nSystemAllocations = 0; ///< number of calls to the global allocator
+    size_t nBytesInUse = 0; ///< bytes currently handed out, after rounding
+    size_t nBytesReserved = 0; ///< bytes in chunks obtained from the system
+  };
+
+  static constexpr size_t GRANULARITY = alignof(std::max_align_t);
+
+  static constexpr size_t MIN_CHUNK_SIZE = 1024;
+
+  /** \param maxBlockSize largest request served from the pool; 0 disables pooling
+   *  \param chunkSize maximum number of bytes obtained from the system to refill a free list;
+   *                   the first chunk of each size class holds MIN_CHUNK_SIZE bytes, or one block
+   */
+  explicit
+  MemoryPool(size_t maxBlockSize = 1024, size_t chunkSize = 65536);
+
+  ~MemoryPool();
+
+  void*
+  allocate(size_t size);
+
+  void
+  deallocate(void* p, size_t size) noexcept;
+
+  size_t
+  getMaxBlockSize() const
+  {
+    return m_maxBlockSize;
+  }
+
+  const Stats&
+  getStats() const
+  {
+    return m_stats;
+  }
+
+  /** \return a process-wide pool, used by tables constructed without a pool of their own
+   */
+  static const shared_ptr<MemoryPool>&
+  getDefault();
+
+private:
+  struct FreeBlock
+  {
+    FreeBlock* next;
+  };
+
+  void
+  refill(size_t sizeClass);
+
+private:
+  size_t m_maxBlockSize;
+  size_t m_chunkSize;
+  std::vector<FreeBlock*> m_freeLists; ///< indexed by size / GRANULARITY - 1
+  std::vector<size_t> m_nextChunkSizes; ///< size of the next chunk of each size class
+  std::vector<char*> m_chunks;
+  Stats m_stats;
+};
+
+std::ostream&
+operator<<(std::ostream& os, const MemoryPool::Stats& stats);
+
+/** \brief a standard allocator drawing from a shared MemoryPool
+ *
+ *  The allocator shares ownership of the pool, so that a pool outlives every object allocated
+ *  from it, e.g. a PIT entry still referenced by a scheduled event after its table is gone.
+ */
+template<typename T>
+class PoolAllocator
+{
+public:
+  typedef T value_type;
+
+  template<typename U>
+  struct rebind
+  {
+    typedef PoolAllocator<U> other;
+  };
+
+  explicit
+  PoolAllocator(shared_ptr<MemoryPool> pool) noexcept
+    : m_pool(std::move(pool))
+  {
+  }
+
+  template<typename U>
+  PoolAllocator(const PoolAllocator<U>& other) noexcept
+    : m_pool(other.getPool())
+  {
+  }
+
+  T*
+  allocate(size_t n)
+  {
+    return static_cast<T*>(m_pool->allocate(n * sizeof(T)));
+  }
+
+  void
+  deallocate(T* p, size_t n) noexcept
+  {
+    m_pool->deallocate(p, n * sizeof(T));
+  }
+
+  const shared_ptr<MemoryPool>&
+  getPool() const
+  {
+    return m_pool;
+  }
+
+private:
+  shared_ptr<MemoryPool> m_pool;
+};
+
+template<typename T, typename U>
+bool
+operator==(const PoolAllocator<T>& lhs, const PoolAllocator<U>& rhs)
+{
+  return lhs.getPool() == rhs.getPool();
+}
+
+template<typename T, typename U>
+bool
+operator!=(const PoolAllocator<T>& lhs, const PoolAllocator<U>& rhs)
+{
+  return lhs.getPool() != rhs.getPool();
+}
+
+/** \brief a few memory blocks embedded in the owning object, backed by a MemoryPool
+ *  \tparam N number of embedded blocks, at most 32
+ *  \tparam BlockSize size of each embedded block
+ *
+ *  Requests that fit are served from the embedded blocks first, so that an object which
+ *  usually holds only a few small children does not allocate anything else.
+ *  The embedded blocks are not used if pooling is disabled (MemoryPool::getMaxBlockSize() == 0),
+ *  so that every request reaches the global allocator.
+ *  The arena must outlive every block allocated from it.
+ */
+template<size_t N, size_t BlockSize>
+class InlineArena : noncopyable
+{
+public:
+  static_assert(N > 0 && N <= 32, "InlineArena supports 1 to 32 blocks");
+
+  explicit
+  InlineArena(shared_ptr<MemoryPool> pool)
+    : m_pool(std::move(pool))
+    , m_used(0)
+  {
+  }
+
+  void*
+  allocate(size_t size)
+  {
+    if (size <= BlockSize && m_pool->getMaxBlockSize() > 0) {
+      for (size_t i = 0; i < N; ++i) {
+        if ((m_used & (1U << i)) == 0) {
+          m_used |= 1U << i;
+          return &m_blocks[i];
+        }
+      }
+    }
+    return m_pool->allocate(size);
+  }
+
+  void
+  deallocate(void* p, size_t size) noexcept
+  {
+    auto block = static_cast<Block*>(p);
+    if (block >= m_blocks && block < m_blocks + N) {
+      m_used &= ~(1U << (block - m_blocks));
+    }
+    else {
+      m_pool->deallocate(p, size);
+    }
+  }
+
+  /** \return number of embedded blocks in use
+   */
+  size_t
+  getNInlineBlocks() const
+  {
+    size_t n = 0;
+    for (size_t i = 0; i < N; ++i) {
+      n += (m_used >> i) & 1;
+    }
+    return n;
+  }
+
+private:
+  typedef typename std::aligned_storage<BlockSize, alignof(std::max_align_t)>::type Block;
+
+  shared_ptr<MemoryPool> m_pool;
+  uint32_t m_used; ///< bitmap of embedded blocks in use
+  Block m_blocks[N];
+};
+
+/** \brief a standard allocator drawing from an arena that it does not own
+ *  \tparam Arena a type providing allocate(size) and deallocate(p, size), e.g. InlineArena
+ */
+template<typename T, typename Arena>
+class ArenaAllocator
+{
+public:
+  typedef T value_type;
+
+  template<typename U>
+  struct rebind
+  {
+    typedef ArenaAllocator<U, Arena> other;
+  };
+
+  explicit
+  ArenaAllocator(Arena& arena) noexcept
+    : m_arena(&arena)
+  {
+  }
+
+  template<typename U>
+  ArenaAllocator(const ArenaAllocator<U, Arena>& other) noexcept
+    : m_arena(&other.getArena())
+  {
+  }
+
+  T*
+  allocate(size_t n)
+  {
+    return static_cast<T*>(m_arena->allocate(n * sizeof(T)));
+  }
+
+  void
+  deallocate(T* p, size_t n) noexcept
+  {
+    m_arena->deallocate(p, n * sizeof(T));
+  }
+
+  Arena&
+  getArena() const
+  {
+    return *m_arena;
+  }
+
+private:
+  Arena* m_arena;
+};
+
+template<typename T, typename U, typename Arena>
+bool
+operator==(const ArenaAllocator<T, Arena>& lhs, const ArenaAllocator<U, Arena>& rhs)
+{
+  return &lhs.getArena() == &rhs.getArena();
+}
+
+template<typename T, typename U, typename Arena>
+bool
+operator!=(const ArenaAllocator<T, Arena>& lhs, const ArenaAllocator<U, Arena>& rhs)
+{
+  return &lhs.getArena() != &rhs.getArena();
+}
+
+} // namespace nfd
+
+#endif // NFD_CORE_MEMORY_POOL_HPP
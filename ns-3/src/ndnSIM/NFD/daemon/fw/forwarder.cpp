@@ -31,6 +31,8 @@
 #include "table/cleanup.hpp"
 #include <ndn-cxx/lp/tags.hpp>
 
+#include "ns3/ndnSIM/utils/ndn-stats-sink.hpp"
+
 #include "face/null-face.hpp"
 
 namespace nfd {
@@ -93,47 +95,26 @@ Forwarder::~Forwarder() = default;
 void
 Forwarder::CountRecord()
 {
-	// 发送记录
-	std::string fileName = "SendRecord/interest_" + std::to_string(m_node->GetId()) +"_Node.csv";
-	std::ofstream fileObj1(fileName,std::ofstream::app);
-	fileObj1<< ns3::Simulator::Now().GetNanoSeconds()<<","<<countInterestSend<<"\n";
-	fileObj1.close();
-
-	fileName = "SendRecord/data_" + std::to_string(m_node->GetId()) +"_Node.csv";
-	std::ofstream fileObj2(fileName,std::ofstream::app);
-	fileObj2<< ns3::Simulator::Now().GetNanoSeconds()<<","<<countDataSend<<"\n";
-	fileObj2.close();
+	using ns3::ndn::StatsSink;
+	std::string nodeSuffix = std::to_string(m_node->GetId()) + "_Node";
+	int64_t now = ns3::Simulator::Now().GetNanoSeconds();
 
+	// 发送记录
+	StatsSink::GetStream("SendRecord/interest_" + nodeSuffix)->record(now, countInterestSend);
+	StatsSink::GetStream("SendRecord/data_" + nodeSuffix)->record(now, countDataSend);
 
 	// 接收记录
-	fileName = "ReceiveRecord/interest_" + std::to_string(m_node->GetId()) +"_Node.csv";
-	std::ofstream fileObj3(fileName,std::ofstream::app);
-	fileObj3<< ns3::Simulator::Now().GetNanoSeconds()<<","<<countInterestRcv<<"\n";
-	fileObj3.close();
-
-
-	fileName = "ReceiveRecord/data_" + std::to_string(m_node->GetId()) +"_Node.csv";
-	std::ofstream fileObj4(fileName,std::ofstream::app);
-	fileObj4<< ns3::Simulator::Now().GetNanoSeconds()<<","<<countDataRcv<<"\n";
-	fileObj4.close();
+	StatsSink::GetStream("ReceiveRecord/interest_" + nodeSuffix)->record(now, countInterestRcv);
+	StatsSink::GetStream("ReceiveRecord/data_" + nodeSuffix)->record(now, countDataRcv);
 
 	// 输出 pit size
-	std::string pitFile = "SizeResult/pit_" + std::to_string(m_node->GetId()) +"_Node.csv";
-	std::ofstream PitOut(pitFile,std::ofstream::app);
-	PitOut<< ns3::Simulator::Now().GetNanoSeconds()<<","<<m_pit.size()<<"\n";
-	PitOut.close();
+	StatsSink::GetStream("SizeResult/pit_" + nodeSuffix)->record(now, m_pit.size());
 
 	// output CS size
-	std::string csFile = "SizeResult/cs_" + std::to_string(m_node->GetId()) +"_Node.csv";
-	std::ofstream CsOut(csFile,std::ofstream::app);
-	CsOut<< ns3::Simulator::Now().GetNanoSeconds()<<","<<m_cs.size()<<"\n";
-	CsOut.close();
+	StatsSink::GetStream("SizeResult/cs_" + nodeSuffix)->record(now, m_cs.size());
 
 	// output FIB size
-	std::string fibFile = "SizeResult/fib_" + std::to_string(m_node->GetId()) +"_Node.csv";
-	std::ofstream FibOut(fibFile,std::ofstream::app);
-	FibOut<< ns3::Simulator::Now().GetNanoSeconds()<<","<<m_fib.size()<<"\n";
-	FibOut.close();
+	StatsSink::GetStream("SizeResult/fib_" + nodeSuffix)->record(now, m_fib.size());
 
 	time::nanoseconds roundTime =  time::seconds(50);
 	scheduler::schedule(roundTime,bind(&Forwarder::CountRecord, this));
@@ -220,7 +201,7 @@ Forwarder::onIncomingInterest(Face& inFace, const Interest& interest)
                 bind(&Forwarder::onContentStoreMiss, this, ref(inFace), pitEntry, _1));
     }
     else {
-      shared_ptr<Data> match = m_csFromNdnSim->Lookup(interest.shared_from_this());
+      shared_ptr<const Data> match = m_csFromNdnSim->Lookup(interest.shared_from_this());
       if (match != nullptr) {
         this->onContentStoreHit(inFace, pitEntry, interest, *match);
       }
@@ -299,6 +280,8 @@ Forwarder::onContentStoreHit(const Face& inFace, const shared_ptr<pit::Entry>& p
   this->dispatchToStrategy(*pitEntry,
     [&] (fw::Strategy& strategy) { strategy.beforeSatisfyInterest(pitEntry, *m_csFace, data); });
 
+  // cached Data still carries the tags it arrived with
+  data.removeTag<lp::HopCountTag>();
   data.setTag(make_shared<lp::IncomingFaceIdTag>(face::FACEID_CONTENT_STORE));
   // XXX should we lookup PIT for other Interests that also match csMatch?
 
@@ -324,11 +307,11 @@ Forwarder::onOutgoingInterest(const shared_ptr<pit::Entry>& pitEntry, Face& outF
 	// 修改interest包中的字段
 	if(outFace.getId() == 256 || outFace.getId() == 258){
 		ns3::Ptr<ns3::MobilityModel> mobi = m_node->GetObject<ns3::MobilityModel>();
-		const_cast<Interest*>(&interest)->setHopPosx(mobi->GetPosition().x);
-		const_cast<Interest*>(&interest)->setHopPosy(mobi->GetPosition().y);
-		const_cast<Interest*>(&interest)->setHopVelocityX(mobi->GetVelocity().x);
-		const_cast<Interest*>(&interest)->setHopVelocityY(mobi->GetVelocity().y);
-		const_cast<Interest*>(&interest)->setHopId(m_node->GetId());
+		ns3::Vector position = mobi->GetPosition();
+		ns3::Vector velocity = mobi->GetVelocity();
+		// overwrites the HopContext of the encoded Interest, in a copy of its wire if it is shared
+		const_cast<Interest&>(interest).setHopContext(m_node->GetId(), position.x, position.y,
+		                                              velocity.x, velocity.y);
 
 		// 输出interest发送记录
 		countInterestSend++;
@@ -414,15 +397,12 @@ Forwarder::onIncomingData(Face& inFace, const Data& data)
     return;
   }
 
-
-  shared_ptr<Data> dataCopyWithoutTag = make_shared<Data>(data);
-  dataCopyWithoutTag->removeTag<lp::HopCountTag>();
-
-  // CS insert
+  // CS insert: the CS shares the Data with the downstream faces,
+  // per-hop tags are removed when the Data leaves the CS (onContentStoreHit)
   if (m_csFromNdnSim == nullptr)
-    m_cs.insert(*dataCopyWithoutTag);
+    m_cs.insert(data);
   else
-    m_csFromNdnSim->Add(dataCopyWithoutTag);
+    m_csFromNdnSim->Add(data.shared_from_this());
 
   std::set<Face*> pendingDownstreams;
   // foreach PitEntry
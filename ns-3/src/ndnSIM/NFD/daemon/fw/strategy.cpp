@@ -144,10 +144,20 @@ Strategy::Strategy(Forwarder& forwarder)
   , m_forwarder(forwarder)
   , m_measurements(m_forwarder.getMeasurements(), m_forwarder.getStrategyChoice(), *this)
 {
+  this->setInstanceName(Name());
 }
 
 Strategy::~Strategy() = default;
 
+void
+Strategy::setInstanceName(const Name& name)
+{
+  // elements of std::set are never moved; names are never removed because there are only a few
+  // distinct ones, and the set is never destroyed because a strategy may outlive static objects
+  static std::set<Name>& instanceNames = *new std::set<Name>;
+  m_name = &*instanceNames.insert(name).first;
+}
+
 void
 Strategy::beforeSatisfyInterest(const shared_ptr<pit::Entry>& pitEntry,
                                 const Face& inFace, const Data& data)
@@ -109,7 +109,7 @@ public: // constructor, destructor, strategy name
   const Name&
   getInstanceName() const
   {
-    return m_name;
+    return *m_name;
   }
 
 public: // triggers
@@ -292,12 +292,12 @@ protected: // instance name
 
   /** \brief set strategy instance name
    *  \note This must be called by strategy subclass constructor.
+   *
+   *  Instance names are interned, so that the instances of a strategy on all forwarders in
+   *  the process share one copy of the name.
    */
   void
-  setInstanceName(const Name& name)
-  {
-    m_name = name;
-  }
+  setInstanceName(const Name& name);
 
 private: // registry
   typedef std::function<unique_ptr<Strategy>(Forwarder& forwarder, const Name& strategyName)> CreateFunc;
@@ -314,7 +314,7 @@ protected: // accessors
   signal::Signal<FaceTable, Face&>& beforeRemoveFace;
 
 private: // instance fields
-  Name m_name;
+  const Name* m_name; ///< interned instance name, never nullptr
 
   /** \brief reference to the forwarder
    *
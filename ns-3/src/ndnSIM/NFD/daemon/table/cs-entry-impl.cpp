@@ -25,6 +25,8 @@
 
 #include "cs-entry-impl.hpp"
 
+#include <cstring>
+
 namespace nfd {
 namespace cs {
 
@@ -82,6 +84,21 @@ compareDataWithData(const Data& lhs, const Data& rhs)
     return cmp;
   }
 
+  // Name equals: identical packets have identical digests, so that the digests are computed
+  // only when two different packets share the same Name
+  if (&lhs == &rhs) {
+    return 0;
+  }
+  if (lhs.hasWire() && rhs.hasWire()) {
+    const Block& lhsWire = lhs.wireEncode();
+    const Block& rhsWire = rhs.wireEncode();
+    if (lhsWire.size() == rhsWire.size() &&
+        (lhsWire.wire() == rhsWire.wire() ||
+         std::memcmp(lhsWire.wire(), rhsWire.wire(), lhsWire.size()) == 0)) {
+      return 0;
+    }
+  }
+
   return lhs.getFullName()[-1].compare(rhs.getFullName()[-1]);
 }
 
@@ -24,6 +24,7 @@
  */
 
 #include "cs.hpp"
+#include "name-tree-hashtable.hpp"
 #include "core/algorithm.hpp"
 #include "core/asserts.hpp"
 #include "core/logger.hpp"
@@ -75,6 +76,10 @@ Cs::insert(const Data& data, bool isUnsolicited)
 
   entry.updateStaleTime();
 
+  if (isNewEntry) {
+    this->indexEntry(it);
+  }
+
   if (!isNewEntry) { // existing entry
     // XXX This doesn't forbid unsolicited Data from refreshing a solicited entry.
     if (entry.isUnsolicited() && !isUnsolicited) {
@@ -104,18 +109,23 @@ Cs::find(const Interest& interest,
   bool isRightmost = interest.getChildSelector() == 1;
   NFD_LOG_DEBUG("find " << prefix << (isRightmost ? " R" : " L"));
 
-  iterator first = m_table.lower_bound(prefix);
   iterator last = m_table.end();
-  if (prefix.size() > 0) {
-    last = m_table.lower_bound(prefix.getSuccessor());
-  }
-
   iterator match = last;
-  if (isRightmost) {
-    match = this->findRightmost(interest, first, last);
+  if (!isRightmost && (prefix.empty() || !prefix[-1].isImplicitSha256Digest())) {
+    match = this->findLeftmostUnderPrefix(interest);
   }
   else {
-    match = this->findLeftmost(interest, first, last);
+    iterator first = m_table.lower_bound(prefix);
+    if (prefix.size() > 0) {
+      last = m_table.lower_bound(prefix.getSuccessor());
+    }
+
+    if (isRightmost) {
+      match = this->findRightmost(interest, first, last);
+    }
+    else {
+      match = this->findLeftmost(interest, first, last);
+    }
   }
 
   if (match == last) {
@@ -134,6 +144,30 @@ Cs::findLeftmost(const Interest& interest, iterator first, iterator last) const
   return std::find_if(first, last, bind(&cs::EntryImpl::canSatisfy, _1, interest));
 }
 
+iterator
+Cs::findLeftmostUnderPrefix(const Interest& interest) const
+{
+  const Name& prefix = interest.getName();
+
+  // Entries with exact Name sort before entries with longer Names under the same prefix,
+  // so the first entry with exact Name, if any, is also the first entry under the prefix.
+  iterator first;
+  auto found = m_exactIndex.find(&prefix);
+  if (found != m_exactIndex.end()) {
+    first = found->second;
+  }
+  else {
+    first = m_table.lower_bound(prefix);
+  }
+
+  for (iterator it = first; it != m_table.end() && prefix.isPrefixOf(it->getName()); ++it) {
+    if (it->canSatisfy(interest)) {
+      return it;
+    }
+  }
+  return m_table.end();
+}
+
 iterator
 Cs::findRightmost(const Interest& interest, iterator first, iterator last) const
 {
@@ -197,6 +231,7 @@ Cs::setPolicyImpl(unique_ptr<Policy> policy)
   NFD_LOG_DEBUG("set-policy " << policy->getName());
   m_policy = std::move(policy);
   m_beforeEvictConnection = m_policy->beforeEvict.connect([this] (iterator it) {
+      this->unindexEntry(it);
       m_table.erase(it);
     });
 
@@ -204,6 +239,43 @@ Cs::setPolicyImpl(unique_ptr<Policy> policy)
   BOOST_ASSERT(m_policy->getCs() == this);
 }
 
+size_t
+Cs::NameHash::operator()(const Name* name) const
+{
+  return name_tree::computeHash(*name);
+}
+
+void
+Cs::indexEntry(iterator it)
+{
+  const Name& name = it->getName();
+  auto found = m_exactIndex.find(&name);
+  if (found == m_exactIndex.end()) {
+    m_exactIndex.emplace(&name, it);
+  }
+  else if (std::next(it) == found->second) {
+    // new first entry with this Name; the key must point into the mapped entry
+    m_exactIndex.erase(found);
+    m_exactIndex.emplace(&name, it);
+  }
+}
+
+void
+Cs::unindexEntry(iterator it)
+{
+  const Name& name = it->getName();
+  auto found = m_exactIndex.find(&name);
+  if (found == m_exactIndex.end() || found->second != it) {
+    return;
+  }
+  m_exactIndex.erase(found);
+
+  iterator next = std::next(it);
+  if (next != m_table.end() && next->getName() == name) {
+    m_exactIndex.emplace(&next->getName(), next);
+  }
+}
+
 void
 Cs::enableAdmit(bool shouldAdmit)
 {
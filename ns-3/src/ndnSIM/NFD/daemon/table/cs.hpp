@@ -34,6 +34,9 @@
  *  Data packets are wrapped in Entry objects.
  *  Each Entry contain the Data packet itself,
  *  and a few addition attributes such as the staleness of the Data packet.
+ *  A hash index maps each Data Name (without digest) to the first Table entry with that Name,
+ *  so that the common lookup of an Interest for an existing exact Name, without ChildSelector,
+ *  does not search the Table.
  *
  *  The cleanup queues are three doubly linked lists which stores Table iterators.
  *  The three queues keep track of unsolicited, stale, and fresh Data packet, respectively.
@@ -201,6 +204,43 @@ private: // find
   iterator
   findRightmostAmongExact(const Interest& interest, iterator first, iterator last) const;
 
+  /** \brief find leftmost match among entries whose Names start with Interest Name
+   *  \pre Interest Name does not end with an implicit digest
+   *  \return the leftmost match, or m_table.end() if not found
+   */
+  iterator
+  findLeftmostUnderPrefix(const Interest& interest) const;
+
+private: // exact Name index
+  /** \brief hashes the Name pointed to, with the name tree hash function
+   */
+  struct NameHash
+  {
+    size_t
+    operator()(const Name* name) const;
+  };
+
+  struct NameEqual
+  {
+    bool
+    operator()(const Name* lhs, const Name* rhs) const
+    {
+      return *lhs == *rhs;
+    }
+  };
+
+  /** \brief maps a Data Name to the first Table entry with that Name
+   *
+   *  Keys point to the Name of the Data in the mapped entry.
+   */
+  typedef std::unordered_map<const Name*, iterator, NameHash, NameEqual> ExactIndex;
+
+  void
+  indexEntry(iterator it);
+
+  void
+  unindexEntry(iterator it);
+
   void
   setPolicyImpl(unique_ptr<Policy> policy);
 
@@ -210,6 +250,7 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
 
 private:
   Table m_table;
+  ExactIndex m_exactIndex;
   unique_ptr<Policy> m_policy;
   signal::ScopedConnection m_beforeEvictConnection;
 
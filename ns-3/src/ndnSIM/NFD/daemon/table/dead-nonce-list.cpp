@@ -37,36 +37,42 @@ const size_t DeadNonceList::INITIAL_CAPACITY = (1 << 7);
 const size_t DeadNonceList::MIN_CAPACITY = (1 << 3);
 const size_t DeadNonceList::MAX_CAPACITY = (1 << 24);
 const DeadNonceList::Entry DeadNonceList::MARK = 0;
+const DeadNonceList::Entry DeadNonceList::EMPTY_SLOT = 0;
 const size_t DeadNonceList::EXPECTED_MARK_COUNT = 5;
 const double DeadNonceList::CAPACITY_UP = 1.2;
 const double DeadNonceList::CAPACITY_DOWN = 0.9;
 const size_t DeadNonceList::EVICT_LIMIT = (1 << 6);
 
+/** \brief minimum number of slots in the queue and in the hashtable
+ */
+static const size_t MIN_SLOTS = (1 << 4);
+
 DeadNonceList::DeadNonceList(const time::nanoseconds& lifetime)
   : m_lifetime(lifetime)
-  , m_queue(m_index.get<0>())
-  , m_ht(m_index.get<1>())
+  , m_queue(MIN_SLOTS)
+  , m_queueHead(0)
+  , m_queueSize(0)
+  , m_nMarks(0)
+  , m_slots() // allocated upon the first add
+  , m_nSlotsUsed(0)
   , m_capacity(INITIAL_CAPACITY)
   , m_markInterval(m_lifetime / EXPECTED_MARK_COUNT)
-  , m_adjustCapacityInterval(m_lifetime)
+  , m_nMarksSinceAdjust(0)
 {
   if (m_lifetime < MIN_LIFETIME) {
     BOOST_THROW_EXCEPTION(std::invalid_argument("lifetime is less than MIN_LIFETIME"));
   }
 
   for (size_t i = 0; i < EXPECTED_MARK_COUNT; ++i) {
-    m_queue.push_back(MARK);
+    this->pushEntry(MARK);
   }
 
   m_markEvent = scheduler::schedule(m_markInterval, bind(&DeadNonceList::mark, this));
-  m_adjustCapacityEvent = scheduler::schedule(m_adjustCapacityInterval,
-                                              bind(&DeadNonceList::adjustCapacity, this));
 }
 
 DeadNonceList::~DeadNonceList()
 {
   scheduler::cancel(m_markEvent);
-  scheduler::cancel(m_adjustCapacityEvent);
 
   BOOST_ASSERT_MSG(DEFAULT_LIFETIME >= MIN_LIFETIME, "DEFAULT_LIFETIME is too small");
   static_assert(INITIAL_CAPACITY >= MIN_CAPACITY, "INITIAL_CAPACITY is too small");
@@ -78,26 +84,43 @@ DeadNonceList::~DeadNonceList()
   BOOST_ASSERT_MSG(CAPACITY_UP > 1.0, "CAPACITY_UP must adjust up");
   BOOST_ASSERT_MSG(CAPACITY_DOWN < 1.0, "CAPACITY_DOWN must adjust down");
   static_assert(EVICT_LIMIT >= 1, "EVICT_LIMIT must be at least 1");
+  static_assert((MIN_SLOTS & (MIN_SLOTS - 1)) == 0, "MIN_SLOTS must be a power of two");
 }
 
 size_t
 DeadNonceList::size() const
 {
-  return m_queue.size() - this->countMarks();
+  return m_queueSize - this->countMarks();
+}
+
+size_t
+DeadNonceList::getMemoryUsage() const
+{
+  return (m_queue.capacity() + m_slots.capacity()) * sizeof(Entry);
 }
 
 bool
 DeadNonceList::has(const Name& name, uint32_t nonce) const
 {
+  if (m_slots.empty()) {
+    return false;
+  }
+
   Entry entry = DeadNonceList::makeEntry(name, nonce);
-  return m_ht.find(entry) != m_ht.end();
+  for (size_t slot = this->computeSlotIndex(entry); m_slots[slot] != EMPTY_SLOT;
+       slot = (slot + 1) & (m_slots.size() - 1)) {
+    if (m_slots[slot] == entry) {
+      return true;
+    }
+  }
+  return false;
 }
 
 void
 DeadNonceList::add(const Name& name, uint32_t nonce)
 {
   Entry entry = DeadNonceList::makeEntry(name, nonce);
-  m_queue.push_back(entry);
+  this->pushEntry(entry);
 
   this->evictEntries();
 }
@@ -105,27 +128,137 @@ DeadNonceList::add(const Name& name, uint32_t nonce)
 DeadNonceList::Entry
 DeadNonceList::makeEntry(const Name& name, uint32_t nonce)
 {
-  Block nameWire = name.wireEncode();
-  return CityHash64WithSeed(reinterpret_cast<const char*>(nameWire.wire()), nameWire.size(),
-                            static_cast<uint64_t>(nonce));
+  const Block& nameWire = name.wireEncode();
+  Entry entry = CityHash64WithSeed(reinterpret_cast<const char*>(nameWire.wire()), nameWire.size(),
+                                   static_cast<uint64_t>(nonce));
+  // MARK and EMPTY_SLOT are the same reserved value
+  return entry == MARK ? MARK + 1 : entry;
 }
 
-size_t
-DeadNonceList::countMarks() const
+void
+DeadNonceList::pushEntry(Entry entry)
+{
+  // insert into the hashtable first, because resizeSlots reinserts the entries of the queue
+  if (entry == MARK) {
+    ++m_nMarks;
+  }
+  else {
+    this->insertSlot(entry);
+  }
+
+  if (m_queueSize == m_queue.size()) {
+    this->resizeQueue(m_queue.size() * 2);
+  }
+  m_queue[(m_queueHead + m_queueSize) & (m_queue.size() - 1)] = entry;
+  ++m_queueSize;
+}
+
+void
+DeadNonceList::popEntry()
+{
+  BOOST_ASSERT(m_queueSize > 0);
+  Entry entry = m_queue[m_queueHead];
+  m_queueHead = (m_queueHead + 1) & (m_queue.size() - 1);
+  --m_queueSize;
+
+  if (entry == MARK) {
+    --m_nMarks;
+  }
+  else {
+    this->eraseSlot(entry);
+  }
+
+  if (m_queue.size() > MIN_SLOTS && m_queueSize * 4 < m_queue.size()) {
+    this->resizeQueue(m_queue.size() / 2);
+  }
+}
+
+void
+DeadNonceList::resizeQueue(size_t nSlots)
 {
-  return m_ht.count(MARK);
+  BOOST_ASSERT(nSlots >= m_queueSize);
+  std::vector<Entry> queue(nSlots);
+  for (size_t i = 0; i < m_queueSize; ++i) {
+    queue[i] = m_queue[(m_queueHead + i) & (m_queue.size() - 1)];
+  }
+  m_queue.swap(queue);
+  m_queueHead = 0;
+}
+
+void
+DeadNonceList::insertSlot(Entry entry)
+{
+  // keep the load factor at most 1/2, so that probe sequences stay short
+  if ((m_nSlotsUsed + 1) * 2 > m_slots.size()) {
+    this->resizeSlots(std::max(MIN_SLOTS, m_slots.size() * 2));
+  }
+
+  size_t slot = this->computeSlotIndex(entry);
+  while (m_slots[slot] != EMPTY_SLOT) {
+    slot = (slot + 1) & (m_slots.size() - 1);
+  }
+  m_slots[slot] = entry;
+  ++m_nSlotsUsed;
+}
+
+void
+DeadNonceList::eraseSlot(Entry entry)
+{
+  size_t mask = m_slots.size() - 1;
+  size_t slot = this->computeSlotIndex(entry);
+  while (m_slots[slot] != entry) {
+    BOOST_ASSERT(m_slots[slot] != EMPTY_SLOT);
+    slot = (slot + 1) & mask;
+  }
+
+  // Shift back the following entries of the probe sequence, so that no tombstone is needed:
+  // an entry can fill the hole unless its probe sequence starts after the hole.
+  for (size_t next = (slot + 1) & mask; m_slots[next] != EMPTY_SLOT; next = (next + 1) & mask) {
+    size_t start = this->computeSlotIndex(m_slots[next]);
+    if (((next - start) & mask) >= ((next - slot) & mask)) {
+      m_slots[slot] = m_slots[next];
+      slot = next;
+    }
+  }
+  m_slots[slot] = EMPTY_SLOT;
+  --m_nSlotsUsed;
+
+  if (m_slots.size() > MIN_SLOTS && m_nSlotsUsed * 8 < m_slots.size()) {
+    this->resizeSlots(m_slots.size() / 2);
+  }
+}
+
+void
+DeadNonceList::resizeSlots(size_t nSlots)
+{
+  m_slots.assign(nSlots, EMPTY_SLOT);
+  m_slots.shrink_to_fit();
+  m_nSlotsUsed = 0;
+  for (size_t i = 0; i < m_queueSize; ++i) {
+    Entry entry = m_queue[(m_queueHead + i) & (m_queue.size() - 1)];
+    if (entry != MARK) {
+      this->insertSlot(entry);
+    }
+  }
 }
 
 void
 DeadNonceList::mark()
 {
-  m_queue.push_back(MARK);
+  // capacity is adjusted before the MARK that completes a lifetime is added, as it was when
+  // adjustCapacity ran from its own timer scheduled at the same time
+  if (++m_nMarksSinceAdjust == EXPECTED_MARK_COUNT) {
+    m_nMarksSinceAdjust = 0;
+    this->adjustCapacity();
+  }
+
+  this->pushEntry(MARK);
   size_t nMarks = this->countMarks();
   m_actualMarkCounts.insert(nMarks);
 
   NFD_LOG_TRACE("mark nMarks=" << nMarks);
 
-  scheduler::schedule(m_markInterval, bind(&DeadNonceList::mark, this));
+  m_markEvent = scheduler::schedule(m_markInterval, bind(&DeadNonceList::mark, this));
 }
 
 void
@@ -150,22 +283,19 @@ DeadNonceList::adjustCapacity()
   m_actualMarkCounts.clear();
 
   this->evictEntries();
-
-  m_adjustCapacityEvent = scheduler::schedule(m_adjustCapacityInterval,
-                                              bind(&DeadNonceList::adjustCapacity, this));
 }
 
 void
 DeadNonceList::evictEntries()
 {
-  ssize_t nOverCapacity = m_queue.size() - m_capacity;
+  ssize_t nOverCapacity = m_queueSize - m_capacity;
   if (nOverCapacity <= 0) // not over capacity
     return;
 
   for (ssize_t nEvict = std::min<ssize_t>(nOverCapacity, EVICT_LIMIT); nEvict > 0; --nEvict) {
-    m_queue.erase(m_queue.begin());
+    this->popEntry();
   }
-  BOOST_ASSERT(m_queue.size() >= m_capacity);
+  BOOST_ASSERT(m_queueSize >= m_capacity);
 }
 
 } // namespace nfd
@@ -27,9 +27,6 @@
 #define NFD_DAEMON_TABLE_DEAD_NONCE_LIST_HPP
 
 #include "core/common.hpp"
-#include <boost/multi_index_container.hpp>
-#include <boost/multi_index/sequenced_index.hpp>
-#include <boost/multi_index/hashed_index.hpp>
 #include "core/scheduler.hpp"
 
 namespace nfd {
@@ -50,6 +47,13 @@ namespace nfd {
  *  At fixed intervals, the MARK, an entry with a special value, is inserted into the container.
  *  The number of MARKs stored in the container reflects the lifetime of entries,
  *  because MARKs are inserted at fixed intervals.
+ *
+ *  Entries are kept in insertion order in a circular array, and indexed by an open addressing
+ *  hashtable of the same entries.  Adding or evicting an entry allocates memory only in
+ *  amortized terms: an array is reallocated with twice its size when it becomes full (the
+ *  hashtable when it is half full), and with half its size when it is less than one quarter
+ *  full (the hashtable when it is less than one eighth full).  Other additions and evictions
+ *  do not allocate memory.
  */
 class DeadNonceList : noncopyable
 {
@@ -83,6 +87,11 @@ public:
   size_t
   size() const;
 
+  /** \return estimated number of bytes allocated for the entries and the index
+   */
+  size_t
+  getMemoryUsage() const;
+
   /** \return expected lifetime
    */
   const time::nanoseconds&
@@ -91,29 +100,58 @@ public:
 private: // Entry and Index
   typedef uint64_t Entry;
 
+  /** \return hash of name+nonce, which is never MARK or EMPTY_SLOT
+   */
   static Entry
   makeEntry(const Name& name, uint32_t nonce);
 
-  typedef boost::multi_index_container<
-    Entry,
-    boost::multi_index::indexed_by<
-      boost::multi_index::sequenced<>,
-      boost::multi_index::hashed_non_unique<
-        boost::multi_index::identity<Entry>
-      >
-    >
-  > Index;
+  /** \brief append an entry to the queue
+   */
+  void
+  pushEntry(Entry entry);
+
+  /** \brief remove the oldest entry from the queue
+   */
+  void
+  popEntry();
+
+  /** \brief reallocate the queue with the specified number of slots
+   */
+  void
+  resizeQueue(size_t nSlots);
+
+  /** \return slot in the hashtable where the probe sequence of \p entry starts
+   */
+  size_t
+  computeSlotIndex(Entry entry) const
+  {
+    return static_cast<size_t>(entry) & (m_slots.size() - 1);
+  }
+
+  void
+  insertSlot(Entry entry);
+
+  void
+  eraseSlot(Entry entry);
 
-  typedef Index::nth_index<0>::type Queue;
-  typedef Index::nth_index<1>::type Hashtable;
+  /** \brief reallocate the hashtable with the specified number of slots, and reinsert entries
+   */
+  void
+  resizeSlots(size_t nSlots);
 
 private: // actual lifetime estimation and capacity control
   /** \return number of MARKs in the index
    */
   size_t
-  countMarks() const;
+  countMarks() const
+  {
+    return m_nMarks;
+  }
 
   /** \brief add a MARK, then record number of MARKs in m_actualMarkCounts
+   *
+   *  Every EXPECTED_MARK_COUNT MARKs, i.e. once per lifetime, adjustCapacity is invoked first,
+   *  so that each Dead Nonce List needs only one timer.
    */
   void
   mark();
@@ -140,9 +178,26 @@ public:
 
 private:
   time::nanoseconds m_lifetime;
-  Index m_index;
-  Queue& m_queue;
-  Hashtable& m_ht;
+
+  /** \brief entries and MARKs in insertion order, as a circular array
+   *
+   *  The size is a power of two.  The oldest entry is at m_queueHead.
+   */
+  std::vector<Entry> m_queue;
+  size_t m_queueHead;
+  size_t m_queueSize;
+  size_t m_nMarks;
+
+  /** \brief open addressing hashtable of entries in m_queue, excluding MARKs
+   *
+   *  The size is zero before the first entry is added, otherwise a power of two
+   *  and at least twice the number of entries.
+   *  Duplicate entries occupy separate slots.
+   */
+  std::vector<Entry> m_slots;
+  size_t m_nSlotsUsed;
+
+  static const Entry EMPTY_SLOT;
 
 PUBLIC_WITH_TESTS_ELSE_PRIVATE: // actual lifetime estimation and capacity control
 
@@ -196,16 +251,16 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE: // actual lifetime estimation and capacity contr
 
   scheduler::EventId m_markEvent;
 
+  /** \brief number of MARKs added since the last adjustCapacity
+   */
+  size_t m_nMarksSinceAdjust;
+
   // ---- capacity adjustments
 
   static const double CAPACITY_UP;
 
   static const double CAPACITY_DOWN;
 
-  time::nanoseconds m_adjustCapacityInterval;
-
-  scheduler::EventId m_adjustCapacityEvent;
-
   /** \brief maximum number of entries to evict at each operation if index is over capacity
    */
   static const size_t EVICT_LIMIT;
@@ -56,35 +56,61 @@ public:
  */
 using HashFunc = std::conditional<(sizeof(HashValue) > 4), Hash64, Hash32>::type;
 
-HashValue
-computeHash(const Name& name, size_t prefixLen)
+/** \return hash values of all prefixes of \p name, computed on first use and cached in \p name
+ */
+static const std::vector<HashValue>&
+getPrefixHashes(const Name& name)
 {
+  const std::vector<HashValue>* cached = name.getPrefixHashes();
+  if (cached != nullptr) {
+    BOOST_ASSERT(cached->size() == name.size() + 1);
+    return *cached;
+  }
+
   name.wireEncode(); // ensure wire buffer exists
 
+  std::vector<HashValue> hashes;
+  hashes.reserve(name.size() + 1);
+
   HashValue h = 0;
-  for (size_t i = 0, last = std::min(prefixLen, name.size()); i < last; ++i) {
-    const name::Component& comp = name[i];
+  hashes.push_back(h);
+
+  for (const name::Component& comp : name) {
     h ^= HashFunc::compute(comp.wire(), comp.size());
+    hashes.push_back(h);
   }
-  return h;
+
+  name.setPrefixHashes(std::move(hashes));
+  return *name.getPrefixHashes();
+}
+
+HashValue
+computeHash(const Name& name, size_t prefixLen)
+{
+  return getPrefixHashes(name)[std::min(prefixLen, name.size())];
+}
+
+constexpr size_t HashSequence::INLINE_CAPACITY;
+constexpr size_t Hashtable::DELETED_SLOT;
+
+HashValue
+HashSequence::at(size_t i) const
+{
+  if (i >= m_size) {
+    BOOST_THROW_EXCEPTION(std::out_of_range("HashSequence::at"));
+  }
+  return this->data()[i];
 }
 
 HashSequence
 computeHashes(const Name& name, size_t prefixLen)
 {
-  name.wireEncode(); // ensure wire buffer exists
+  const std::vector<HashValue>& hashes = getPrefixHashes(name);
 
   size_t last = std::min(prefixLen, name.size());
   HashSequence seq;
-  seq.reserve(last + 1);
-
-  HashValue h = 0;
-  seq.push_back(h);
-
-  for (size_t i = 0; i < last; ++i) {
-    const name::Component& comp = name[i];
-    h ^= HashFunc::compute(comp.wire(), comp.size());
-    seq.push_back(h);
+  for (size_t i = 0; i <= last; ++i) {
+    seq.push_back(hashes[i]);
   }
   return seq;
 }
@@ -109,15 +135,18 @@ getNode(const Entry& entry)
   return entry.m_node;
 }
 
-HashtableOptions::HashtableOptions(size_t size)
-  : initialSize(size)
+HashtableOptions::HashtableOptions(size_t size, Layout layout)
+  : layout(layout)
+  , initialSize(size)
   , minSize(size)
 {
 }
 
-Hashtable::Hashtable(const Options& options)
-  : m_options(options)
+Hashtable::Hashtable(const Options& options, shared_ptr<MemoryPool> pool)
+  : m_pool(std::move(pool))
+  , m_options(options)
   , m_size(0)
+  , m_nDeletedSlots(0)
 {
   BOOST_ASSERT(m_options.minSize > 0);
   BOOST_ASSERT(m_options.initialSize >= m_options.minSize);
@@ -129,18 +158,65 @@ Hashtable::Hashtable(const Options& options)
   BOOST_ASSERT(m_options.shrinkFactor > 0.0);
   BOOST_ASSERT(m_options.shrinkFactor < 1.0);
 
-  m_buckets.resize(options.initialSize);
+  if (m_options.layout == HashtableOptions::CHAINED) {
+    m_buckets.resize(options.initialSize);
+  }
+  else {
+    // at least one slot must stay free for a probe sequence to terminate
+    BOOST_ASSERT(m_options.expandLoadFactor < 1.0);
+    m_slots.resize(options.initialSize, Slot{0, 0, nullptr});
+  }
   this->computeThresholds();
 }
 
 Hashtable::~Hashtable()
 {
   for (size_t i = 0; i < m_buckets.size(); ++i) {
-    foreachNode(m_buckets[i], [] (Node* node) {
+    foreachNode(m_buckets[i], [this] (Node* node) {
       node->prev = node->next = nullptr;
-      delete node;
+      this->deleteNode(node);
     });
   }
+  for (const Slot& slot : m_slots) {
+    if (slot.node != nullptr) {
+      this->deleteNode(slot.node);
+    }
+  }
+}
+
+Node*
+Hashtable::newNode(HashValue h, const Name& name)
+{
+  void* p = m_pool->allocate(sizeof(Node));
+  try {
+    return new (p) Node(h, name);
+  }
+  catch (...) {
+    m_pool->deallocate(p, sizeof(Node));
+    throw;
+  }
+}
+
+void
+Hashtable::deleteNode(Node* node)
+{
+  node->~Node();
+  m_pool->deallocate(node, sizeof(Node));
+}
+
+size_t
+Hashtable::findBucket(const Node* node) const
+{
+  size_t bucket = this->computeBucketIndex(node->hash);
+  if (m_options.layout == HashtableOptions::CHAINED) {
+    return bucket;
+  }
+
+  while (m_slots[bucket].node != node) {
+    BOOST_ASSERT(m_slots[bucket].node != nullptr || m_slots[bucket].prefixLen == DELETED_SLOT);
+    bucket = bucket + 1 == m_slots.size() ? 0 : bucket + 1;
+  }
+  return bucket;
 }
 
 void
@@ -177,9 +253,88 @@ Hashtable::detach(size_t bucket, Node* node)
   node->prev = node->next = nullptr;
 }
 
+void
+Hashtable::attachSlot(Node* node, size_t prefixLen)
+{
+  size_t slot = this->computeBucketIndex(node->hash);
+  while (m_slots[slot].node != nullptr) {
+    slot = slot + 1 == m_slots.size() ? 0 : slot + 1;
+  }
+  m_slots[slot] = Slot{node->hash, prefixLen, node};
+}
+
+void
+Hashtable::detachSlot(size_t slot)
+{
+  // The slot cannot become free if it is part of the probe sequence of a following node.
+  // Leave a marker instead of moving the following nodes, so that erasing a node does not
+  // affect an ongoing enumeration.
+  size_t next = slot + 1 == m_slots.size() ? 0 : slot + 1;
+  if (m_slots[next].node == nullptr && m_slots[next].prefixLen != DELETED_SLOT) {
+    m_slots[slot] = Slot{0, 0, nullptr};
+  }
+  else {
+    m_slots[slot] = Slot{0, DELETED_SLOT, nullptr};
+    ++m_nDeletedSlots;
+  }
+}
+
+std::pair<const Node*, bool>
+Hashtable::findOrInsertSlot(const Name& name, size_t prefixLen, HashValue h, bool allowInsert)
+{
+  size_t n = m_slots.size();
+  size_t slot = this->computeBucketIndex(h);
+  size_t deletedSlot = n;
+
+  for (;; slot = slot + 1 == n ? 0 : slot + 1) {
+    const Slot& s = m_slots[slot];
+    if (s.node == nullptr) {
+      if (s.prefixLen != DELETED_SLOT) {
+        break;
+      }
+      if (deletedSlot == n) {
+        deletedSlot = slot;
+      }
+    }
+    else if (s.hash == h && s.prefixLen == prefixLen &&
+             name.compare(0, prefixLen, s.node->entry.getName()) == 0) {
+      NFD_LOG_TRACE("found " << name.getPrefix(prefixLen) << " hash=" << h << " slot=" << slot);
+      return {s.node, false};
+    }
+  }
+
+  if (!allowInsert) {
+    NFD_LOG_TRACE("not-found " << name.getPrefix(prefixLen) << " hash=" << h << " slot=" << slot);
+    return {nullptr, false};
+  }
+
+  if (deletedSlot != n) {
+    slot = deletedSlot;
+    --m_nDeletedSlots;
+  }
+  Node* node = this->newNode(h, name.getPrefix(prefixLen));
+  m_slots[slot] = Slot{h, prefixLen, node};
+  NFD_LOG_TRACE("insert " << node->entry.getName() << " hash=" << h << " slot=" << slot);
+  ++m_size;
+
+  if (m_size > m_expandThreshold) {
+    this->resize(static_cast<size_t>(m_options.expandFactor * this->getNBuckets()));
+  }
+  else if (m_size + m_nDeletedSlots > m_expandThreshold) {
+    // too few free slots left: rebuild in place to drop the deleted slots
+    this->resize(this->getNBuckets());
+  }
+
+  return {node, true};
+}
+
 std::pair<const Node*, bool>
 Hashtable::findOrInsert(const Name& name, size_t prefixLen, HashValue h, bool allowInsert)
 {
+  if (m_options.layout == HashtableOptions::OPEN_ADDRESSING) {
+    return this->findOrInsertSlot(name, prefixLen, h, allowInsert);
+  }
+
   size_t bucket = this->computeBucketIndex(h);
 
   for (const Node* node = m_buckets[bucket]; node != nullptr; node = node->next) {
@@ -194,7 +349,7 @@ Hashtable::findOrInsert(const Name& name, size_t prefixLen, HashValue h, bool al
     return {nullptr, false};
   }
 
-  Node* node = new Node(h, name.getPrefix(prefixLen));
+  Node* node = this->newNode(h, name.getPrefix(prefixLen));
   this->attach(bucket, node);
   NFD_LOG_TRACE("insert " << node->entry.getName() << " hash=" << h << " bucket=" << bucket);
   ++m_size;
@@ -233,17 +388,24 @@ Hashtable::erase(Node* node)
   BOOST_ASSERT(node != nullptr);
   BOOST_ASSERT(node->entry.getParent() == nullptr);
 
-  size_t bucket = this->computeBucketIndex(node->hash);
+  size_t bucket = this->findBucket(node);
   NFD_LOG_TRACE("erase " << node->entry.getName() << " hash=" << node->hash << " bucket=" << bucket);
 
-  this->detach(bucket, node);
-  delete node;
+  if (m_options.layout == HashtableOptions::CHAINED) {
+    this->detach(bucket, node);
+  }
+  else {
+    this->detachSlot(bucket);
+  }
+  this->deleteNode(node);
   --m_size;
 
   if (m_size < m_shrinkThreshold) {
     size_t newNBuckets = std::max(m_options.minSize,
       static_cast<size_t>(m_options.shrinkFactor * this->getNBuckets()));
-    this->resize(newNBuckets);
+    if (newNBuckets != this->getNBuckets()) {
+      this->resize(newNBuckets);
+    }
   }
 }
 
@@ -258,11 +420,28 @@ Hashtable::computeThresholds()
 void
 Hashtable::resize(size_t newNBuckets)
 {
-  if (this->getNBuckets() == newNBuckets) {
+  if (this->getNBuckets() == newNBuckets && m_nDeletedSlots == 0) {
     return;
   }
   NFD_LOG_DEBUG("resize from=" << this->getNBuckets() << " to=" << newNBuckets);
 
+  if (m_options.layout == HashtableOptions::OPEN_ADDRESSING) {
+    // every node needs a slot, and one slot must stay free
+    newNBuckets = std::max(newNBuckets, m_size + 1);
+
+    std::vector<Slot> oldSlots(newNBuckets, Slot{0, 0, nullptr});
+    oldSlots.swap(m_slots);
+    m_nDeletedSlots = 0;
+    for (const Slot& slot : oldSlots) {
+      if (slot.node != nullptr) {
+        this->attachSlot(slot.node, slot.prefixLen);
+      }
+    }
+
+    this->computeThresholds();
+    return;
+  }
+
   std::vector<Node*> oldBuckets;
   oldBuckets.swap(m_buckets);
   m_buckets.resize(newNBuckets);
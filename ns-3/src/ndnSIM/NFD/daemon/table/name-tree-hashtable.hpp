@@ -27,6 +27,7 @@
 #define NFD_DAEMON_TABLE_NAME_TREE_HASHTABLE_HPP
 
 #include "name-tree-entry.hpp"
+#include "core/memory-pool.hpp"
 
 namespace nfd {
 namespace name_tree {
@@ -38,25 +39,87 @@ class Entry;
 using HashValue = size_t;
 
 /** \brief a sequence of hash values
+ *
+ *  Up to INLINE_CAPACITY hash values are stored in the object itself, so that the hash sequence
+ *  of a name that is not longer than NameTree::getMaxDepth() does not need an allocation.
  *  \sa computeHashes
  */
-using HashSequence = std::vector<HashValue>;
+class HashSequence
+{
+public:
+  static constexpr size_t INLINE_CAPACITY = 33;
+
+  HashSequence()
+    : m_size(0)
+  {
+  }
+
+  size_t
+  size() const
+  {
+    return m_size;
+  }
+
+  const HashValue*
+  data() const
+  {
+    return m_size <= INLINE_CAPACITY ? m_inline : m_overflow.data();
+  }
+
+  HashValue
+  operator[](size_t i) const
+  {
+    BOOST_ASSERT(i < m_size);
+    return this->data()[i];
+  }
+
+  /** \throw std::out_of_range i >= size()
+   */
+  HashValue
+  at(size_t i) const;
+
+  void
+  push_back(HashValue h)
+  {
+    if (m_size < INLINE_CAPACITY) {
+      m_inline[m_size] = h;
+    }
+    else {
+      if (m_size == INLINE_CAPACITY) {
+        m_overflow.assign(m_inline, m_inline + INLINE_CAPACITY);
+      }
+      m_overflow.push_back(h);
+    }
+    ++m_size;
+  }
+
+private:
+  size_t m_size;
+  HashValue m_inline[INLINE_CAPACITY];
+  std::vector<HashValue> m_overflow;
+};
 
 /** \brief computes hash value of \p name.getPrefix(prefixLen)
+ *
+ *  The hash values of all prefixes of \p name are computed at the first call and cached in
+ *  \p name (see ndn::Name::getPrefixHashes), so that the components of a packet name are hashed
+ *  only once, even if the name is looked up in several tables.
  */
 HashValue
 computeHash(const Name& name, size_t prefixLen = std::numeric_limits<size_t>::max());
 
 /** \brief computes hash values for each prefix of \p name.getPrefix(prefixLen)
  *  \return a hash sequence, where the i-th hash value equals computeHash(name, i)
+ *  \note the hash values are cached in \p name, as in computeHash
  */
 HashSequence
 computeHashes(const Name& name, size_t prefixLen = std::numeric_limits<size_t>::max());
 
 /** \brief a hashtable node
  *
- *  Zero or more nodes can be added to a hashtable bucket. They are organized as
- *  a doubly linked list through prev and next pointers.
+ *  In a HashtableOptions::CHAINED hashtable, zero or more nodes can be added to a bucket.
+ *  They are organized as a doubly linked list through prev and next pointers.
+ *  In a HashtableOptions::OPEN_ADDRESSING hashtable, prev and next are always nullptr.
  */
 class Node : noncopyable
 {
@@ -106,14 +169,35 @@ foreachNode(N* head, const F& func)
 class HashtableOptions
 {
 public:
+  /** \brief how hash collisions are resolved
+   */
+  enum Layout {
+    /** \brief each bucket is a doubly linked list of nodes
+     */
+    CHAINED,
+    /** \brief each bucket is a slot holding at most one node together with its hash value and
+     *         prefix length; collisions are resolved by linear probing into the next slots
+     *
+     *  Slots are stored contiguously, so that a lookup usually reads a single cache line and
+     *  only dereferences the nodes whose hash value and prefix length match.
+     *  Erasing a node marks its slot as deleted rather than moving other nodes, so that
+     *  enumeration survives erasure as with CHAINED. expandLoadFactor must be less than 1.
+     */
+    OPEN_ADDRESSING
+  };
+
   /** \brief constructor
    *  \post initialSize == size
    *  \post minSize == size
    */
   explicit
-  HashtableOptions(size_t size = 16);
+  HashtableOptions(size_t size = 16, Layout layout = CHAINED);
 
 public:
+  /** \brief how hash collisions are resolved
+   */
+  Layout layout;
+
   /** \brief initial number of buckets
    */
   size_t initialSize;
@@ -143,7 +227,8 @@ public:
  *
  *  The Hashtable contains a number of buckets.
  *  Each node is placed into a bucket determined by a hash value computed from its name.
- *  Hash collision is resolved through a doubly linked list in each bucket.
+ *  Hash collision is resolved through a doubly linked list in each bucket, or by open
+ *  addressing, as selected by HashtableOptions::layout.
  *  The number of buckets is adjusted according to how many nodes are stored.
  */
 class Hashtable
@@ -151,8 +236,11 @@ class Hashtable
 public:
   typedef HashtableOptions Options;
 
+  /** \param options hashtable options
+   *  \param pool memory pool for nodes
+   */
   explicit
-  Hashtable(const Options& options);
+  Hashtable(const Options& options, shared_ptr<MemoryPool> pool = make_shared<MemoryPool>());
 
   /** \brief deallocates all nodes
    */
@@ -171,7 +259,7 @@ public:
   size_t
   getNBuckets() const
   {
-    return m_buckets.size();
+    return m_options.layout == HashtableOptions::CHAINED ? m_buckets.size() : m_slots.size();
   }
 
   /** \return bucket index for hash value h
@@ -189,9 +277,16 @@ public:
   getBucket(size_t bucket) const
   {
     BOOST_ASSERT(bucket < this->getNBuckets());
-    return m_buckets[bucket]; // don't use m_bucket.at() for better performance
+    // don't use m_bucket.at() for better performance
+    return m_options.layout == HashtableOptions::CHAINED ? m_buckets[bucket] : m_slots[bucket].node;
   }
 
+  /** \return index of the bucket that contains node
+   *  \pre node exists in this hashtable
+   */
+  size_t
+  findBucket(const Node* node) const;
+
   /** \brief find node for name.getPrefix(prefixLen)
    *  \pre name.size() > prefixLen
    */
@@ -232,6 +327,27 @@ private:
   std::pair<const Node*, bool>
   findOrInsert(const Name& name, size_t prefixLen, HashValue h, bool allowInsert);
 
+  /** \brief find or insert node in open addressing layout
+   */
+  std::pair<const Node*, bool>
+  findOrInsertSlot(const Name& name, size_t prefixLen, HashValue h, bool allowInsert);
+
+  /** \brief put node into the first free slot starting from its bucket
+   */
+  void
+  attachSlot(Node* node, size_t prefixLen);
+
+  /** \brief empty the slot at index \p slot
+   */
+  void
+  detachSlot(size_t slot);
+
+  Node*
+  newNode(HashValue h, const Name& name);
+
+  void
+  deleteNode(Node* node);
+
   void
   computeThresholds();
 
@@ -239,9 +355,23 @@ private:
   resize(size_t newNBuckets);
 
 private:
-  std::vector<Node*> m_buckets;
+  /** \brief a bucket of the open addressing layout
+   */
+  struct Slot
+  {
+    HashValue hash;
+    size_t prefixLen; ///< DELETED_SLOT if node was erased from a probe sequence
+    Node* node; ///< nullptr if slot is free or deleted
+  };
+
+  static constexpr size_t DELETED_SLOT = std::numeric_limits<size_t>::max();
+
+  std::vector<Node*> m_buckets; ///< buckets of the chained layout
+  std::vector<Slot> m_slots; ///< buckets of the open addressing layout
+  shared_ptr<MemoryPool> m_pool;
   Options m_options;
   size_t m_size;
+  size_t m_nDeletedSlots; ///< number of deleted slots in the open addressing layout
   size_t m_expandThreshold;
   size_t m_shrinkThreshold;
 };
@@ -36,7 +36,14 @@ namespace name_tree {
 NFD_LOG_INIT("NameTree");
 
 NameTree::NameTree(size_t nBuckets)
-  : m_ht(HashtableOptions(nBuckets))
+  : m_pool(make_shared<MemoryPool>())
+  , m_ht(HashtableOptions(nBuckets), m_pool)
+{
+}
+
+NameTree::NameTree(const HashtableOptions& options, shared_ptr<MemoryPool> pool)
+  : m_pool(std::move(pool))
+  , m_ht(options, m_pool)
 {
 }
 
@@ -39,6 +39,12 @@ public:
   explicit
   NameTree(size_t nBuckets = 1024);
 
+  /** \brief construct a NameTree whose hashtable uses \p options
+   *  \param pool memory pool for name tree nodes, also used by tables attached to this NameTree
+   */
+  explicit
+  NameTree(const HashtableOptions& options, shared_ptr<MemoryPool> pool = make_shared<MemoryPool>());
+
 public: // information
   /** \brief Maximum depth of the name tree.
    *
@@ -72,6 +78,14 @@ public: // information
     return m_ht.getNBuckets();
   }
 
+  /** \return memory pool for name tree nodes and entries of attached tables
+   */
+  const shared_ptr<MemoryPool>&
+  getMemoryPool() const
+  {
+    return m_pool;
+  }
+
   /** \return name tree entry on which a table entry is attached,
    *          or nullptr if the table entry is detached
    */
@@ -266,6 +280,7 @@ public: // enumeration
   }
 
 private:
+  shared_ptr<MemoryPool> m_pool;
   Hashtable m_ht;
 
   friend class EnumerationImpl;
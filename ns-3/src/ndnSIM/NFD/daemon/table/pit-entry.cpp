@@ -29,8 +29,11 @@
 namespace nfd {
 namespace pit {
 
-Entry::Entry(const Interest& interest)
+Entry::Entry(const Interest& interest, shared_ptr<MemoryPool> pool)
   : m_interest(interest.shared_from_this())
+  , m_recordArena(std::move(pool))
+  , m_inRecords(InRecordCollection::allocator_type(m_recordArena))
+  , m_outRecords(OutRecordCollection::allocator_type(m_recordArena))
   , m_nameTreeEntry(nullptr)
   , m_hit(0)
 {
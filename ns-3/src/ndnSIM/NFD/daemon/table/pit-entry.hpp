@@ -28,6 +28,7 @@
 
 #include "pit-in-record.hpp"
 #include "pit-out-record.hpp"
+#include "core/memory-pool.hpp"
 #include "core/scheduler.hpp"
 
 namespace nfd {
@@ -38,13 +39,21 @@ class Entry;
 
 namespace pit {
 
+/** \brief storage of the in-records and out-records of one PIT entry
+ *
+ *  The common case of up to two in-records and two out-records is stored within the entry;
+ *  further records are allocated from the MemoryPool of the PIT.
+ */
+typedef InlineArena<4, (sizeof(InRecord) > sizeof(OutRecord) ? sizeof(InRecord) : sizeof(OutRecord)) +
+                       2 * sizeof(void*)> RecordArena;
+
 /** \brief an unordered collection of in-records
  */
-typedef std::list<InRecord> InRecordCollection;
+typedef std::list<InRecord, ArenaAllocator<InRecord, RecordArena>> InRecordCollection;
 
 /** \brief an unordered collection of out-records
  */
-typedef std::list<OutRecord> OutRecordCollection;
+typedef std::list<OutRecord, ArenaAllocator<OutRecord, RecordArena>> OutRecordCollection;
 
 /** \brief an Interest table entry
  *
@@ -57,8 +66,11 @@ typedef std::list<OutRecord> OutRecordCollection;
 class Entry : public StrategyInfoHost, noncopyable
 {
 public:
+  /** \param interest the representative Interest
+   *  \param pool memory pool for in-records and out-records that do not fit into the entry
+   */
   explicit
-  Entry(const Interest& interest);
+  Entry(const Interest& interest, shared_ptr<MemoryPool> pool = MemoryPool::getDefault());
 
   /** \return the representative Interest of the PIT entry
    *  \note Every Interest in in-records and out-records should have same Name and Selectors
@@ -249,6 +261,7 @@ public:
 
 private:
   shared_ptr<const Interest> m_interest;
+  RecordArena m_recordArena; ///< must outlive m_inRecords and m_outRecords
   InRecordCollection m_inRecords;
   OutRecordCollection m_outRecords;
 
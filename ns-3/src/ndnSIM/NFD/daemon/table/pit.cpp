@@ -78,7 +78,8 @@ Pit::findOrInsert(const Interest& interest, bool allowInsert)
     return {nullptr, true};
   }
 
-  auto entry = make_shared<Entry>(interest);
+  const shared_ptr<MemoryPool>& pool = m_nameTree.getMemoryPool();
+  auto entry = std::allocate_shared<Entry>(PoolAllocator<Entry>(pool), interest, pool);
   nte->insertPitEntry(entry);
   ++m_nItems;
   return {entry, true};
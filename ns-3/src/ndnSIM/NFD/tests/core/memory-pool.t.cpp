@@ -0,0 +1,148 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2016,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "core/memory-pool.hpp"
+
+#include "tests/test-common.hpp"
+
+namespace nfd {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(TestMemoryPool)
+
+BOOST_AUTO_TEST_CASE(ReuseBlocks)
+{
+  MemoryPool pool(256, 4096);
+  BOOST_CHECK_EQUAL(pool.getMaxBlockSize(), 256);
+
+  void* p1 = pool.allocate(40);
+  void* p2 = pool.allocate(40);
+  BOOST_CHECK(p1 != p2);
+  BOOST_CHECK_EQUAL(pool.getStats().nAllocations, 2);
+  BOOST_CHECK_EQUAL(pool.getStats().nSystemAllocations, 1);
+  BOOST_CHECK_EQUAL(pool.getStats().nBytesInUse, 2 * 48);
+  BOOST_CHECK_EQUAL(pool.getStats().nBytesReserved, MemoryPool::MIN_CHUNK_SIZE / 48 * 48);
+
+  pool.deallocate(p1, 40);
+  BOOST_CHECK_EQUAL(pool.allocate(33), p1); // same size class
+  BOOST_CHECK_EQUAL(pool.getStats().nSystemAllocations, 1);
+
+  void* p3 = pool.allocate(100); // another size class needs another chunk
+  BOOST_CHECK_EQUAL(pool.getStats().nSystemAllocations, 2);
+
+  pool.deallocate(p1, 33);
+  pool.deallocate(p2, 40);
+  pool.deallocate(p3, 100);
+  BOOST_CHECK_EQUAL(pool.getStats().nDeallocations, 4);
+  BOOST_CHECK_EQUAL(pool.getStats().nBytesInUse, 0);
+}
+
+BOOST_AUTO_TEST_CASE(ChunkGrowth)
+{
+  MemoryPool pool(256, 4096);
+  std::vector<void*> blocks;
+  std::vector<size_t> reserved;
+  for (size_t i = 0; i < 4096 / 64 * 3; ++i) {
+    uint64_t nSystemAllocations = pool.getStats().nSystemAllocations;
+    blocks.push_back(pool.allocate(64));
+    if (pool.getStats().nSystemAllocations > nSystemAllocations) {
+      reserved.push_back(pool.getStats().nBytesReserved);
+    }
+  }
+
+  // chunks of 1024, 2048, 4096, then 4096 bytes
+  BOOST_REQUIRE_EQUAL(reserved.size(), 5);
+  BOOST_CHECK_EQUAL(reserved[0], 1024);
+  BOOST_CHECK_EQUAL(reserved[1], 1024 + 2048);
+  BOOST_CHECK_EQUAL(reserved[2], 1024 + 2048 + 4096);
+  BOOST_CHECK_EQUAL(reserved[3], 1024 + 2048 + 4096 * 2);
+  BOOST_CHECK_EQUAL(reserved[4], 1024 + 2048 + 4096 * 3);
+
+  for (void* p : blocks) {
+    pool.deallocate(p, 64);
+  }
+  BOOST_CHECK_EQUAL(pool.getStats().nBytesInUse, 0);
+}
+
+BOOST_AUTO_TEST_CASE(PassThrough)
+{
+  MemoryPool pool(64);
+
+  void* p = pool.allocate(65);
+  BOOST_CHECK_EQUAL(pool.getStats().nSystemAllocations, 1);
+  BOOST_CHECK_EQUAL(pool.getStats().nBytesInUse, 0);
+  BOOST_CHECK_EQUAL(pool.getStats().nBytesReserved, 0);
+  pool.deallocate(p, 65);
+
+  MemoryPool disabled(0);
+  p = disabled.allocate(8);
+  BOOST_CHECK_EQUAL(disabled.getStats().nSystemAllocations, 1);
+  disabled.deallocate(p, 8);
+
+  InlineArena<2, 64> arena(make_shared<MemoryPool>(0));
+  p = arena.allocate(8);
+  BOOST_CHECK_EQUAL(arena.getNInlineBlocks(), 0);
+  arena.deallocate(p, 8);
+}
+
+BOOST_AUTO_TEST_CASE(Allocators)
+{
+  auto pool = make_shared<MemoryPool>();
+  {
+    auto ptr = std::allocate_shared<int>(PoolAllocator<int>(pool), 7);
+    BOOST_CHECK_EQUAL(*ptr, 7);
+    BOOST_CHECK_EQUAL(pool->getStats().nAllocations, 1);
+    BOOST_CHECK_EQUAL(pool.use_count(), 2);
+  }
+  BOOST_CHECK_EQUAL(pool->getStats().nBytesInUse, 0);
+  BOOST_CHECK_EQUAL(pool.use_count(), 1);
+
+  InlineArena<2, 64> arena(pool);
+  std::list<int, ArenaAllocator<int, InlineArena<2, 64>>> list(
+    ArenaAllocator<int, InlineArena<2, 64>>{arena});
+  list.push_back(1);
+  list.push_back(2);
+  BOOST_CHECK_EQUAL(arena.getNInlineBlocks(), 2);
+  BOOST_CHECK_EQUAL(pool->getStats().nAllocations, 1);
+
+  list.push_back(3);
+  BOOST_CHECK_EQUAL(arena.getNInlineBlocks(), 2);
+  BOOST_CHECK_EQUAL(pool->getStats().nAllocations, 2);
+
+  list.pop_front();
+  BOOST_CHECK_EQUAL(arena.getNInlineBlocks(), 1);
+  list.push_back(4);
+  BOOST_CHECK_EQUAL(arena.getNInlineBlocks(), 2);
+  BOOST_CHECK_EQUAL(pool->getStats().nAllocations, 2);
+
+  list.clear();
+  BOOST_CHECK_EQUAL(arena.getNInlineBlocks(), 0);
+  BOOST_CHECK_EQUAL(pool->getStats().nBytesInUse, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestMemoryPool
+
+} // namespace tests
+} // namespace nfd
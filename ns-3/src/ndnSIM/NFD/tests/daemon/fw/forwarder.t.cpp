@@ -96,6 +96,7 @@ BOOST_AUTO_TEST_CASE(CsMatched)
   interestA->setInterestLifetime(time::seconds(4));
   shared_ptr<Data> dataA = makeData("/A");
   dataA->setTag(make_shared<lp::IncomingFaceIdTag>(face3->getId()));
+  dataA->setTag(make_shared<lp::HopCountTag>(3));
 
   Fib& fib = forwarder.getFib();
   fib.insert("/A").first->addNextHop(*face2, 0);
@@ -119,6 +120,8 @@ BOOST_AUTO_TEST_CASE(CsMatched)
   // IncomingFaceId field should be reset to represent CS
   BOOST_REQUIRE(face1->sentData[0].getTag<lp::IncomingFaceIdTag>() != nullptr);
   BOOST_CHECK_EQUAL(*face1->sentData[0].getTag<lp::IncomingFaceIdTag>(), face::FACEID_CONTENT_STORE);
+  // HopCount of the Data that was cached should not be sent
+  BOOST_CHECK(face1->sentData[0].getTag<lp::HopCountTag>() == nullptr);
 
   this->advanceClocks(time::milliseconds(100), time::milliseconds(500));
   // PIT entry should not be left behind
@@ -339,6 +342,11 @@ BOOST_AUTO_TEST_CASE(IncomingData)
   BOOST_CHECK_EQUAL(face2->sentData.size(), 1);
   BOOST_CHECK_EQUAL(face3->sentData.size(), 0);
   BOOST_CHECK_EQUAL(face4->sentData.size(), 1);
+
+  // CS holds the received Data, not a copy
+  Cs& cs = forwarder.getCs();
+  BOOST_REQUIRE_EQUAL(cs.size(), 1);
+  BOOST_CHECK_EQUAL(&cs.begin()->getData(), dataD.get());
 }
 
 BOOST_AUTO_TEST_CASE(IncomingNack)
@@ -100,6 +100,20 @@ BOOST_AUTO_TEST_CASE(FaceTableAccess)
   BOOST_CHECK((strategy.removedFaces == std::vector<FaceId>{id2, id1}));
 }
 
+BOOST_AUTO_TEST_CASE(SharedInstanceName)
+{
+  Forwarder forwarder1;
+  Forwarder forwarder2;
+  DummyStrategy strategy1(forwarder1);
+  DummyStrategy strategy2(forwarder2);
+  DummyStrategy strategy3(forwarder2, Name(DummyStrategy::getStrategyName()).append("param"));
+
+  BOOST_CHECK_EQUAL(strategy1.getInstanceName(), DummyStrategy::getStrategyName());
+  BOOST_CHECK_EQUAL(&strategy1.getInstanceName(), &strategy2.getInstanceName());
+  BOOST_CHECK_EQUAL(strategy3.getInstanceName(), Name(DummyStrategy::getStrategyName()).append("param"));
+  BOOST_CHECK_NE(&strategy1.getInstanceName(), &strategy3.getInstanceName());
+}
+
 // LookupFib is tested in Fw/TestLinkForwarding test suite.
 
 BOOST_AUTO_TEST_SUITE_END() // TestStrategy
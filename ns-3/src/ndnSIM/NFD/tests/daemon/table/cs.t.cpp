@@ -136,6 +136,65 @@ BOOST_AUTO_TEST_CASE(FullName)
   CHECK_CS_FIND(2);
 }
 
+BOOST_AUTO_TEST_CASE(ExactNameAmongChildren)
+{
+  insert(1, "/A/B");
+  Name n2 = insert(2, "/A", [] (Data& data) { data.setFreshnessPeriod(time::seconds(1)); });
+  Name n3 = insert(3, "/A", [] (Data& data) { data.setFreshnessPeriod(time::seconds(3600)); });
+  insert(4, "/A/C");
+  uint32_t expectedLeftmost = n2 < n3 ? 2 : 3;
+
+  startInterest("/A");
+  CHECK_CS_FIND(expectedLeftmost);
+
+  this->advanceClocks(time::seconds(2));
+  startInterest("/A")
+    .setMustBeFresh(true);
+  CHECK_CS_FIND(3);
+
+  startInterest("/A")
+    .setMinSuffixComponents(2);
+  CHECK_CS_FIND(1);
+
+  startInterest("/A/C");
+  CHECK_CS_FIND(4);
+
+  startInterest("/A/D");
+  CHECK_CS_FIND(0);
+}
+
+BOOST_AUTO_TEST_CASE(ExactNameAfterEviction)
+{
+  m_cs.setLimit(3);
+  insert(1, "/A");
+  insert(2, "/A");
+  insert(3, "/A/B");
+
+  insert(4, "/C"); // evicts the first inserted entry
+  startInterest("/A");
+  CHECK_CS_FIND(2);
+
+  insert(5, "/D"); // evicts the other entry with exact Name
+  startInterest("/A");
+  CHECK_CS_FIND(3);
+  BOOST_CHECK_EQUAL(m_cs.size(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(SimulatedDigest)
+{
+  Data::setSimulatedDigest(true);
+  Name n1 = insert(1, "/A");
+  Name n2 = insert(2, "/A");
+  Data::setSimulatedDigest(false);
+  BOOST_CHECK_NE(n1, n2);
+
+  startInterest(n1);
+  CHECK_CS_FIND(1);
+
+  startInterest(n2);
+  CHECK_CS_FIND(2);
+}
+
 BOOST_AUTO_TEST_CASE(Leftmost)
 {
   insert(1, "/A");
@@ -425,6 +484,27 @@ BOOST_FIXTURE_TEST_CASE(CachePolicyNoCache, FindFixture)
   CHECK_CS_FIND(0);
 }
 
+BOOST_AUTO_TEST_CASE(InsertSameName)
+{
+  Cs cs;
+
+  shared_ptr<Data> data1 = makeData("/A");
+  cs.insert(*data1);
+  BOOST_CHECK_EQUAL(cs.size(), 1);
+
+  // a copy of the same packet is the same entry
+  auto data1Copy = make_shared<Data>(Block(data1->wireEncode().wire(), data1->wireEncode().size()));
+  cs.insert(*data1Copy);
+  BOOST_CHECK_EQUAL(cs.size(), 1);
+
+  // a different packet with the same Name is another entry
+  shared_ptr<Data> data2 = makeData("/A");
+  data2->setContent(data1->wireEncode().wire(), 1);
+  data2->wireEncode();
+  cs.insert(*data2);
+  BOOST_CHECK_EQUAL(cs.size(), 2);
+}
+
 BOOST_AUTO_TEST_CASE(Enumeration)
 {
   Cs cs;
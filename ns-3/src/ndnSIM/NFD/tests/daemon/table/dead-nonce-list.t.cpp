@@ -43,9 +43,11 @@ BOOST_AUTO_TEST_CASE(Basic)
   DeadNonceList dnl;
   BOOST_CHECK_EQUAL(dnl.size(), 0);
   BOOST_CHECK_EQUAL(dnl.has(nameA, nonce1), false);
+  size_t emptyMemoryUsage = dnl.getMemoryUsage();
 
   dnl.add(nameA, nonce1);
   BOOST_CHECK_EQUAL(dnl.size(), 1);
+  BOOST_CHECK_GT(dnl.getMemoryUsage(), emptyMemoryUsage);
   BOOST_CHECK_EQUAL(dnl.has(nameA, nonce1), true);
   BOOST_CHECK_EQUAL(dnl.has(nameA, nonce2), false);
   BOOST_CHECK_EQUAL(dnl.has(nameB, nonce1), false);
@@ -56,6 +58,46 @@ BOOST_AUTO_TEST_CASE(MinLifetime)
   BOOST_CHECK_THROW(DeadNonceList dnl(time::milliseconds::zero()), std::invalid_argument);
 }
 
+BOOST_AUTO_TEST_CASE(Eviction)
+{
+  Name name("ndn:/E");
+  const uint32_t nNonces = 1000;
+
+  DeadNonceList dnl;
+  dnl.add(name, 0);
+  dnl.add(name, 0); // duplicate entry
+  BOOST_CHECK_EQUAL(dnl.size(), 2);
+  BOOST_CHECK_EQUAL(dnl.has(name, 0), true);
+
+  // the index is resized many times while the oldest entries are evicted
+  for (uint32_t nonce = 1; nonce <= nNonces; ++nonce) {
+    dnl.add(name, nonce);
+  }
+  BOOST_CHECK_EQUAL(dnl.size(), dnl.m_capacity);
+
+  size_t nPresent = 0;
+  for (uint32_t nonce = 0; nonce <= nNonces; ++nonce) {
+    bool isRecent = nonce > nNonces - dnl.m_capacity;
+    BOOST_CHECK_EQUAL(dnl.has(name, nonce), isRecent);
+    nPresent += isRecent;
+  }
+  BOOST_CHECK_EQUAL(nPresent, dnl.m_capacity);
+}
+
+BOOST_FIXTURE_TEST_CASE(AdjustBeforeMark, UnitTestTimeFixture)
+{
+  const time::nanoseconds lifetime = time::milliseconds(200);
+  const time::nanoseconds markInterval = lifetime / DeadNonceList::EXPECTED_MARK_COUNT;
+  DeadNonceList dnl(lifetime);
+
+  this->advanceClocks(markInterval, markInterval * (DeadNonceList::EXPECTED_MARK_COUNT - 1));
+  BOOST_CHECK_EQUAL(dnl.m_actualMarkCounts.size(), DeadNonceList::EXPECTED_MARK_COUNT - 1);
+
+  // capacity is adjusted with the counts of previous MARKs, then the next MARK is counted
+  this->advanceClocks(markInterval);
+  BOOST_CHECK_EQUAL(dnl.m_actualMarkCounts.size(), 1);
+}
+
 /// A Fixture that periodically inserts Nonces
 class PeriodicalInsertionFixture : public UnitTestTimeFixture
 {
@@ -50,6 +50,15 @@ BOOST_AUTO_TEST_CASE(ComputeHash)
 
   hashes = computeHashes(prefix, 2);
   BOOST_CHECK_EQUAL(hashes.size(), 3);
+
+  // hash values are cached in the name, and dropped when it is modified
+  BOOST_REQUIRE(prefix.getPrefixHashes() != nullptr);
+  BOOST_CHECK_EQUAL(prefix.getPrefixHashes()->size(), prefix.size() + 1);
+  BOOST_CHECK_EQUAL(prefix.getPrefixHashes()->at(2), hashes[2]);
+  prefix.append("again");
+  BOOST_CHECK(prefix.getPrefixHashes() == nullptr);
+  BOOST_CHECK_EQUAL(computeHash(prefix, 2), hashes[2]);
+  BOOST_CHECK_EQUAL(computeHashes(prefix).size(), prefix.size() + 1);
 }
 
 BOOST_AUTO_TEST_SUITE(Hashtable)
@@ -182,6 +191,67 @@ BOOST_AUTO_TEST_CASE(Resize)
   BOOST_CHECK_EQUAL(ht.getNBuckets(), 6);
 }
 
+BOOST_AUTO_TEST_CASE(OpenAddressing)
+{
+  HashtableOptions options(4, HashtableOptions::OPEN_ADDRESSING);
+  BOOST_CHECK_EQUAL(options.layout, HashtableOptions::OPEN_ADDRESSING);
+  Hashtable ht(options);
+
+  std::vector<const Node*> nodes;
+  for (int i = 0; i < 100; ++i) {
+    Name name("/A");
+    name.appendNumber(i);
+    HashSequence hashes = computeHashes(name);
+    const Node* node = nullptr;
+    bool isNew = false;
+    std::tie(node, isNew) = ht.insert(name, name.size(), hashes);
+    BOOST_CHECK_EQUAL(isNew, true);
+    BOOST_CHECK(node->next == nullptr);
+    nodes.push_back(node);
+
+    std::tie(node, isNew) = ht.insert(name, 1, hashes);
+    BOOST_CHECK_EQUAL(isNew, i == 0);
+  }
+  BOOST_CHECK_EQUAL(ht.size(), 101);
+  BOOST_CHECK_GT(ht.getNBuckets(), 101);
+
+  for (int i = 0; i < 100; i += 2) {
+    ht.erase(const_cast<Node*>(nodes[i]));
+  }
+  BOOST_CHECK_EQUAL(ht.size(), 51);
+
+  size_t nFound = 0;
+  for (size_t bucket = 0; bucket < ht.getNBuckets(); ++bucket) {
+    const Node* node = ht.getBucket(bucket);
+    if (node != nullptr) {
+      BOOST_CHECK_EQUAL(ht.findBucket(node), bucket);
+      ++nFound;
+    }
+  }
+  BOOST_CHECK_EQUAL(nFound, 51);
+
+  for (int i = 0; i < 100; ++i) {
+    Name name("/A");
+    name.appendNumber(i);
+    BOOST_CHECK_EQUAL(ht.find(name, name.size()), i % 2 == 0 ? nullptr : nodes[i]);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(LongHashSequence)
+{
+  Name name;
+  for (size_t i = 0; i < HashSequence::INLINE_CAPACITY + 10; ++i) {
+    name.appendNumber(i);
+  }
+
+  HashSequence hashes = computeHashes(name);
+  BOOST_REQUIRE_EQUAL(hashes.size(), name.size() + 1);
+  for (size_t i = 0; i <= name.size(); ++i) {
+    BOOST_CHECK_EQUAL(hashes[i], computeHash(name, i));
+  }
+  BOOST_CHECK_THROW(hashes.at(name.size() + 1), std::out_of_range);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // Hashtable
 
 BOOST_AUTO_TEST_SUITE(TestEntry)
@@ -776,6 +846,37 @@ BOOST_AUTO_TEST_CASE(SurvivedIteratorAfterErase)
   BOOST_CHECK(seenNames.size() == 7);
 }
 
+// .eraseIfEmpty should not invalidate iterator with open addressing either
+BOOST_AUTO_TEST_CASE(SurvivedIteratorAfterEraseOpenAddressing)
+{
+  NameTree nt(HashtableOptions(1024, HashtableOptions::OPEN_ADDRESSING));
+  nt.lookup("/A/B/C");
+  nt.lookup("/A/D/E");
+  nt.lookup("/A/F/G");
+  nt.lookup("/H");
+
+  Name nameD("/A/D");
+  std::set<Name> seenNames;
+  for (NameTree::const_iterator it = nt.begin(); it != nt.end(); ++it) {
+    BOOST_CHECK(seenNames.insert(it->getName()).second);
+    if (it->getName() == nameD) {
+      nt.eraseIfEmpty(nt.findExactMatch("/A/F/G")); // /A/F/G and /A/F are erased
+    }
+  }
+
+  BOOST_CHECK_EQUAL(seenNames.count("/"), 1);
+  BOOST_CHECK_EQUAL(seenNames.count("/A"), 1);
+  BOOST_CHECK_EQUAL(seenNames.count("/A/B"), 1);
+  BOOST_CHECK_EQUAL(seenNames.count("/A/B/C"), 1);
+  BOOST_CHECK_EQUAL(seenNames.count("/A/D"), 1);
+  BOOST_CHECK_EQUAL(seenNames.count("/A/D/E"), 1);
+  BOOST_CHECK_EQUAL(seenNames.count("/H"), 1);
+
+  seenNames.erase("/A/F"); // /A/F may or may not appear
+  seenNames.erase("/A/F/G"); // /A/F/G may or may not appear
+  BOOST_CHECK(seenNames.size() == 7);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestNameTree
 BOOST_AUTO_TEST_SUITE_END() // Table
 
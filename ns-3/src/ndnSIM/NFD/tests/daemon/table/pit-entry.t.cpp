@@ -174,6 +174,36 @@ BOOST_AUTO_TEST_CASE(InOutRecords)
   BOOST_CHECK(entry.getOutRecord(*face2) == entry.out_end());
 }
 
+BOOST_AUTO_TEST_CASE(RecordStorage)
+{
+  auto pool = make_shared<MemoryPool>();
+  shared_ptr<Interest> interest = makeInterest("ndn:/N3gpHMfqk");
+  Entry entry(*interest, pool);
+
+  std::vector<shared_ptr<Face>> faces;
+  for (int i = 0; i < 3; ++i) {
+    faces.push_back(make_shared<DummyFace>());
+  }
+
+  // two in-records and two out-records are stored within the entry
+  entry.insertOrUpdateInRecord(*faces[0], *interest);
+  entry.insertOrUpdateInRecord(*faces[1], *interest);
+  entry.insertOrUpdateOutRecord(*faces[0], *interest);
+  entry.insertOrUpdateOutRecord(*faces[1], *interest);
+  BOOST_CHECK_EQUAL(pool->getStats().nAllocations, 0);
+
+  // more records come from the pool
+  InRecordCollection::iterator inIt = entry.insertOrUpdateInRecord(*faces[2], *interest);
+  BOOST_CHECK_EQUAL(pool->getStats().nAllocations, 1);
+  BOOST_CHECK_EQUAL(&inIt->getFace(), faces[2].get());
+
+  entry.deleteInRecord(*faces[0]);
+  BOOST_CHECK_EQUAL(pool->getStats().nDeallocations, 0);
+  entry.clearInRecords();
+  BOOST_CHECK_EQUAL(pool->getStats().nDeallocations, 1);
+  BOOST_CHECK_EQUAL(entry.getOutRecords().size(), 2);
+}
+
 BOOST_AUTO_TEST_CASE(Lifetime)
 {
   shared_ptr<Interest> interest = makeInterest("ndn:/7oIEurbgy6");
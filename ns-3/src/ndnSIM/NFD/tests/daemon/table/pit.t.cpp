@@ -193,6 +193,35 @@ BOOST_AUTO_TEST_CASE(Erase)
   BOOST_CHECK(pit.find(*interest) != nullptr);
 }
 
+BOOST_AUTO_TEST_CASE(PooledAllocation)
+{
+  shared_ptr<Interest> interest = makeInterest("/Q2eS8Ia/Hgk3");
+  shared_ptr<Entry> entry;
+  weak_ptr<MemoryPool> weakPool;
+  {
+    NameTree nameTree(16);
+    Pit pit(nameTree);
+    const MemoryPool& pool = *nameTree.getMemoryPool();
+    weakPool = nameTree.getMemoryPool();
+
+    entry = pit.insert(*interest).first;
+    BOOST_CHECK_EQUAL(pool.getStats().nAllocations, 4); // PIT entry and three name tree nodes
+    uint64_t nSystemAllocations = pool.getStats().nSystemAllocations;
+
+    pit.erase(entry.get());
+    entry.reset();
+    BOOST_CHECK_EQUAL(pool.getStats().nBytesInUse, 0);
+
+    entry = pit.insert(*interest).first;
+    BOOST_CHECK_EQUAL(pool.getStats().nSystemAllocations, nSystemAllocations);
+  }
+
+  // the entry keeps the pool alive after the tables are gone
+  BOOST_CHECK(!weakPool.expired());
+  entry.reset();
+  BOOST_CHECK(weakPool.expired());
+}
+
 BOOST_AUTO_TEST_CASE(EraseNameTreeEntry)
 {
   NameTree nameTree;
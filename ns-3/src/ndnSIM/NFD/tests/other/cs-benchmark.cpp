@@ -28,6 +28,7 @@
 
 #include <ndn-cxx/security/signature-sha256-with-rsa.hpp>
 
+#include <cstring>
 #include <iostream>
 
 #ifdef HAVE_VALGRIND
@@ -68,9 +69,15 @@ protected:
   }
 
   static shared_ptr<Data>
-  makeData(const Name& name)
+  makeData(const Name& name, size_t payloadSize = 0)
   {
     auto data = make_shared<Data>(name);
+    if (payloadSize > 0) {
+      std::vector<uint8_t> payload(payloadSize, 0);
+      std::memcpy(payload.data(), name.wireEncode().wire(),
+                  std::min(payloadSize, name.wireEncode().size()));
+      data->setContent(payload.data(), payload.size());
+    }
     ndn::SignatureSha256WithRsa fakeSignature;
     fakeSignature.setValue(ndn::encoding::makeEmptyBlock(tlv::SignatureValue));
     data->setSignature(fakeSignature);
@@ -121,16 +128,30 @@ protected:
   }
 
   static std::vector<shared_ptr<Data>>
-  makeDataWorkload(size_t count, const NameGenerator& genName = SimpleNameGenerator())
+  makeDataWorkload(size_t count, const NameGenerator& genName = SimpleNameGenerator(),
+                   size_t payloadSize = 0)
   {
     std::vector<shared_ptr<Data>> workload(count);
     for (size_t i = 0; i < count; ++i) {
       Name name = genName(i);
-      workload[i] = makeData(name);
+      workload[i] = makeData(name, payloadSize);
     }
     return workload;
   }
 
+  /** \brief copies of Data packets, as received again from a face, without cached FullName
+   */
+  static std::vector<shared_ptr<Data>>
+  copyDataWorkload(const std::vector<shared_ptr<Data>>& workload)
+  {
+    std::vector<shared_ptr<Data>> copies(workload.size());
+    for (size_t i = 0; i < workload.size(); ++i) {
+      const Block& wire = workload[i]->wireEncode();
+      copies[i] = make_shared<Data>(Block(wire.wire(), wire.size()));
+    }
+    return copies;
+  }
+
 protected:
   Cs cs;
   static constexpr size_t CS_CAPACITY = 50000;
@@ -244,5 +265,69 @@ BOOST_FIXTURE_TEST_CASE(Rightmost, CsBenchmarkFixture)
   std::cout << "find(rightmost) " << (N_INTERESTS * N_CHILDREN * REPEAT) << ": " << d << std::endl;
 }
 
+// insert 1 KB packets, insert copies of the same packets, then find hit by FullName
+BOOST_FIXTURE_TEST_CASE(FullName1k, CsBenchmarkFixture)
+{
+  constexpr size_t N_WORKLOAD = CS_CAPACITY / 2;
+  constexpr size_t PAYLOAD_SIZE = 1024;
+
+  for (bool isSimulatedDigest : {false, true}) {
+    Data::setSimulatedDigest(isSimulatedDigest);
+    Cs cs;
+    cs.setLimit(CS_CAPACITY);
+
+    std::vector<shared_ptr<Data>> dataWorkload =
+      makeDataWorkload(N_WORKLOAD, SimpleNameGenerator(), PAYLOAD_SIZE);
+    std::vector<shared_ptr<Data>> dataCopies = copyDataWorkload(dataWorkload);
+    std::vector<shared_ptr<Interest>> interestWorkload;
+    for (const auto& data : copyDataWorkload(dataWorkload)) { // keep FullName uncached in workload
+      interestWorkload.push_back(make_shared<Interest>(data->getFullName()));
+    }
+
+    time::microseconds d = timedRun([&] {
+      for (size_t i = 0; i < N_WORKLOAD; ++i) {
+        cs.insert(*dataWorkload[i], false);
+      }
+      for (size_t i = 0; i < N_WORKLOAD; ++i) {
+        cs.insert(*dataCopies[i], false);
+      }
+      for (size_t i = 0; i < N_WORKLOAD; ++i) {
+        cs.find(*interestWorkload[i], bind([]{}), bind([]{}));
+      }
+    });
+    BOOST_CHECK_EQUAL(cs.size(), N_WORKLOAD);
+
+    std::cout << "insert-insert(copy)-find(fullname) 1KB " << (N_WORKLOAD * 3)
+              << (isSimulatedDigest ? " simulated digest: " : " SHA-256 digest: ") << d << std::endl;
+  }
+  Data::setSimulatedDigest(false);
+}
+
+// find(exact) hit among siblings, as the number of entries grows
+BOOST_FIXTURE_TEST_CASE(ExactScaling, CsBenchmarkFixture)
+{
+  constexpr size_t N_LOOKUPS = 100000;
+
+  for (size_t capacity : {100, 1000, 10000, 100000, 1000000}) {
+    Cs cs;
+    cs.setLimit(capacity);
+
+    std::vector<shared_ptr<Interest>> interestWorkload = makeInterestWorkload(capacity);
+    for (size_t i = 0; i < capacity; ++i) {
+      cs.insert(*makeData(interestWorkload[i]->getName()), false);
+    }
+    BOOST_REQUIRE(cs.size() == capacity);
+
+    time::microseconds d = timedRun([&] {
+      for (size_t i = 0; i < N_LOOKUPS; ++i) {
+        cs.find(*interestWorkload[i % capacity], bind([]{}), bind([]{}));
+      }
+    });
+
+    std::cout << "find(exact) " << N_LOOKUPS << " in " << capacity << " entries: " << d
+              << " (" << (d.count() * 1000 / N_LOOKUPS) << "ns per lookup)" << std::endl;
+  }
+}
+
 } // namespace tests
 } // namespace nfd
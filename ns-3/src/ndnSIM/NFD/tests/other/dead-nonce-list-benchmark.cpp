@@ -0,0 +1,227 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2017,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "benchmark-helpers.hpp"
+#include "table/dead-nonce-list.hpp"
+
+#include "core/city-hash.hpp"
+
+#include <boost/multi_index_container.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
+#include <boost/multi_index/hashed_index.hpp>
+
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+namespace {
+
+int64_t g_nHeapBytes = 0;
+
+/// alignment-preserving header in front of each block, which records the block size
+const std::size_t HEADER_SIZE = 16;
+
+} // namespace
+
+// count the bytes held by every block obtained from the global allocator
+void*
+operator new(std::size_t size)
+{
+  char* p = static_cast<char*>(std::malloc(size + HEADER_SIZE));
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  *reinterpret_cast<std::size_t*>(p) = size;
+  g_nHeapBytes += size;
+  return p + HEADER_SIZE;
+}
+
+void
+operator delete(void* p) noexcept
+{
+  if (p == nullptr) {
+    return;
+  }
+  char* block = static_cast<char*>(p) - HEADER_SIZE;
+  g_nHeapBytes -= *reinterpret_cast<std::size_t*>(block);
+  std::free(block);
+}
+
+// used by libraries compiled with sized deallocation
+void
+operator delete(void* p, std::size_t) noexcept
+{
+  ::operator delete(p);
+}
+
+namespace nfd {
+namespace tests {
+
+/** \brief the Dead Nonce List layout before it was stored in flat arrays
+ *
+ *  Entries are kept in a boost::multi_index_container, with a sequenced index for insertion
+ *  order and a hashed_non_unique index for lookups.  Capacity is fixed.
+ */
+class MultiIndexDeadNonceList : noncopyable
+{
+public:
+  explicit
+  MultiIndexDeadNonceList(size_t capacity)
+    : m_queue(m_index.get<0>())
+    , m_ht(m_index.get<1>())
+    , m_capacity(capacity)
+  {
+  }
+
+  bool
+  has(const Name& name, uint32_t nonce) const
+  {
+    return m_ht.find(makeEntry(name, nonce)) != m_ht.end();
+  }
+
+  void
+  add(const Name& name, uint32_t nonce)
+  {
+    m_queue.push_back(makeEntry(name, nonce));
+    if (m_queue.size() > m_capacity) {
+      m_queue.pop_front();
+    }
+  }
+
+  size_t
+  size() const
+  {
+    return m_queue.size();
+  }
+
+private:
+  typedef uint64_t Entry;
+
+  static Entry
+  makeEntry(const Name& name, uint32_t nonce)
+  {
+    Block nameWire = name.wireEncode();
+    return CityHash64WithSeed(reinterpret_cast<const char*>(nameWire.wire()), nameWire.size(),
+                              static_cast<uint64_t>(nonce));
+  }
+
+  typedef boost::multi_index_container<
+    Entry,
+    boost::multi_index::indexed_by<
+      boost::multi_index::sequenced<>,
+      boost::multi_index::hashed_non_unique<
+        boost::multi_index::identity<Entry>
+      >
+    >
+  > Index;
+
+  typedef Index::nth_index<0>::type Queue;
+  typedef Index::nth_index<1>::type Hashtable;
+
+  Index m_index;
+  Queue& m_queue;
+  Hashtable& m_ht;
+  size_t m_capacity;
+};
+
+// This benchmark compares the Dead Nonce List with its former multi_index layout.
+// For each size, nEntries Nonces are added, then every one of them and as many absent Nonces
+// are looked up.  Timers are not run, so the capacity stays at nEntries.
+class DeadNonceListBenchmarkFixture
+{
+protected:
+  DeadNonceListBenchmarkFixture()
+  {
+#ifdef _DEBUG
+    std::cerr << "Benchmark compiled in debug mode is unreliable, please compile in release mode.\n";
+#endif
+
+    // Interests of 1000 flows; their Names are encoded once, as in a received Interest
+    for (size_t i = 0; i < N_NAMES; ++i) {
+      Name name("/vanet/road");
+      name.appendNumber(i).append("seg");
+      name.wireEncode();
+      names.push_back(name);
+    }
+  }
+
+  template<typename Dnl>
+  void
+  run(Dnl& dnl, size_t nEntries, const std::string& implName, int64_t initialHeapBytes)
+  {
+    auto t1 = time::steady_clock::now();
+    for (size_t i = 0; i < nEntries; ++i) {
+      dnl.add(names[i % N_NAMES], static_cast<uint32_t>(i));
+    }
+
+    auto t2 = time::steady_clock::now();
+    size_t nFound = 0;
+    for (size_t i = 0; i < nEntries; ++i) {
+      nFound += dnl.has(names[i % N_NAMES], static_cast<uint32_t>(i));
+    }
+
+    auto t3 = time::steady_clock::now();
+    size_t nFalsePositives = 0;
+    for (size_t i = 0; i < nEntries; ++i) {
+      nFalsePositives += dnl.has(names[i % N_NAMES], static_cast<uint32_t>(nEntries + i));
+    }
+    auto t4 = time::steady_clock::now();
+
+    BOOST_CHECK_EQUAL(dnl.size(), nEntries);
+    BOOST_CHECK_EQUAL(nFound, nEntries);
+    BOOST_CHECK_EQUAL(nFalsePositives, 0);
+
+    std::cout << implName << " nEntries=" << nEntries
+              << " heapBytes=" << g_nHeapBytes - initialHeapBytes
+              << " add=" << time::duration_cast<time::microseconds>(t2 - t1)
+              << " hasPresent=" << time::duration_cast<time::microseconds>(t3 - t2)
+              << " hasAbsent=" << time::duration_cast<time::microseconds>(t4 - t3)
+              << std::endl;
+  }
+
+protected:
+  static const size_t N_NAMES = 1000;
+  std::vector<Name> names;
+};
+
+BOOST_FIXTURE_TEST_CASE(AddAndLookup, DeadNonceListBenchmarkFixture)
+{
+  for (size_t nEntries : {10000, 100000, 1000000}) {
+    {
+      int64_t initialHeapBytes = g_nHeapBytes;
+      DeadNonceList dnl;
+      dnl.m_capacity = nEntries + DeadNonceList::EXPECTED_MARK_COUNT;
+      run(dnl, nEntries, "flat", initialHeapBytes);
+    }
+    {
+      int64_t initialHeapBytes = g_nHeapBytes;
+      MultiIndexDeadNonceList dnl(nEntries);
+      run(dnl, nEntries, "multi_index", initialHeapBytes);
+    }
+  }
+}
+
+} // namespace tests
+} // namespace nfd
@@ -0,0 +1,113 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2017,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "benchmark-helpers.hpp"
+#include "table/pit.hpp"
+
+#include <iostream>
+
+namespace nfd {
+namespace tests {
+
+using name_tree::HashtableOptions;
+
+// This benchmark compares the CHAINED and OPEN_ADDRESSING layouts of the name tree hashtable.
+// For each layout, nEntries PIT entries are inserted, then each of them is matched by a Data
+// through Pit::findAllDataMatches, then all of them are erased.
+class NameTreeHashtableBenchmarkFixture
+{
+protected:
+  NameTreeHashtableBenchmarkFixture()
+  {
+#ifdef _DEBUG
+    std::cerr << "Benchmark compiled in debug mode is unreliable, please compile in release mode.\n";
+#endif
+  }
+
+  void
+  generatePackets(size_t nEntries)
+  {
+    interests.clear();
+    data.clear();
+    for (size_t i = 0; i < nEntries; ++i) {
+      // 1000 producers, each serving a flat namespace of segments
+      Name interestName("/vanet");
+      interestName.append(to_string(i % 1000)).append("seg").appendNumber(i);
+      interests.push_back(make_shared<Interest>(interestName));
+      data.push_back(make_shared<Data>(Name(interestName).appendVersion(1)));
+    }
+  }
+
+  void
+  run(HashtableOptions::Layout layout, const std::string& layoutName)
+  {
+    NameTree nameTree(HashtableOptions(1024, layout));
+    Pit pit(nameTree);
+    std::vector<shared_ptr<pit::Entry>> pitEntries;
+    pitEntries.reserve(interests.size());
+
+    auto t1 = time::steady_clock::now();
+    for (const auto& interest : interests) {
+      pitEntries.push_back(pit.insert(*interest).first);
+    }
+
+    auto t2 = time::steady_clock::now();
+    size_t nMatches = 0;
+    for (const auto& d : data) {
+      nMatches += pit.findAllDataMatches(*d).size();
+    }
+
+    auto t3 = time::steady_clock::now();
+    for (const auto& pitEntry : pitEntries) {
+      pit.erase(pitEntry.get());
+    }
+    auto t4 = time::steady_clock::now();
+
+    BOOST_CHECK_EQUAL(nMatches, interests.size());
+    BOOST_CHECK_EQUAL(pit.size(), 0);
+
+    std::cout << layoutName << " nEntries=" << interests.size()
+              << " insert=" << time::duration_cast<time::microseconds>(t2 - t1)
+              << " findAllDataMatches=" << time::duration_cast<time::microseconds>(t3 - t2)
+              << " erase=" << time::duration_cast<time::microseconds>(t4 - t3)
+              << std::endl;
+  }
+
+protected:
+  std::vector<shared_ptr<Interest>> interests;
+  std::vector<shared_ptr<Data>> data;
+};
+
+BOOST_FIXTURE_TEST_CASE(PitOperations, NameTreeHashtableBenchmarkFixture)
+{
+  for (size_t nEntries : {100000, 1000000}) {
+    generatePackets(nEntries);
+    run(HashtableOptions::CHAINED, "CHAINED");
+    run(HashtableOptions::OPEN_ADDRESSING, "OPEN_ADDRESSING");
+  }
+}
+
+} // namespace tests
+} // namespace nfd
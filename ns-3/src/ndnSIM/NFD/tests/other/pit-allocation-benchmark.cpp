@@ -0,0 +1,150 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2017,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "benchmark-helpers.hpp"
+#include "table/pit.hpp"
+#include "tests/daemon/face/dummy-face.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+namespace {
+
+uint64_t g_nHeapAllocations = 0;
+
+} // namespace
+
+// count every call to the global allocator made by this program
+void*
+operator new(std::size_t size)
+{
+  ++g_nHeapAllocations;
+  void* p = std::malloc(size == 0 ? 1 : size);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void
+operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+namespace nfd {
+namespace tests {
+
+class PitAllocationBenchmarkFixture
+{
+protected:
+  PitAllocationBenchmarkFixture()
+  {
+#ifdef _DEBUG
+    std::cerr << "Benchmark compiled in debug mode is unreliable, please compile in release mode.\n";
+#endif
+
+    for (size_t i = 0; i < N_FACES; ++i) {
+      faces.push_back(make_shared<face::tests::DummyFace>());
+    }
+    for (size_t i = 0; i < N_INTERESTS; ++i) {
+      Name name("/vanet/road");
+      name.appendNumber(i % 1000).appendNumber(i);
+      interests.push_back(make_shared<Interest>(name));
+      interests.back()->setNonce(i);
+      data.push_back(make_shared<Data>(name));
+    }
+  }
+
+  /** \brief replays a multicast exchange on one node: every Interest is received from one
+   *         neighbour, forwarded to two others, then satisfied and erased after a delay
+   *  \return number of global allocations per Interest
+   */
+  double
+  run(const shared_ptr<MemoryPool>& pool)
+  {
+    NameTree nameTree(name_tree::HashtableOptions(1024), pool);
+    Pit pit(nameTree);
+    std::vector<shared_ptr<pit::Entry>> pitEntries;
+    pitEntries.reserve(N_INTERESTS);
+
+    uint64_t nAllocationsBefore = g_nHeapAllocations;
+    auto t1 = time::steady_clock::now();
+
+    for (size_t i = 0; i < N_INTERESTS + GAP; ++i) {
+      if (i < N_INTERESTS) {
+        const Interest& interest = *interests[i];
+        shared_ptr<pit::Entry> pitEntry = pit.insert(interest).first;
+        pitEntry->insertOrUpdateInRecord(*faces[i % N_FACES], interest);
+        pitEntry->insertOrUpdateOutRecord(*faces[(i + 1) % N_FACES], interest);
+        pitEntry->insertOrUpdateOutRecord(*faces[(i + 2) % N_FACES], interest);
+        pitEntries.push_back(std::move(pitEntry));
+      }
+      if (i >= GAP) {
+        size_t j = i - GAP;
+        for (const shared_ptr<pit::Entry>& pitEntry : pit.findAllDataMatches(*data[j])) {
+          pitEntry->clearInRecords();
+          pitEntry->deleteOutRecord(*faces[(j + 1) % N_FACES]);
+          pit.erase(pitEntry.get());
+        }
+        pitEntries[j].reset();
+      }
+    }
+
+    auto t2 = time::steady_clock::now();
+    double allocationsPerInterest =
+      static_cast<double>(g_nHeapAllocations - nAllocationsBefore) / N_INTERESTS;
+
+    std::cout << "  " << allocationsPerInterest << " allocations per Interest, "
+              << time::duration_cast<time::microseconds>(t2 - t1) << "\n"
+              << "  pool: " << pool->getStats() << std::endl;
+    return allocationsPerInterest;
+  }
+
+protected:
+  static const size_t N_FACES = 8;
+  static const size_t N_INTERESTS = 1000000;
+  // number of Interests received before the Data of the first Interest arrives
+  static const size_t GAP = 20000;
+
+  std::vector<shared_ptr<Face>> faces;
+  std::vector<shared_ptr<Interest>> interests;
+  std::vector<shared_ptr<Data>> data;
+};
+
+BOOST_FIXTURE_TEST_CASE(MulticastExchanges, PitAllocationBenchmarkFixture)
+{
+  std::cout << "without pool:" << std::endl;
+  double before = run(make_shared<MemoryPool>(0));
+
+  std::cout << "with pool:" << std::endl;
+  double after = run(make_shared<MemoryPool>());
+
+  BOOST_CHECK_LT(after, before);
+}
+
+} // namespace tests
+} // namespace nfd
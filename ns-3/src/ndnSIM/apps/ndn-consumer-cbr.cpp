@@ -93,10 +93,13 @@ ConsumerCbr::ScheduleNextPacket()
 {
 //	string prefix= "/nankai" + GetRandPrefix(m_seq);
 //	SetPrefix(prefix);
-	std::string csFile = "ConsumerRecord/consumer_" + std::to_string(m_node->GetId()) +"_Node.csv";
-	std::ofstream CsOut(csFile,std::ofstream::app);
-	CsOut<< ns3::Simulator::Now().GetNanoSeconds()<<","<<m_seq<<"\n";
-	CsOut.close();
+	std::shared_ptr<StatsStream> recordStream = m_recordStream.lock();
+	if (recordStream == nullptr) {
+	  recordStream = StatsSink::GetStream("ConsumerRecord/consumer_" +
+	                                      std::to_string(m_node->GetId()) + "_Node");
+	  m_recordStream = recordStream;
+	}
+	recordStream->record(ns3::Simulator::Now().GetNanoSeconds(), m_seq);
 
 	if (m_firstTime) {
 	    m_sendEvent = Simulator::Schedule(Seconds(0.0), &Consumer::SendPacket, this);
@@ -23,6 +23,7 @@
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 
 #include "ndn-consumer.hpp"
+#include "ns3/ndnSIM/utils/ndn-stats-sink.hpp"
 
 namespace ns3 {
 namespace ndn {
@@ -73,6 +74,7 @@ protected:
   bool m_firstTime;
   Ptr<RandomVariableStream> m_random;
   std::string m_randomType;
+  std::weak_ptr<StatsStream> m_recordStream; // expires when StatsSink::Destroy is called
 };
 
 } // namespace ndn
@@ -23,6 +23,10 @@
 
 #include <math.h>
 
+#include <algorithm>
+#include <map>
+#include <tuple>
+
 NS_LOG_COMPONENT_DEFINE("ndn.ConsumerZipfMandelbrot");
 
 namespace ns3 {
@@ -77,17 +81,47 @@ ConsumerZipfMandelbrot::SetNumberOfContents(uint32_t numOfContents)
 
   NS_LOG_DEBUG(m_q << " and " << m_s << " and " << m_N);
 
-  m_Pcum = std::vector<double>(m_N + 1);
+  // attributes are set one by one, so the distribution is computed only when it is used
+  m_Pcum = nullptr;
+}
+
+shared_ptr<const std::vector<double>>
+ConsumerZipfMandelbrot::GetCumulativeProbabilities(uint32_t N, double q, double s)
+{
+  typedef std::tuple<uint32_t, double, double> Parameters;
+  static std::map<Parameters, std::weak_ptr<const std::vector<double>>> tables;
+
+  std::weak_ptr<const std::vector<double>>& cached = tables[Parameters(N, q, s)];
+  shared_ptr<const std::vector<double>> table = cached.lock();
+  if (table != nullptr) {
+    return table;
+  }
+
+  // forget tables released by all their consumers
+  for (auto it = tables.begin(); it != tables.end();) {
+    if (it->second.expired() && &it->second != &cached) {
+      it = tables.erase(it);
+    }
+    else {
+      ++it;
+    }
+  }
+
+  auto Pcum = make_shared<std::vector<double>>(N + 1);
+  std::vector<double>& p = *Pcum;
 
-  m_Pcum[0] = 0.0;
-  for (uint32_t i = 1; i <= m_N; i++) {
-    m_Pcum[i] = m_Pcum[i - 1] + 1.0 / std::pow(i + m_q, m_s);
+  p[0] = 0.0;
+  for (uint32_t i = 1; i <= N; i++) {
+    p[i] = p[i - 1] + 1.0 / std::pow(i + q, s);
   }
 
-  for (uint32_t i = 1; i <= m_N; i++) {
-    m_Pcum[i] = m_Pcum[i] / m_Pcum[m_N];
-    NS_LOG_LOGIC("Cumulative probability [" << i << "]=" << m_Pcum[i]);
+  for (uint32_t i = 1; i <= N; i++) {
+    p[i] = p[i] / p[N];
+    NS_LOG_LOGIC("Cumulative probability [" << i << "]=" << p[i]);
   }
+
+  cached = Pcum;
+  return Pcum;
 }
 
 uint32_t
@@ -100,7 +134,7 @@ void
 ConsumerZipfMandelbrot::SetQ(double q)
 {
   m_q = q;
-  SetNumberOfContents(m_N);
+  m_Pcum = nullptr;
 }
 
 double
@@ -113,7 +147,7 @@ void
 ConsumerZipfMandelbrot::SetS(double s)
 {
   m_s = s;
-  SetNumberOfContents(m_N);
+  m_Pcum = nullptr;
 }
 
 double
@@ -198,24 +232,24 @@ ConsumerZipfMandelbrot::SendPacket()
 uint32_t
 ConsumerZipfMandelbrot::GetNextSeq()
 {
+  if (m_Pcum == nullptr) {
+    m_Pcum = GetCumulativeProbabilities(m_N, m_q, m_s);
+  }
+
   uint32_t content_index = 1; //[1, m_N]
-  double p_sum = 0;
 
   double p_random = m_seqRng->GetValue();
   while (p_random == 0) {
     p_random = m_seqRng->GetValue();
   }
-  // if (p_random == 0)
   NS_LOG_LOGIC("p_random=" << p_random);
-  for (uint32_t i = 1; i <= m_N; i++) {
-    p_sum = m_Pcum[i]; // m_Pcum[i] = m_Pcum[i-1] + p[i], p[0] = 0;   e.g.: p_cum[1] = p[1],
-                       // p_cum[2] = p[1] + p[2]
-    if (p_random <= p_sum) {
-      content_index = i;
-      break;
-    } // if
-  }   // for
-  // content_index = 1;
+
+  // first content whose cumulative probability reaches p_random;
+  // m_Pcum[i] = m_Pcum[i-1] + p[i], p[0] = 0;   e.g.: p_cum[1] = p[1], p_cum[2] = p[1] + p[2]
+  auto it = std::lower_bound(m_Pcum->begin() + 1, m_Pcum->end(), p_random);
+  if (it != m_Pcum->end()) {
+    content_index = static_cast<uint32_t>(it - m_Pcum->begin());
+  }
   NS_LOG_DEBUG("RandomNumber=" << content_index);
   return content_index;
 }
@@ -90,11 +90,21 @@ private:
   double
   GetS() const;
 
+  /**
+   * \brief Get cumulative probabilities of contents 1..N, shared by all consumers with the
+   *        same N, q and s
+   *
+   * Element 0 is 0, element N is 1.  The table is computed by the first consumer that needs it,
+   * and released when no consumer uses it anymore.
+   */
+  static shared_ptr<const std::vector<double>>
+  GetCumulativeProbabilities(uint32_t N, double q, double s);
+
 private:
   uint32_t m_N;               // number of the contents
   double m_q;                 // q in (k+q)^s
   double m_s;                 // s in (k+q)^s
-  std::vector<double> m_Pcum; // cumulative probability
+  shared_ptr<const std::vector<double>> m_Pcum; // cumulative probability, computed on first use
 
   Ptr<UniformRandomVariable> m_seqRng; // RNG
 };
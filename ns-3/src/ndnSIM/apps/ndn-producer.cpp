@@ -27,6 +27,7 @@
 #include "model/ndn-l3-protocol.hpp"
 #include "helper/ndn-fib-helper.hpp"
 
+#include <map>
 #include <memory>
 
 NS_LOG_COMPONENT_DEFINE("ndn.Producer");
@@ -72,6 +73,18 @@ Producer::Producer()
   NS_LOG_FUNCTION_NOARGS();
 }
 
+shared_ptr<const ::ndn::Buffer>
+Producer::GetVirtualPayload(uint32_t size)
+{
+  static std::map<uint32_t, shared_ptr<const ::ndn::Buffer>> payloads;
+
+  auto& payload = payloads[size];
+  if (payload == nullptr) {
+    payload = make_shared< ::ndn::Buffer>(size);
+  }
+  return payload;
+}
+
 // inherited from Application base class.
 void
 Producer::StartApplication()
@@ -103,10 +116,14 @@ Producer::OnInterest(shared_ptr<const Interest> interest)
   if(hoptag != nullptr)
 	  hopCount = *hoptag;
   NS_LOG_INFO("<<<<<interest hop : "<<hopCount);
-  std::string csFile = "HopRecord/hop_" + std::to_string(m_node->GetId()) +"_Node.csv";
-  std::ofstream CsOut(csFile,std::ofstream::app);
-  CsOut<< ns3::Simulator::Now().GetNanoSeconds()<<","<<interest->getName()<<","<<hopCount<<"\n";
-  CsOut.close();
+  std::shared_ptr<StatsStream> hopRecordStream = m_hopRecordStream.lock();
+  if (hopRecordStream == nullptr) {
+    hopRecordStream = StatsSink::GetStream("HopRecord/hop_" + std::to_string(m_node->GetId()) +
+                                           "_Node");
+    m_hopRecordStream = hopRecordStream;
+  }
+  hopRecordStream->record(ns3::Simulator::Now().GetNanoSeconds(), interest->getName().toUri(),
+                          hopCount);
 
 
   NS_LOG_FUNCTION(this << interest);
@@ -122,7 +139,7 @@ Producer::OnInterest(shared_ptr<const Interest> interest)
   data->setName(dataName);
   data->setFreshnessPeriod(::ndn::time::milliseconds(m_freshness.GetMilliSeconds()));
 
-  data->setContent(make_shared< ::ndn::Buffer>(m_virtualPayloadSize));
+  data->setContent(GetVirtualPayload(m_virtualPayloadSize));
 
   Signature signature;
   SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
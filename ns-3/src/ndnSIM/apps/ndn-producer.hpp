@@ -24,6 +24,7 @@
 
 #include "ndn-app.hpp"
 #include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/utils/ndn-stats-sink.hpp"
 
 #include "ns3/nstime.h"
 #include "ns3/ptr.h"
@@ -94,6 +95,14 @@ public:
   virtual void
   OnInterest(shared_ptr<const Interest> interest);
 
+  /**
+   * @brief Get a zero-filled virtual payload of the given size
+   *
+   * Payloads are shared by all producers, so Data packets of the same size reuse one buffer.
+   */
+  static shared_ptr<const ::ndn::Buffer>
+  GetVirtualPayload(uint32_t size);
+
 protected:
   // inherited from Application base class.
   virtual void
@@ -110,6 +119,8 @@ private:
 
   uint32_t m_signature;
   Name m_keyLocator;
+
+  std::weak_ptr<StatsStream> m_hopRecordStream; // expires when StatsSink::Destroy is called
 };
 
 } // namespace ndn
@@ -39,6 +39,7 @@
 #include "ns3/data-rate.h"
 
 #include "daemon/mgmt/fib-manager.hpp"
+#include "daemon/fw/forwarder.hpp"
 #include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
 #include "ns3/ndnSIM/helper/ndn-stack-helper.hpp"
 
@@ -50,6 +51,19 @@ NS_LOG_COMPONENT_DEFINE("ndn.FibHelper");
 void
 FibHelper::AddNextHop(const ControlParameters& parameters, Ptr<Node> node)
 {
+  Ptr<L3Protocol> l3protocol = node->GetObject<L3Protocol>();
+  if (l3protocol->isManagementDisabled()) {
+    // no FibManager to process the command, change the FIB directly
+    shared_ptr<nfd::Forwarder> forwarder = l3protocol->getForwarder();
+    nfd::Face* face = forwarder->getFaceTable().get(parameters.getFaceId());
+    NS_ASSERT_MSG(face != nullptr, "Face with ID [" << parameters.getFaceId()
+                                                    << "] does not exist on node ["
+                                                    << node->GetId() << "]");
+    nfd::fib::Entry* entry = forwarder->getFib().insert(parameters.getName()).first;
+    entry->addNextHop(*face, parameters.getCost());
+    return;
+  }
+
   NS_LOG_DEBUG("Add Next Hop command was initialized");
   Block encodedParameters(parameters.wireEncode());
 
@@ -60,13 +74,27 @@ FibHelper::AddNextHop(const ControlParameters& parameters, Ptr<Node> node)
   shared_ptr<Interest> command(make_shared<Interest>(commandName));
   StackHelper::getKeyChain().sign(*command);
 
-  Ptr<L3Protocol> l3protocol = node->GetObject<L3Protocol>();
   l3protocol->injectInterest(*command);
 }
 
 void
 FibHelper::RemoveNextHop(const ControlParameters& parameters, Ptr<Node> node)
 {
+  Ptr<L3Protocol> l3protocol = node->GetObject<L3Protocol>();
+  if (l3protocol->isManagementDisabled()) {
+    // no FibManager to process the command, change the FIB directly
+    shared_ptr<nfd::Forwarder> forwarder = l3protocol->getForwarder();
+    nfd::Face* face = forwarder->getFaceTable().get(parameters.getFaceId());
+    nfd::fib::Entry* entry = forwarder->getFib().findExactMatch(parameters.getName());
+    if (face != nullptr && entry != nullptr) {
+      entry->removeNextHop(*face);
+      if (!entry->hasNextHops()) {
+        forwarder->getFib().erase(*entry);
+      }
+    }
+    return;
+  }
+
   NS_LOG_DEBUG("Remove Next Hop command was initialized");
   Block encodedParameters(parameters.wireEncode());
 
@@ -77,7 +105,6 @@ FibHelper::RemoveNextHop(const ControlParameters& parameters, Ptr<Node> node)
   shared_ptr<Interest> command(make_shared<Interest>(commandName));
   StackHelper::getKeyChain().sign(*command);
 
-  Ptr<L3Protocol> l3protocol = node->GetObject<L3Protocol>();
   l3protocol->injectInterest(*command);
 }
 
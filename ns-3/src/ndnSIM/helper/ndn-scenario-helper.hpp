@@ -190,6 +190,13 @@ public: // topology accessors
   void
   disableForwarderStatusManager();
 
+  /**
+   * \brief Install only the forwarder, without NFD management
+   * \see StackHelper::disableManagement
+   */
+  void
+  disableManagement();
+
   /**
    * \brief Get NDN stack helper, e.g., to adjust its parameters
    */
@@ -49,6 +49,7 @@ StackHelper::StackHelper()
   // , m_isFaceManagerDisabled(false)
   , m_isForwarderStatusManagerDisabled(false)
   , m_isStrategyChoiceManagerDisabled(false)
+  , m_isManagementDisabled(false)
   , m_needSetDefaultRoutes(false)
   , m_maxCsSize(100)
 {
@@ -133,6 +134,7 @@ void
 StackHelper::setCsSize(size_t maxSize)
 {
   m_maxCsSize = maxSize;
+  m_nfdConfig = nullptr;
 }
 
 void
@@ -151,6 +153,12 @@ StackHelper::setPolicy(const std::string& policy)
   }
 }
 
+void
+StackHelper::setSimulatedDigest(bool isSimulated)
+{
+  ::ndn::Data::setSimulatedDigest(isSimulated);
+}
+
 Ptr<FaceContainer>
 StackHelper::Install(const NodeContainer& c) const
 {
@@ -179,24 +187,7 @@ StackHelper::Install(Ptr<Node> node) const
   }
 
   Ptr<L3Protocol> ndn = m_ndnFactory.Create<L3Protocol>();
-
-  if (m_isRibManagerDisabled) {
-    ndn->getConfig().put("ndnSIM.disable_rib_manager", true);
-  }
-
-  // if (m_isFaceManagerDisabled) {
-  //   ndn->getConfig().put("ndnSIM.disable_face_manager", true);
-  // }
-
-  if (m_isForwarderStatusManagerDisabled) {
-    ndn->getConfig().put("ndnSIM.disable_forwarder_status_manager", true);
-  }
-
-  if (m_isStrategyChoiceManagerDisabled) {
-    ndn->getConfig().put("ndnSIM.disable_strategy_choice_manager", true);
-  }
-
-  ndn->getConfig().put("tables.cs_max_packets", (m_maxCsSize == 0) ? 1 : m_maxCsSize);
+  ndn->setConfig(getNfdConfig());
 
   // Create and aggregate content store if NFD's contest store has been disabled
   if (m_maxCsSize == 0) {
@@ -223,6 +214,42 @@ StackHelper::Install(Ptr<Node> node) const
   return faces;
 }
 
+shared_ptr<const nfd::ConfigSection>
+StackHelper::getNfdConfig() const
+{
+  if (m_nfdConfig != nullptr) {
+    return m_nfdConfig;
+  }
+
+  auto config = make_shared<nfd::ConfigSection>(*L3Protocol::getDefaultConfig());
+
+  if (m_isRibManagerDisabled) {
+    config->put("ndnSIM.disable_rib_manager", true);
+  }
+
+  // if (m_isFaceManagerDisabled) {
+  //   config->put("ndnSIM.disable_face_manager", true);
+  // }
+
+  if (m_isForwarderStatusManagerDisabled) {
+    config->put("ndnSIM.disable_forwarder_status_manager", true);
+  }
+
+  if (m_isStrategyChoiceManagerDisabled) {
+    config->put("ndnSIM.disable_strategy_choice_manager", true);
+    config->get_child("authorizations").get_child("authorize").get_child("privileges").erase("strategy-choice");
+  }
+
+  if (m_isManagementDisabled) {
+    config->put("ndnSIM.disable_management", true);
+  }
+
+  config->put("tables.cs_max_packets", (m_maxCsSize == 0) ? 1 : m_maxCsSize);
+
+  m_nfdConfig = config;
+  return m_nfdConfig;
+}
+
 void
 StackHelper::AddFaceCreateCallback(TypeId netDeviceType,
                                    StackHelper::FaceCreateCallback callback)
@@ -406,6 +433,7 @@ void
 StackHelper::disableRibManager()
 {
   m_isRibManagerDisabled = true;
+  m_nfdConfig = nullptr;
 }
 
 // void
@@ -418,12 +446,21 @@ void
 StackHelper::disableStrategyChoiceManager()
 {
   m_isStrategyChoiceManagerDisabled = true;
+  m_nfdConfig = nullptr;
 }
 
 void
 StackHelper::disableForwarderStatusManager()
 {
   m_isForwarderStatusManagerDisabled = true;
+  m_nfdConfig = nullptr;
+}
+
+void
+StackHelper::disableManagement()
+{
+  m_isManagementDisabled = true;
+  m_nfdConfig = nullptr;
 }
 
 } // namespace ndn
@@ -86,6 +86,16 @@ public:
   void
   setPolicy(const std::string& policy);
 
+  /**
+   * @brief Use a cheap 64-bit hash instead of SHA-256 as implicit digest of Data packets
+   *
+   * Content Store operations that need full names (different Data packets with the same name,
+   * Interests with an implicit digest) become much cheaper, but full names no longer match those
+   * computed by real NDN software.  Applies to all nodes; call before the simulation starts.
+   */
+  static void
+  setSimulatedDigest(bool isSimulated);
+
   /**
    * @brief Set ndnSIM 1.0 content store implementation and its attributes
    * @param contentStoreClass string, representing class of the content store
@@ -248,6 +258,20 @@ public:
   void
   disableForwarderStatusManager();
 
+  /**
+   * \brief Install only the forwarder, its tables and faces, without NFD management
+   *
+   * Neither the management dispatcher nor any of the managers (including the RIB manager) and
+   * their internal faces are created, which reduces per-node memory and startup time in
+   * simulations with many nodes.  FibHelper and StrategyChoiceHelper then modify the FIB and
+   * the strategy choice table directly, instead of sending signed command Interests.
+   *
+   * Applications that register prefixes through NFD management (e.g. ndn::Face::registerPrefix)
+   * do not work on such nodes.
+   */
+  void
+  disableManagement();
+
 private:
   shared_ptr<Face>
   DefaultNetDeviceCallback(Ptr<Node> node, Ptr<L3Protocol> ndn, Ptr<NetDevice> netDevice) const;
@@ -258,10 +282,18 @@ private:
   shared_ptr<Face>
   createAndRegisterFace(Ptr<Node> node, Ptr<L3Protocol> ndn, Ptr<NetDevice> device) const;
 
+  /**
+   * \brief Get NFD config for the nodes, shared by all nodes installed with the same settings
+   */
+  shared_ptr<const nfd::ConfigSection>
+  getNfdConfig() const;
+
   bool m_isRibManagerDisabled;
   // bool m_isFaceManagerDisabled;
   bool m_isForwarderStatusManagerDisabled;
   bool m_isStrategyChoiceManagerDisabled;
+  bool m_isManagementDisabled;
+  mutable shared_ptr<const nfd::ConfigSection> m_nfdConfig; ///< \brief built on first Install
 
 public:
   void
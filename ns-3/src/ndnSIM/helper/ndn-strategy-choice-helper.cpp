@@ -23,6 +23,8 @@
 
 #include "ndn-stack-helper.hpp"
 
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+
 namespace ns3 {
 namespace ndn {
 
@@ -31,6 +33,18 @@ NS_LOG_COMPONENT_DEFINE("ndn.StrategyChoiceHelper");
 void
 StrategyChoiceHelper::sendCommand(const ControlParameters& parameters, Ptr<Node> node)
 {
+  Ptr<L3Protocol> l3protocol = node->GetObject<L3Protocol>();
+  if (l3protocol->isManagementDisabled()) {
+    // no StrategyChoiceManager to process the command, change the table directly
+    auto result = l3protocol->getForwarder()->getStrategyChoice().insert(parameters.getName(),
+                                                                          parameters.getStrategy());
+    if (!result) {
+      NS_FATAL_ERROR("Cannot set strategy " << parameters.getStrategy() << " for "
+                     << parameters.getName() << " on node " << node->GetId() << ": " << result);
+    }
+    return;
+  }
+
   NS_LOG_DEBUG("Strategy choice command was initialized");
   Block encodedParameters(parameters.wireEncode());
 
@@ -41,7 +55,6 @@ StrategyChoiceHelper::sendCommand(const ControlParameters& parameters, Ptr<Node>
   shared_ptr<Interest> command(make_shared<Interest>(commandName));
   StackHelper::getKeyChain().sign(*command);
 
-  Ptr<L3Protocol> l3protocol = node->GetObject<L3Protocol>();
   l3protocol->injectInterest(*command);
 }
 
@@ -102,7 +102,7 @@ public:
 
   // from ContentStore
 
-  virtual inline shared_ptr<Data>
+  virtual inline shared_ptr<const Data>
   Lookup(shared_ptr<const Interest> interest);
 
   virtual inline bool
@@ -202,7 +202,7 @@ private:
 };
 
 template<class Policy>
-shared_ptr<Data>
+shared_ptr<const Data>
 ContentStoreImpl<Policy>::Lookup(shared_ptr<const Interest> interest)
 {
   NS_LOG_FUNCTION(this << interest->getName());
@@ -218,9 +218,7 @@ ContentStoreImpl<Policy>::Lookup(shared_ptr<const Interest> interest)
 
   if (node != this->end()) {
     this->m_cacheHitsTrace(interest, node->payload()->GetData());
-
-    shared_ptr<Data> copy = make_shared<Data>(*node->payload()->GetData());
-    return copy;
+    return node->payload()->GetData();
   }
   else {
     this->m_cacheMissesTrace(interest);
@@ -119,8 +119,11 @@ public:
    *
    * If an entry is found, it is promoted to the top of most recent
    * used entries index, \see m_contentStore
+   *
+   * \return the cached Data itself, which is shared with the content store and other users.
+   *         Tags are per-hop state and are reset by the forwarder on every hit.
    */
-  virtual shared_ptr<Data>
+  virtual shared_ptr<const Data>
   Lookup(shared_ptr<const Interest> interest) = 0;
 
   /**
@@ -19,16 +19,13 @@
 
 #include "ndn-block-header.hpp"
 
-#include <iosfwd>
-#include <boost/iostreams/concepts.hpp>
-#include <boost/iostreams/stream.hpp>
+#include <algorithm>
 
 #include <ndn-cxx/encoding/tlv.hpp>
 #include <ndn-cxx/interest.hpp>
 #include <ndn-cxx/data.hpp>
 #include <ndn-cxx/lp/packet.hpp>
 
-namespace io = boost::iostreams;
 namespace nfdFace = nfd::face;
 
 namespace ns3 {
@@ -73,37 +70,47 @@ BlockHeader::Serialize(ns3::Buffer::Iterator start) const
   start.Write(m_block.wire(), m_block.size());
 }
 
-class Ns3BufferIteratorSource : public io::source {
-public:
-  Ns3BufferIteratorSource(ns3::Buffer::Iterator& is)
-    : m_is(is)
-  {
+uint32_t
+BlockHeader::Deserialize(ns3::Buffer::Iterator start)
+{
+  namespace tlv = ::ndn::tlv;
+
+  // TLV-TYPE and TLV-LENGTH take at most 9 octets each
+  static const size_t MAX_TL_SIZE = 18;
+
+  uint8_t tl[MAX_TL_SIZE];
+  size_t nPeeked = std::min<size_t>(MAX_TL_SIZE, start.GetRemainingSize());
+  start.Read(tl, nPeeked);
+
+  const uint8_t* pos = tl;
+  const uint8_t* end = tl + nPeeked;
+  uint32_t type = 0;
+  uint64_t length = 0;
+  if (!tlv::readType(pos, end, type) || !tlv::readVarNumber(pos, end, length)) {
+    BOOST_THROW_EXCEPTION(tlv::Error("Insufficient data during TLV parsing"));
   }
 
-  std::streamsize
-  read(char* buf, std::streamsize nMaxRead)
-  {
-    std::streamsize i = 0;
-    for (; i < nMaxRead && !m_is.IsEnd(); ++i) {
-      buf[i] = m_is.ReadU8();
-    }
-    if (i == 0) {
-      return -1;
-    }
-    else {
-      return i;
-    }
+  size_t tlSize = pos - tl;
+  if (tlSize + length > ::ndn::MAX_NDN_PACKET_SIZE) {
+    BOOST_THROW_EXCEPTION(tlv::Error("TLV-LENGTH from ns3::Buffer exceeds limit"));
+  }
+  size_t totalSize = tlSize + length;
+  if (totalSize > nPeeked + start.GetRemainingSize()) {
+    BOOST_THROW_EXCEPTION(tlv::Error("Not enough bytes in ns3::Buffer to fully parse TLV"));
   }
 
-private:
-  ns3::Buffer::Iterator& m_is;
-};
+  // the peeked octets may already contain part of (or the whole) TLV-VALUE; the rest is pulled out
+  // of the ns3::Buffer with one bulk read straight into the wire buffer of the new Block
+  auto buffer = make_shared< ::ndn::Buffer>(totalSize);
+  size_t nCopied = std::min(nPeeked, totalSize);
+  std::copy(tl, tl + nCopied, buffer->begin());
+  if (totalSize > nCopied) {
+    start.Read(buffer->data() + nCopied, totalSize - nCopied);
+  }
 
-uint32_t
-BlockHeader::Deserialize(ns3::Buffer::Iterator start)
-{
-  io::stream<Ns3BufferIteratorSource> is(start);
-  m_block = ::ndn::Block::fromStream(is);
+  m_block = Block(buffer, type,
+                  buffer->begin(), buffer->end(),
+                  buffer->begin() + tlSize, buffer->end());
   return m_block.size();
 }
 
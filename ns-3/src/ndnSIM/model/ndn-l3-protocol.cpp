@@ -104,6 +104,17 @@ L3Protocol::GetTypeId(void)
       .AddTraceSource("TimedOutInterests", "TimedOutInterests",
                       MakeTraceSourceAccessor(&L3Protocol::m_timedOutInterests),
                       "ns3::ndn::L3Protocol::TimedOutInterestsCallback")
+
+      ////////////////////////////////////////////////////////////////////
+
+      .AddAttribute("MemoryUsagePeriod",
+                    "How often TableMemoryUsage is traced (0 disables memory usage tracing)",
+                    TimeValue(Seconds(0)), MakeTimeAccessor(&L3Protocol::m_memoryUsagePeriod),
+                    MakeTimeChecker())
+      .AddTraceSource("TableMemoryUsage",
+                      "Periodic snapshot of the memory used by the tables of the forwarder",
+                      MakeTraceSourceAccessor(&L3Protocol::m_tableMemoryUsage),
+                      "ns3::ndn::L3Protocol::TableMemoryUsageCallback")
     ;
   return tid;
 }
@@ -111,6 +122,35 @@ L3Protocol::GetTypeId(void)
 class L3Protocol::Impl {
 private:
   Impl()
+    : m_sharedConfig(getInitialConfig())
+    , m_isManagementDisabled(false)
+  {
+  }
+
+  /**
+   * \brief Get the NFD config every node starts with
+   *
+   * The config is parsed once and shared by all nodes, until a node modifies it.
+   */
+  static const shared_ptr<const nfd::ConfigSection>&
+  getInitialConfig()
+  {
+    static const shared_ptr<const nfd::ConfigSection> config =
+      make_shared<nfd::ConfigSection>(parseInitialConfig());
+    return config;
+  }
+
+  /**
+   * \brief Get NFD config for reading, without making a copy of a shared config
+   */
+  const nfd::ConfigSection&
+  getConfig() const
+  {
+    return m_config != nullptr ? *m_config : *m_sharedConfig;
+  }
+
+  static nfd::ConfigSection
+  parseInitialConfig()
   {
     // Do not modify initial config file. Use helpers to set specific NFD parameters
     std::string initialConfig =
@@ -162,7 +202,9 @@ private:
       "\n";
 
     std::istringstream input(initialConfig);
-    boost::property_tree::read_info(input, m_config);
+    nfd::ConfigSection config;
+    boost::property_tree::read_info(input, config);
+    return config;
   }
 
   friend class L3Protocol;
@@ -186,7 +228,9 @@ private:
 
   std::shared_ptr<nfd::face::FaceSystem> m_faceSystem;
 
-  nfd::ConfigSection m_config;
+  shared_ptr<const nfd::ConfigSection> m_sharedConfig; ///< \brief config shared with other nodes
+  std::unique_ptr<nfd::ConfigSection> m_config; ///< \brief own config, once modified on this node
+  bool m_isManagementDisabled;
 
   Ptr<ContentStore> m_csFromNdnSim;
   PolicyCreationCallback m_policy;
@@ -208,12 +252,19 @@ L3Protocol::initialize()
 {
   m_impl->m_forwarder = make_shared<nfd::Forwarder>();
 
-  initializeManagement();
+  m_impl->m_isManagementDisabled = m_impl->getConfig().get<bool>("ndnSIM.disable_management", false);
+  if (m_impl->m_isManagementDisabled) {
+    initializeTables();
+  }
+  else {
+    initializeManagement();
+  }
 
   nfd::FaceTable& faceTable = m_impl->m_forwarder->getFaceTable();
   faceTable.addReserved(nfd::face::makeNullFace(), nfd::face::FACEID_NULL);
 
-  if (!this->getConfig().get<bool>("ndnSIM.disable_rib_manager", false)) {
+  if (!m_impl->m_isManagementDisabled &&
+      !m_impl->getConfig().get<bool>("ndnSIM.disable_rib_manager", false)) {
     Simulator::ScheduleWithContext(m_node->GetId(), Seconds(0), &L3Protocol::initializeRibManager, this);
   }
 
@@ -249,15 +300,80 @@ private:
 void
 L3Protocol::injectInterest(const Interest& interest)
 {
+  NS_ASSERT_MSG(m_impl->m_internalFace != nullptr,
+                "Cannot inject Interest: NFD management is disabled on node " << m_node->GetId());
   m_impl->m_internalFace->sendInterest(interest);
 }
 
+bool
+L3Protocol::isManagementDisabled() const
+{
+  return m_impl->m_isManagementDisabled;
+}
+
 void
 L3Protocol::setCsReplacementPolicy(const PolicyCreationCallback& policy)
 {
   m_impl->m_policy = policy;
 }
 
+TableMemoryUsage
+L3Protocol::getTableMemoryUsage() const
+{
+  nfd::Forwarder& forwarder = *m_impl->m_forwarder;
+  TableMemoryUsage usage;
+
+  usage.nameTree.nObjects = forwarder.getNameTree().size();
+  usage.nameTree.nBytes = usage.nameTree.nObjects * sizeof(nfd::name_tree::Node);
+
+  usage.pit.nObjects = forwarder.getPit().size();
+  usage.pit.nBytes = usage.pit.nObjects * sizeof(nfd::pit::Entry);
+  for (const nfd::pit::Entry& entry : forwarder.getPit()) {
+    usage.pitInRecords.nObjects += entry.getInRecords().size();
+    usage.pitOutRecords.nObjects += entry.getOutRecords().size();
+  }
+  usage.pitInRecords.nBytes = usage.pitInRecords.nObjects * sizeof(nfd::pit::InRecord);
+  usage.pitOutRecords.nBytes = usage.pitOutRecords.nObjects * sizeof(nfd::pit::OutRecord);
+
+  const nfd::MemoryPool::Stats& poolStats = forwarder.getNameTree().getMemoryPool()->getStats();
+  usage.tablePool.nObjects = poolStats.nAllocations - poolStats.nDeallocations;
+  usage.tablePool.nBytes = poolStats.nBytesReserved;
+
+  if (m_impl->m_csFromNdnSim != nullptr) {
+    ContentStore& cs = *m_impl->m_csFromNdnSim;
+    for (Ptr<cs::Entry> entry = cs.Begin(); entry != cs.End(); entry = cs.Next(entry)) {
+      ++usage.cs.nObjects;
+      usage.cs.nBytes += entry->GetData()->wireEncode().size();
+    }
+  }
+  else {
+    for (const nfd::cs::Entry& entry : forwarder.getCs()) {
+      ++usage.cs.nObjects;
+      usage.cs.nBytes += entry.getData().wireEncode().size();
+    }
+  }
+
+  usage.deadNonceList.nObjects = forwarder.getDeadNonceList().size();
+  usage.deadNonceList.nBytes = forwarder.getDeadNonceList().getMemoryUsage();
+
+  usage.measurements.nObjects = forwarder.getMeasurements().size();
+  usage.measurements.nBytes = usage.measurements.nObjects * sizeof(nfd::measurements::Entry);
+
+  usage.fib.nObjects = forwarder.getFib().size();
+  usage.fib.nBytes = usage.fib.nObjects * sizeof(nfd::fib::Entry);
+
+  return usage;
+}
+
+void
+L3Protocol::traceMemoryUsage()
+{
+  m_tableMemoryUsage(getTableMemoryUsage());
+
+  m_memoryUsageEvent = Simulator::Schedule(m_memoryUsagePeriod, &L3Protocol::traceMemoryUsage,
+                                           this);
+}
+
 void
 L3Protocol::initializeManagement()
 {
@@ -288,16 +404,16 @@ L3Protocol::initializeManagement()
   //   this->getConfig().get_child("authorizations").get_child("authorize").get_child("privileges").erase("faces");
   // }
 
-  if (!this->getConfig().get<bool>("ndnSIM.disable_strategy_choice_manager", false)) {
+  if (!m_impl->getConfig().get<bool>("ndnSIM.disable_strategy_choice_manager", false)) {
     m_impl->m_strategyChoiceManager.reset(new StrategyChoiceManager(forwarder->getStrategyChoice(),
                                                                     *m_impl->m_dispatcher,
                                                                     *m_impl->m_authenticator));
   }
-  else {
+  else if (m_impl->getConfig().get_child_optional("authorizations.authorize.privileges.strategy-choice")) {
     this->getConfig().get_child("authorizations").get_child("authorize").get_child("privileges").erase("strategy-choice");
   }
 
-  if (!this->getConfig().get<bool>("ndnSIM.disable_forwarder_status_manager", false)) {
+  if (!m_impl->getConfig().get<bool>("ndnSIM.disable_forwarder_status_manager", false)) {
     m_impl->m_forwarderStatusManager.reset(new ForwarderStatusManager(*forwarder, *m_impl->m_dispatcher));
   }
 
@@ -319,7 +435,7 @@ L3Protocol::initializeManagement()
   // }
 
   // apply config
-  config.parse(m_impl->m_config, false, "ndnSIM.conf");
+  config.parse(m_impl->getConfig(), false, "ndnSIM.conf");
 
   tablesConfig.ensureConfigured();
 
@@ -330,6 +446,27 @@ L3Protocol::initializeManagement()
   m_impl->m_dispatcher->addTopPrefix(topPrefix, false);
 }
 
+void
+L3Protocol::initializeTables()
+{
+  auto& forwarder = m_impl->m_forwarder;
+  using namespace nfd;
+
+  m_impl->m_csFromNdnSim = GetObject<ContentStore>();
+  if (m_impl->m_csFromNdnSim == nullptr) {
+    forwarder->getCs().setPolicy(m_impl->m_policy());
+  }
+
+  // only the "tables" section applies: there is no manager to handle the other sections
+  ConfigFile config(&ConfigFile::ignoreUnknownSection);
+  TablesConfigSection tablesConfig(*forwarder);
+  tablesConfig.setConfigFile(config);
+
+  config.parse(m_impl->getConfig(), false, "ndnSIM.conf");
+
+  tablesConfig.ensureConfigured();
+}
+
 void
 L3Protocol::initializeRibManager()
 {
@@ -359,7 +496,7 @@ L3Protocol::initializeRibManager()
   m_impl->m_ribManager->setConfigFile(config);
 
   // apply config
-  config.parse(m_impl->m_config, false, "ndnSIM.conf");
+  config.parse(m_impl->getConfig(), false, "ndnSIM.conf");
 
   m_impl->m_ribManager->registerWithNfd();
 }
@@ -385,7 +522,25 @@ L3Protocol::getStrategyChoiceManager()
 nfd::ConfigSection&
 L3Protocol::getConfig()
 {
-  return m_impl->m_config;
+  if (m_impl->m_config == nullptr) {
+    m_impl->m_config.reset(new nfd::ConfigSection(*m_impl->m_sharedConfig));
+    m_impl->m_sharedConfig.reset();
+  }
+  return *m_impl->m_config;
+}
+
+void
+L3Protocol::setConfig(shared_ptr<const nfd::ConfigSection> config)
+{
+  NS_ASSERT_MSG(m_node == nullptr, "NFD config must be set before the stack is installed");
+  m_impl->m_sharedConfig = std::move(config);
+  m_impl->m_config.reset();
+}
+
+shared_ptr<const nfd::ConfigSection>
+L3Protocol::getDefaultConfig()
+{
+  return Impl::getInitialConfig();
 }
 
 /*
@@ -405,6 +560,11 @@ L3Protocol::NotifyNewAggregate()
       if (m_impl->m_csFromNdnSim != nullptr) {
         m_impl->m_forwarder->setCsFromNdnSim(m_impl->m_csFromNdnSim);
       }
+
+      if (m_memoryUsagePeriod.IsStrictlyPositive()) {
+        m_memoryUsageEvent = Simulator::Schedule(m_memoryUsagePeriod, &L3Protocol::traceMemoryUsage,
+                                                 this);
+      }
     }
   }
 
@@ -416,6 +576,8 @@ L3Protocol::DoDispose(void)
 {
   NS_LOG_FUNCTION(this);
 
+  m_memoryUsageEvent.Cancel();
+
   // MUST HAPPEN BEFORE Simulator IS DESTROYED
   m_impl.reset();
 
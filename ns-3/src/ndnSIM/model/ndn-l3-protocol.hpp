@@ -21,6 +21,7 @@
 #define NDN_L3_PROTOCOL_H
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/utils/ndn-memory-usage.hpp"
 
 #include <list>
 #include <vector>
@@ -28,6 +29,7 @@
 #include "ns3/ptr.h"
 #include "ns3/net-device.h"
 #include "ns3/nstime.h"
+#include "ns3/event-id.h"
 #include "ns3/traced-callback.h"
 
 #include <boost/property_tree/ptree_fwd.hpp>
@@ -53,6 +55,8 @@ class Header;
 
 namespace ndn {
 
+class L3Tracer;
+
 /**
  * \defgroup ndn ndnSIM: NDN simulation module
  *
@@ -146,16 +150,45 @@ public:
 
   /**
    * \brief Get NFD config (boost::property_tree)
+   *
+   * If the config is shared with other nodes, the node gets its own copy first, so that
+   * changes affect only this node.
    */
   nfd::ConfigSection&
   getConfig();
 
+  /**
+   * \brief Use \p config as NFD config, sharing it with other nodes
+   *
+   * \p config must not be changed afterwards; use getConfig() to change the config of one node.
+   * Must be called before the stack is aggregated to a node.
+   */
+  void
+  setConfig(shared_ptr<const nfd::ConfigSection> config);
+
+  /**
+   * \brief Get the NFD config that every node starts with
+   */
+  static shared_ptr<const nfd::ConfigSection>
+  getDefaultConfig();
+
   /**
    * \brief Inject interest through internal Face
    */
   void
   injectInterest(const Interest& interest);
 
+  /**
+   * \brief Check whether the node runs only the forwarder, without NFD management
+   *
+   * On such a node there is no internal face, so that injectInterest() cannot be used, and
+   * FibHelper and StrategyChoiceHelper modify the forwarder's tables directly.
+   *
+   * \see StackHelper::disableManagement
+   */
+  bool
+  isManagementDisabled() const;
+
   typedef std::function<std::unique_ptr<nfd::cs::Policy>()> PolicyCreationCallback;
 
   /**
@@ -164,6 +197,16 @@ public:
   void
   setCsReplacementPolicy(const PolicyCreationCallback& policy);
 
+  /**
+   * \brief Compute the number of entries and the memory used by the tables of the forwarder
+   *
+   * The cost is linear in the number of PIT and CS entries.
+   * If the MemoryUsagePeriod attribute is set, the result is also reported periodically through
+   * the TableMemoryUsage trace source.
+   */
+  TableMemoryUsage
+  getTableMemoryUsage() const;
+
 public: // Workaround for python bindings
   static Ptr<L3Protocol>
   getL3Protocol(Ptr<Object> node);
@@ -174,6 +217,7 @@ public:
 
   typedef void (*SatisfiedInterestsCallback)(const nfd::pit::Entry& pitEntry, const Face& inFace, const Data& data);
   typedef void (*TimedOutInterestsCallback)(const nfd::pit::Entry& pitEntry);
+  typedef void (*TableMemoryUsageCallback)(const TableMemoryUsage& usage);
 
 protected:
   virtual void
@@ -195,9 +239,15 @@ private:
   void
   initializeManagement();
 
+  void
+  initializeTables();
+
   void
   initializeRibManager();
 
+  void
+  traceMemoryUsage();
+
 private:
   class Impl;
   std::unique_ptr<Impl> m_impl;
@@ -218,6 +268,12 @@ private:
 
   TracedCallback<const nfd::pit::Entry&, const Face&/*in face*/, const Data&> m_satisfiedInterests;
   TracedCallback<const nfd::pit::Entry&> m_timedOutInterests;
+
+  Time m_memoryUsagePeriod; ///< @brief zero if memory usage is not traced
+  EventId m_memoryUsageEvent;
+  TracedCallback<const TableMemoryUsage&> m_tableMemoryUsage;
+
+  friend class L3Tracer; // connects to the trace sources directly, without looking up their names
 };
 
 } // namespace ndn
@@ -29,11 +29,116 @@
 
 #include "ns3/queue.h"
 
+#include <algorithm>
+#include <unordered_map>
+
 NS_LOG_COMPONENT_DEFINE("ndn.NetDeviceTransport");
 
 namespace ns3 {
 namespace ndn {
 
+/**
+ * \brief Bounded FIFO of the Blocks recently sent by any NetDeviceTransport, indexed by the uid
+ *        of the ns3::Packet that carries them
+ *
+ * The cache is emptied by Simulator::Destroy, so that Blocks and packet uids do not leak into
+ * the next simulation run.
+ */
+class SentBlockCache
+{
+public:
+  SentBlockCache()
+    : m_ring(4096)
+    , m_next(0)
+    , m_isClearScheduled(false)
+  {
+  }
+
+  void
+  setCapacity(size_t capacity)
+  {
+    m_index.clear();
+    m_ring.assign(capacity, Entry());
+    m_next = 0;
+  }
+
+  void
+  insert(uint64_t uid, const Block& block)
+  {
+    if (m_ring.empty()) {
+      return;
+    }
+
+    if (!m_isClearScheduled) {
+      Simulator::ScheduleDestroy(&SentBlockCache::clear, this);
+      m_isClearScheduled = true;
+    }
+
+    Entry& slot = m_ring[m_next];
+    if (slot.block.hasWire()) {
+      m_index.erase(slot.uid);
+    }
+    slot.uid = uid;
+    slot.block = block;
+    m_index[uid] = m_next;
+    m_next = (m_next + 1) % m_ring.size();
+  }
+
+  /**
+   * \return the Block sent in \p packet, if it is still cached and has the same bytes as the
+   *         received packet; nullptr otherwise
+   */
+  const Block*
+  find(const ns3::Packet& packet)
+  {
+    auto it = m_index.find(packet.GetUid());
+    if (it == m_index.end()) {
+      return nullptr;
+    }
+    const Block& block = m_ring[it->second].block;
+    if (block.size() != packet.GetSize()) {
+      return nullptr;
+    }
+
+    // lower layers may have changed the packet without changing its uid
+    m_bytes.resize(block.size());
+    packet.CopyData(m_bytes.data(), m_bytes.size());
+    if (!std::equal(m_bytes.begin(), m_bytes.end(), block.begin())) {
+      return nullptr;
+    }
+    return &block;
+  }
+
+  void
+  clear()
+  {
+    m_index.clear();
+    std::fill(m_ring.begin(), m_ring.end(), Entry());
+    m_next = 0;
+    m_isClearScheduled = false;
+  }
+
+private:
+  struct Entry
+  {
+    uint64_t uid = 0;
+    Block block;
+  };
+
+  std::vector<Entry> m_ring;
+  size_t m_next;
+  std::unordered_map<uint64_t, size_t> m_index;
+  std::vector<uint8_t> m_bytes; ///< \brief bytes of the received packet, reused by find()
+  bool m_isClearScheduled;
+};
+
+static SentBlockCache&
+getSentBlockCache()
+{
+  static SentBlockCache cache;
+  return cache;
+}
+
 NetDeviceTransport::NetDeviceTransport(Ptr<Node> node,
                                        const Ptr<NetDevice>& netDevice,
                                        const std::string& localUri,
@@ -109,6 +214,8 @@ NetDeviceTransport::doSend(Packet&& packet)
   Ptr<ns3::Packet> ns3Packet = Create<ns3::Packet>();
   ns3Packet->AddHeader(header);
 
+  getSentBlockCache().insert(ns3Packet->GetUid(), header.getBlock());
+
   // send the NS3 packet
   m_netDevice->Send(ns3Packet, m_netDevice->GetBroadcast(),
                     L3Protocol::ETHERNET_FRAME_TYPE);
@@ -124,15 +231,25 @@ NetDeviceTransport::receiveFromNetDevice(Ptr<NetDevice> device,
 {
   NS_LOG_FUNCTION(device << p << protocol << from << to << packetType);
 
-  // Convert NS3 packet to NFD packet
-  Ptr<ns3::Packet> packet = p->Copy();
+  // Convert NS3 packet to NFD packet, sharing the wire of the sender when it is still known.
+  // Every receiver of a broadcast gets the same wire buffer: the only in-place write into a
+  // received wire, Interest::setHopContext, copies a shared buffer first.
+  const Block* sentBlock = getSentBlockCache().find(*p);
+  if (sentBlock != nullptr) {
+    this->receive(Packet(Block(*sentBlock)));
+    return;
+  }
 
   BlockHeader header;
-  packet->RemoveHeader(header);
+  p->PeekHeader(header);
 
-  auto nfdPacket = Packet(std::move(header.getBlock()));
+  this->receive(Packet(std::move(header.getBlock())));
+}
 
-  this->receive(std::move(nfdPacket));
+void
+NetDeviceTransport::setSentBlockCacheCapacity(size_t capacity)
+{
+  getSentBlockCache().setCapacity(capacity);
 }
 
 Ptr<NetDevice>
@@ -57,6 +57,22 @@ public:
   virtual ssize_t
   getSendQueueLength() final;
 
+  /**
+   * \brief Set how many recently sent Blocks are kept for zero-copy delivery
+   *
+   * Every copy of an ns3::Packet (including the ones delivered by a broadcast channel to each
+   * receiver) carries the uid of the original packet.  NetDeviceTransport remembers the Block
+   * it has sent under this uid, so that the receiving transport can hand the very same Block
+   * (and the ndn-cxx Buffer it owns) to NFD instead of deserializing the packet bytes again.
+   * The Block is used only if its bytes are those of the received packet.  When the Block has
+   * already been evicted, the packet is deserialized as usual.  The remembered Blocks are
+   * released by Simulator::Destroy.
+   *
+   * \param capacity maximum number of remembered Blocks; 0 disables the cache
+   */
+  static void
+  setSentBlockCacheCapacity(size_t capacity);
+
 private:
   virtual void
   doClose() override;
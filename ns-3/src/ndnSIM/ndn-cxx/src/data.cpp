@@ -23,6 +23,8 @@
 #include "encoding/block-helpers.hpp"
 #include "util/sha256.hpp"
 
+#include <cstring>
+
 namespace ndn {
 
 BOOST_CONCEPT_ASSERT((boost::EqualityComparable<Data>));
@@ -32,6 +34,49 @@ BOOST_CONCEPT_ASSERT((WireDecodable<Data>));
 static_assert(std::is_base_of<tlv::Error, Data::Error>::value,
               "Data::Error must inherit from tlv::Error");
 
+static bool g_isSimulatedDigest = false;
+
+/** @brief 64-bit MurmurHash2 (MurmurHash64A) of @p buf, stored in a 32-octet digest buffer
+ */
+static ConstBufferPtr
+computeSimulatedDigest(const uint8_t* buf, size_t size)
+{
+  const uint64_t m = 0xc6a4a7935bd1e995ULL;
+  const int r = 47;
+  uint64_t h = 0x8445d61a4e774912ULL ^ (size * m);
+
+  const uint8_t* end = buf + size / 8 * 8;
+  for (const uint8_t* p = buf; p != end; p += 8) {
+    uint64_t k;
+    std::memcpy(&k, p, sizeof(k));
+    k *= m;
+    k ^= k >> r;
+    k *= m;
+    h ^= k;
+    h *= m;
+  }
+
+  size_t tail = size % 8;
+  if (tail > 0) {
+    uint64_t k = 0;
+    for (size_t i = 0; i < tail; ++i) {
+      k |= static_cast<uint64_t>(end[i]) << (8 * i);
+    }
+    h ^= k;
+    h *= m;
+  }
+
+  h ^= h >> r;
+  h *= m;
+  h ^= h >> r;
+
+  auto digest = make_shared<Buffer>(util::Sha256::DIGEST_SIZE);
+  for (size_t i = 0; i < sizeof(h); ++i) {
+    (*digest)[i] = static_cast<uint8_t>(h >> (8 * (sizeof(h) - 1 - i)));
+  }
+  return digest;
+}
+
 Data::Data(const Name& name)
   : m_name(name)
   , m_content(tlv::Content)
@@ -152,12 +197,29 @@ Data::getFullName() const
       BOOST_THROW_EXCEPTION(Error("Cannot compute full name because Data has no wire encoding (not signed)"));
     }
     m_fullName = m_name;
-    m_fullName.appendImplicitSha256Digest(util::Sha256::computeDigest(m_wire.wire(), m_wire.size()));
+    if (g_isSimulatedDigest) {
+      m_fullName.appendImplicitSha256Digest(computeSimulatedDigest(m_wire.wire(), m_wire.size()));
+    }
+    else {
+      m_fullName.appendImplicitSha256Digest(util::Sha256::computeDigest(m_wire.wire(), m_wire.size()));
+    }
   }
 
   return m_fullName;
 }
 
+void
+Data::setSimulatedDigest(bool isSimulated)
+{
+  g_isSimulatedDigest = isSimulated;
+}
+
+bool
+Data::isSimulatedDigest()
+{
+  return g_isSimulatedDigest;
+}
+
 void
 Data::resetWire()
 {
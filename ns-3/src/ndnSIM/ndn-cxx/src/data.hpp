@@ -114,6 +114,20 @@ public:
   const Name&
   getFullName() const;
 
+  /** @brief Select how getFullName() computes the implicit digest
+   *  @param isSimulated if true, a 64-bit hash of the wire encoding, zero-padded to 32 octets,
+   *                     is used instead of SHA-256
+   *
+   *  The simulated digest is much cheaper to compute, but it is not a SHA-256 digest: full names
+   *  computed this way are only comparable with other simulated full names.
+   *  Select the mode before any full name is computed, because full names are cached.
+   */
+  static void
+  setSimulatedDigest(bool isSimulated);
+
+  static bool
+  isSimulatedDigest();
+
 public: // Data fields
   /** @brief Get name
    */
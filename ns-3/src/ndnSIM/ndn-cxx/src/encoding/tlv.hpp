@@ -108,6 +108,8 @@ enum {
   	InterestVelocityX = 46,
   	InterestVelocityY = 47,
 
+  HopContext = 48,
+
   AppPrivateBlock1 = 128,
   AppPrivateBlock2 = 32767
 };
@@ -23,6 +23,8 @@
 #include "util/random.hpp"
 #include "data.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <cstring>
 #include <sstream>
 
@@ -35,6 +37,17 @@ BOOST_CONCEPT_ASSERT((WireDecodable<Interest>));
 static_assert(std::is_base_of<tlv::Error, Interest::Error>::value,
               "Interest::Error must inherit from tlv::Error");
 
+/** @brief HopContext fields of an Interest whose hop fields were not set
+ */
+static const uint32_t UNSET_HOP_FIELDS[Interest::N_HOP_FIELDS] = {
+  0, // id
+  666600000, // position x: 6666
+  666600000, // position y: 6666
+  666600000, // direction: 6666
+  0, // velocity x
+  0 // velocity y
+};
+
 Interest::Interest(const Name& name, time::milliseconds interestLifetime)
   : m_name(name)
   , m_interestLifetime(interestLifetime)
@@ -42,6 +55,7 @@ Interest::Interest(const Name& name, time::milliseconds interestLifetime)
   if (interestLifetime < time::milliseconds::zero()) {
     BOOST_THROW_EXCEPTION(std::invalid_argument("InterestLifetime must be >= 0"));
   }
+  std::copy(UNSET_HOP_FIELDS, UNSET_HOP_FIELDS + N_HOP_FIELDS, m_hopFields);
 }
 
 Interest::Interest(const Block& wire)
@@ -63,9 +77,15 @@ Interest::wireEncode(EncodingImpl<TAG>& encoder) const
   //                Nonce
   //                InterestLifetime?
   //                ForwardingHint?
+  //                HopContext
 
   // (reverse encoding)
 
+  // HopContext
+  totalLength += encoder.prependByteArrayBlock(tlv::HopContext,
+                                               reinterpret_cast<const uint8_t*>(m_hopFields),
+                                               sizeof(m_hopFields));
+
   // ForwardingHint
   if (m_forwardingHint.size() > 0) {
     totalLength += m_forwardingHint.wireEncode(encoder);
@@ -92,14 +112,6 @@ Interest::wireEncode(EncodingImpl<TAG>& encoder) const
   // Name
   totalLength += getName().wireEncode(encoder);
 
-  // @Tong
-    totalLength += encoder.prependBlock(m_hop_posx);
-    totalLength += encoder.prependBlock(m_hop_posy);
-    totalLength += encoder.prependBlock(m_hop_dir);
-    totalLength += encoder.prependBlock(m_hop_id);
-    totalLength += encoder.prependBlock(m_hop_velocityX);
-    totalLength += encoder.prependBlock(m_hop_velocityY);
-
   totalLength += encoder.prependVarNumber(totalLength);
   totalLength += encoder.prependVarNumber(tlv::Interest);
   return totalLength;
@@ -127,71 +139,97 @@ void
 Interest::wireDecode(const Block& wire)
 {
   m_wire = wire;
-  m_wire.parse();
 
   if (m_wire.type() != tlv::Interest)
     BOOST_THROW_EXCEPTION(Error("Unexpected TLV number when decoding Interest"));
 
-  // Name
-  m_name.wireDecode(m_wire.get(tlv::Name));
-
-  // Selectors
-  Block::element_const_iterator val = m_wire.find(tlv::Selectors);
-  if (val != m_wire.elements_end()) {
-    m_selectors.wireDecode(*val);
-  }
-  else
-    m_selectors = Selectors();
-
-  // Nonce
-  val = m_wire.find(tlv::Nonce);
-  if (val == m_wire.elements_end()) {
-    BOOST_THROW_EXCEPTION(Error("Nonce element is missing"));
-  }
-  uint32_t nonce = 0;
-  if (val->value_size() != sizeof(nonce)) {
-    BOOST_THROW_EXCEPTION(Error("Nonce element is malformed"));
-  }
-  std::memcpy(&nonce, val->value(), sizeof(nonce));
-  m_nonce = nonce;
-
-
-  // Tong
-    val = m_wire.find(tlv::LastHop);
-    if (val != m_wire.elements_end())
-  	  m_hop_id = *val;
-    val = m_wire.find(tlv::PosX);
-    if (val != m_wire.elements_end())
-  	  m_hop_posx = *val;
-    val = m_wire.find(tlv::PosY);
-    if (val != m_wire.elements_end())
-  	  m_hop_posy = *val;
-    val = m_wire.find(tlv::Direction);
-    if (val != m_wire.elements_end())
-  	  m_hop_dir = *val;
-    val = m_wire.find(tlv::InterestVelocityX);
-    if (val != m_wire.elements_end())
-  	  m_hop_velocityX = *val;
-    val = m_wire.find(tlv::InterestVelocityY);
-    if (val != m_wire.elements_end())
-  	  m_hop_velocityY = *val;
+  m_selectors = Selectors();
+  m_interestLifetime = DEFAULT_INTEREST_LIFETIME;
+  m_forwardingHint = DelegationList();
+  m_hopContext = Block();
+  std::copy(UNSET_HOP_FIELDS, UNSET_HOP_FIELDS + N_HOP_FIELDS, m_hopFields);
+
+  // Walk TLV-VALUE once and decode each element as it is found, without parsing m_wire into
+  // sub-elements.  As with Block::find, only the first occurrence of an element is used.
+  bool hasName = false;
+  bool hasSelectors = false;
+  bool hasNonce = false;
+  bool hasInterestLifetime = false;
+  bool hasForwardingHint = false;
+  bool hasHopContext = false;
+
+  Buffer::const_iterator begin = m_wire.value_begin();
+  Buffer::const_iterator end = m_wire.value_end();
+  while (begin != end) {
+    Buffer::const_iterator pos = begin;
+    uint32_t type = tlv::readType(pos, end);
+    uint64_t length = tlv::readVarNumber(pos, end);
+    if (length > static_cast<uint64_t>(end - pos)) {
+      BOOST_THROW_EXCEPTION(Error("TLV-LENGTH of sub-element of type " + to_string(type) +
+                                  " exceeds TLV-VALUE boundary of Interest"));
+    }
+    // pos now points to TLV-VALUE of sub element
+    Buffer::const_iterator subEnd = pos + length;
+
+    switch (type) {
+      case tlv::Name:
+        if (!hasName) {
+          m_name.wireDecode(Block(m_wire.getBuffer(), type, begin, subEnd, pos, subEnd));
+          hasName = true;
+        }
+        break;
+      case tlv::Selectors:
+        if (!hasSelectors) {
+          m_selectors.wireDecode(Block(m_wire.getBuffer(), type, begin, subEnd, pos, subEnd));
+          hasSelectors = true;
+        }
+        break;
+      case tlv::Nonce:
+        if (!hasNonce) {
+          uint32_t nonce = 0;
+          if (length != sizeof(nonce)) {
+            BOOST_THROW_EXCEPTION(Error("Nonce element is malformed"));
+          }
+          std::memcpy(&nonce, &*pos, sizeof(nonce));
+          m_nonce = nonce;
+          hasNonce = true;
+        }
+        break;
+      case tlv::InterestLifetime:
+        if (!hasInterestLifetime) {
+          m_interestLifetime = time::milliseconds(tlv::readNonNegativeInteger(length, pos, subEnd));
+          hasInterestLifetime = true;
+        }
+        break;
+      case tlv::ForwardingHint:
+        if (!hasForwardingHint) {
+          m_forwardingHint.wireDecode(Block(m_wire.getBuffer(), type, begin, subEnd, pos, subEnd),
+                                      false);
+          hasForwardingHint = true;
+        }
+        break;
+      case tlv::HopContext:
+        if (!hasHopContext) {
+          if (length != sizeof(m_hopFields)) {
+            BOOST_THROW_EXCEPTION(Error("HopContext element is malformed"));
+          }
+          m_hopContext = Block(m_wire.getBuffer(), type, begin, subEnd, pos, subEnd);
+          std::memcpy(m_hopFields, &*pos, sizeof(m_hopFields));
+          hasHopContext = true;
+        }
+        break;
+      default:
+        break;
+    }
 
-  // InterestLifetime
-  val = m_wire.find(tlv::InterestLifetime);
-  if (val != m_wire.elements_end()) {
-    m_interestLifetime = time::milliseconds(readNonNegativeInteger(*val));
-  }
-  else {
-    m_interestLifetime = DEFAULT_INTEREST_LIFETIME;
+    begin = subEnd;
   }
 
-  // ForwardingHint
-  val = m_wire.find(tlv::ForwardingHint);
-  if (val != m_wire.elements_end()) {
-    m_forwardingHint.wireDecode(*val, false);
+  if (!hasName) {
+    BOOST_THROW_EXCEPTION(Error("Name element is missing"));
   }
-  else {
-    m_forwardingHint = DelegationList();
+  if (!hasNonce) {
+    BOOST_THROW_EXCEPTION(Error("Nonce element is missing"));
   }
 }
 
@@ -376,265 +414,160 @@ Interest::setForwardingHint(const DelegationList& value)
   return *this;
 }
 
-// @Tong
+// ---- HopContext ----
+
+static uint32_t
+encodeHopCoordinate(double x)
+{
+  return static_cast<uint32_t>(std::floor(x * 100000));
+}
+
+static double
+decodeHopCoordinate(uint32_t value)
+{
+  return value / 100000.0;
+}
+
+static uint32_t
+encodeHopVelocity(double v)
+{
+  // sign and magnitude
+  if (v < 0) {
+    return static_cast<uint32_t>(-v * 1000000) | 0x80000000;
+  }
+  return static_cast<uint32_t>(v * 1000000);
+}
+
+static double
+decodeHopVelocity(uint32_t value)
+{
+  double v = (value & 0x7fffffff) / 1000000.0;
+  return (value & 0x80000000) != 0 ? -v : v;
+}
+
+void
+Interest::updateHopContext(size_t first, size_t count)
+{
+  if (!m_wire.hasWire() || !m_hopContext.hasWire()) {
+    m_wire.reset();
+    return;
+  }
+
+  // The wire buffer may be shared with copies of this Interest, with other Blocks (e.g. the
+  // Name) or with a received link-layer packet, which must keep the old values.  It is owned by
+  // this Interest only if m_wire, m_hopContext and the local pointer are its only owners.
+  ConstBufferPtr buffer = m_wire.getBuffer();
+  if (buffer.use_count() > 3) {
+    size_t hopContextOffset = m_hopContext.begin() - m_wire.begin();
+    buffer = make_shared<Buffer>(m_wire.begin(), m_wire.end());
+    m_wire = Block(buffer);
+
+    Buffer::const_iterator begin = buffer->begin() + hopContextOffset;
+    Buffer::const_iterator end = begin + m_hopContext.size();
+    m_hopContext = Block(buffer, tlv::HopContext, begin, end, end - m_hopContext.value_size(), end);
+  }
+
+  // the HopContext value has fixed size, so it can be overwritten within the existing wire
+  std::memcpy(const_cast<uint8_t*>(m_hopContext.value()) + first * sizeof(uint32_t),
+              m_hopFields + first, count * sizeof(uint32_t));
+}
+
+void
+Interest::setHopField(HopField field, uint32_t value)
+{
+  m_hopFields[field] = value;
+  updateHopContext(field, 1);
+}
+
 Interest&
-Interest::setHopPosx(double x)
-{
-	// * trans double to int
-	uint32_t posX = floor(x*100000);
-	if(m_hop_posx.hasWire() && m_hop_posx.value_size() == sizeof(uint32_t))
-		{
-			std::memcpy(const_cast<uint8_t*>(m_hop_posx.value()),&posX,sizeof(posX));
-		}
-		else
-		{
-			m_hop_posx = makeBinaryBlock(tlv::PosX,
-					reinterpret_cast<const uint8_t*>(&posX),
-					sizeof(posX));
-			m_wire.reset();
-		}
-		return *this;
+Interest::setHopContext(uint32_t id, double posX, double posY, double velocityX, double velocityY)
+{
+  m_hopFields[HOP_ID] = id;
+  m_hopFields[HOP_POS_X] = encodeHopCoordinate(posX);
+  m_hopFields[HOP_POS_Y] = encodeHopCoordinate(posY);
+  m_hopFields[HOP_VELOCITY_X] = encodeHopVelocity(velocityX);
+  m_hopFields[HOP_VELOCITY_Y] = encodeHopVelocity(velocityY);
+  updateHopContext(0, N_HOP_FIELDS);
+  return *this;
 }
 
 double
 Interest::getHopPosx() const
 {
-	uint32_t posX;
-	double x;
-	if(!m_hop_posx.hasWire())
-		const_cast<Interest*>(this)->setHopPosx(6666);
-	if(m_hop_posx.value_size() == sizeof(uint32_t))
-		posX = *reinterpret_cast<const uint32_t*>(m_hop_posx.value());
-	else
-	{
-		posX = readNonNegativeInteger(m_hop_posx);
-	}
-
-	if(posX)
-		x = posX/100000.0;
-	else
-		x = 0.0;
-	return x;
+  return decodeHopCoordinate(m_hopFields[HOP_POS_X]);
 }
 
 Interest&
-Interest::setHopPosy(double x)
-{
-	// * trans double to int
-	uint32_t posY = floor(x*100000);
-	if(m_hop_posy.hasWire() && m_hop_posy.value_size() == sizeof(uint32_t))
-		{
-			std::memcpy(const_cast<uint8_t*>(m_hop_posy.value()),&posY,sizeof(posY));
-		}
-		else
-		{
-			m_hop_posy = makeBinaryBlock(tlv::PosY,
-					reinterpret_cast<const uint8_t*>(&posY),
-					sizeof(posY));
-			m_wire.reset();
-		}
-		return *this;
+Interest::setHopPosx(double posX)
+{
+  setHopField(HOP_POS_X, encodeHopCoordinate(posX));
+  return *this;
 }
 
 double
 Interest::getHopPosy() const
 {
-	uint32_t posY;
-	double y;
-	if(!m_hop_posy.hasWire())
-		const_cast<Interest*>(this)->setHopPosy(6666);
-	if(m_hop_posy.value_size() == sizeof(uint32_t))
-		posY = *reinterpret_cast<const uint32_t*>(m_hop_posy.value());
-	else
-	{
-		posY = readNonNegativeInteger(m_hop_posy);
-	}
-
-	if(posY)
-		y = posY/100000.0;
-	else
-		y = 0.0;
-	return y;
-}
-
-// velocity/////////////////////////////////
+  return decodeHopCoordinate(m_hopFields[HOP_POS_Y]);
+}
+
 Interest&
-Interest::setHopVelocityX(double x)
-{
-	// * trans double to int
-	uint32_t velocityX;
-	if(x < 0){
-		velocityX = (-x)*1000000;
-		velocityX = velocityX | 0x80000000;
-	}else{
-		velocityX = x*1000000;
-	}
-	if(m_hop_velocityX.hasWire() && m_hop_velocityX.value_size() == sizeof(uint32_t))
-		{
-			std::memcpy(const_cast<uint8_t*>(m_hop_velocityX.value()),&velocityX,sizeof(velocityX));
-		}
-		else
-		{
-			m_hop_velocityX = makeBinaryBlock(tlv::InterestVelocityX,
-					reinterpret_cast<const uint8_t*>(&velocityX),
-					sizeof(velocityX));
-			m_wire.reset();
-		}
-		return *this;
+Interest::setHopPosy(double posY)
+{
+  setHopField(HOP_POS_Y, encodeHopCoordinate(posY));
+  return *this;
 }
 
 double
 Interest::getHopVelocityX() const
 {
-	uint32_t velocityX;
-	double y;
-	if(!m_hop_velocityX.hasWire())
-		const_cast<Interest*>(this)->setHopVelocityX(6666);
-	if(m_hop_velocityX.value_size() == sizeof(uint32_t))
-		velocityX = *reinterpret_cast<const uint32_t*>(m_hop_velocityX.value());
-	else
-	{
-		velocityX = readNonNegativeInteger(m_hop_velocityX);
-	}
-
-	if(velocityX){
-		if(velocityX & 0x80000000){
-			y = (velocityX & 0x7fffffff)/1000000.0;
-			y = -y;
-		}else{
-			y = velocityX / 1000000.0;
-		}
-	}else
-		y = 0.0;
-	return y;
+  return decodeHopVelocity(m_hopFields[HOP_VELOCITY_X]);
 }
 
 Interest&
-Interest::setHopVelocityY(double x)
-{
-	// * trans double to int
-	uint32_t velocityY;
-	if(x < 0){
-		velocityY = (-x)*1000000;
-		velocityY = velocityY | 0x80000000;
-	}else{
-		velocityY = x*1000000;
-	}
-	if(m_hop_velocityY.hasWire() && m_hop_velocityY.value_size() == sizeof(uint32_t))
-		{
-			std::memcpy(const_cast<uint8_t*>(m_hop_velocityY.value()),&velocityY,sizeof(velocityY));
-		}
-		else
-		{
-			m_hop_velocityY = makeBinaryBlock(tlv::InterestVelocityY,
-					reinterpret_cast<const uint8_t*>(&velocityY),
-					sizeof(velocityY));
-			m_wire.reset();
-		}
-		return *this;
+Interest::setHopVelocityX(double velocityX)
+{
+  setHopField(HOP_VELOCITY_X, encodeHopVelocity(velocityX));
+  return *this;
 }
 
 double
 Interest::getHopVelocityY() const
 {
-	uint32_t velocityY;
-	double y;
-	if(!m_hop_velocityY.hasWire())
-		const_cast<Interest*>(this)->setHopVelocityY(6666);
-	if(m_hop_velocityY.value_size() == sizeof(uint32_t))
-		velocityY = *reinterpret_cast<const uint32_t*>(m_hop_velocityY.value());
-	else
-	{
-		velocityY = readNonNegativeInteger(m_hop_velocityY);
-	}
-
-	if(velocityY){
-		if(velocityY & 0x80000000){
-			y = (velocityY & 0x7fffffff)/1000000.0;
-			y = -y;
-		}else{
-			y = velocityY / 1000000.0;
-		}
-	}else
-		y = 0.0;
-	return y;
-}
-
-// Direciton/////////////////////////////
+  return decodeHopVelocity(m_hopFields[HOP_VELOCITY_Y]);
+}
+
 Interest&
-Interest::setHopDir(double p_dir)
-{
-	// * trans double to int
-	uint32_t Dir = floor(p_dir*100000);
-	if(m_hop_dir.hasWire() && m_hop_dir.value_size() == sizeof(uint32_t))
-		{
-			std::memcpy(const_cast<uint8_t*>(m_hop_dir.value()),&Dir,sizeof(Dir));
-		}
-		else
-		{
-			m_hop_dir = makeBinaryBlock(tlv::Direction,
-					reinterpret_cast<const uint8_t*>(&Dir),
-					sizeof(Dir));
-			m_wire.reset();
-		}
-		return *this;
+Interest::setHopVelocityY(double velocityY)
+{
+  setHopField(HOP_VELOCITY_Y, encodeHopVelocity(velocityY));
+  return *this;
 }
 
 double
 Interest::getHopDir() const
 {
-	uint32_t dir;
-	double d;
-	if(!m_hop_dir.hasWire())
-		const_cast<Interest*>(this)->setHopDir(6666);
-	if(m_hop_dir.value_size() == sizeof(uint32_t))
-		dir = *reinterpret_cast<const uint32_t*>(m_hop_dir.value());
-	else
-	{
-		dir = readNonNegativeInteger(m_hop_dir);
-	}
-
-	if(dir)
-		d = dir/100000.0;
-	else
-		d = 0.0;
-	return d;
-}
-
-// ID/////////////////////////////////
+  return decodeHopCoordinate(m_hopFields[HOP_DIR]);
+}
+
 Interest&
-Interest::setHopId(uint32_t p_id)
-{
-	if(m_hop_id.hasWire() && m_hop_id.value_size() == sizeof(uint32_t))
-	{
-		std::memcpy(const_cast<uint8_t*>(m_hop_id.value()),&p_id,sizeof(p_id));
-	}
-	else
-	{
-		m_hop_id = makeBinaryBlock(tlv::LastHop,
-				reinterpret_cast<const uint8_t*>(&p_id),
-				sizeof(p_id));
-		m_wire.reset();
-	}
-	return *this;
+Interest::setHopDir(double dir)
+{
+  setHopField(HOP_DIR, encodeHopCoordinate(dir));
+  return *this;
 }
 
 uint32_t
 Interest::getHopId() const
 {
-	uint32_t hopId;
-	if(!m_hop_id.hasWire())
-		const_cast<Interest*>(this)->setHopId(random::generateWord32());
-	if(m_hop_id.value_size() == sizeof(uint32_t))
-		hopId = *reinterpret_cast<const uint32_t*>(m_hop_id.value());
-	else
-	{
-		hopId = readNonNegativeInteger(m_hop_id);
-	}
-
-	return hopId;
+  return m_hopFields[HOP_ID];
 }
 
+Interest&
+Interest::setHopId(uint32_t id)
+{
+  setHopField(HOP_ID, id);
+  return *this;
+}
 
 // ---- operators ----
 
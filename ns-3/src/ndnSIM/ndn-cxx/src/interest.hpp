@@ -220,6 +220,89 @@ public: // Name, Nonce, and Guiders
     return *this;
   }
 
+public: // HopContext
+  /** @brief fields of the HopContext element, in wire order
+   *
+   *  The HopContext element carries the state of the last forwarding node as fixed-size 32-bit
+   *  values.  It is encoded in every Interest, so that a forwarder can overwrite the fields of an
+   *  encoded Interest in place instead of encoding the whole Interest again.
+   */
+  enum HopField {
+    HOP_ID,
+    HOP_POS_X,
+    HOP_POS_Y,
+    HOP_DIR,
+    HOP_VELOCITY_X,
+    HOP_VELOCITY_Y,
+    N_HOP_FIELDS
+  };
+
+  /** @brief Set the fields of the HopContext element, except direction
+   *
+   *  If the Interest is encoded, the values are written into its wire encoding with one memcpy.
+   *  The wire encoding is copied first if it is shared with another Interest or Block, so that
+   *  they keep the previous values.
+   */
+  Interest&
+  setHopContext(uint32_t id, double posX, double posY, double velocityX, double velocityY);
+
+  /** @return position of the last hop, 6666 if unset
+   */
+  double
+  getHopPosx() const;
+
+  Interest&
+  setHopPosx(double posX);
+
+  double
+  getHopPosy() const;
+
+  Interest&
+  setHopPosy(double posY);
+
+  /** @return velocity of the last hop, 0 if unset
+   */
+  double
+  getHopVelocityX() const;
+
+  Interest&
+  setHopVelocityX(double velocityX);
+
+  double
+  getHopVelocityY() const;
+
+  Interest&
+  setHopVelocityY(double velocityY);
+
+  /** @return direction of the last hop, 6666 if unset
+   */
+  double
+  getHopDir() const;
+
+  Interest&
+  setHopDir(double dir);
+
+  /** @return id of the last hop, 0 if unset
+   */
+  uint32_t
+  getHopId() const;
+
+  Interest&
+  setHopId(uint32_t id);
+
+private:
+  /** @brief update one HopContext field, in the wire encoding if possible
+   */
+  void
+  setHopField(HopField field, uint32_t value);
+
+  /** @brief write HopContext fields into the wire encoding, or reset the wire if not possible
+   *
+   *  A shared wire encoding is copied before it is written.
+   */
+  void
+  updateHopContext(size_t first, size_t count);
+
 public: // Selectors
   /**
    * @return true if Interest has any selector present
@@ -337,56 +420,12 @@ private:
 
   mutable Block m_wire;
 
-  /**
-   * Tong
+  /** @brief HopContext element, sub-block of m_wire
+   *
+   *  Empty if m_wire does not contain a HopContext element.
    */
-	mutable Block m_hop_posx;
-	mutable Block m_hop_posy;
-	mutable Block m_hop_dir;
-	mutable Block m_hop_id;// for test
-	mutable Block m_hop_velocityX;
-	mutable Block m_hop_velocityY;
-
-public:
-	// Position/////////////////////
-	double
-	getHopPosx() const;
-
-	Interest&
-	setHopPosx(double);
-
-	double
-	getHopPosy() const;
-
-	Interest&
-	setHopPosy(double);
-
-	// Velocity/////////////////////
-	double
-	getHopVelocityX() const;
-
-	Interest&
-	setHopVelocityX(double);
-
-	double
-	getHopVelocityY() const;
-
-	Interest&
-	setHopVelocityY(double);
-
-	// Direction/////////////////////
-	double
-	getHopDir() const;
-
-	Interest&
-	setHopDir(double);
-
-	// ID/////////////////////
-	uint32_t
-	getHopId() const;
-
-	Interest&
-	setHopId(uint32_t);
+  mutable Block m_hopContext;
+  uint32_t m_hopFields[N_HOP_FIELDS]; ///< HopContext values as encoded
 };
 
 NDN_CXX_DECLARE_WIRE_ENCODE_INSTANTIATIONS(Interest);
@@ -168,6 +168,7 @@ Name::wireDecode(const Block& wire)
 
   m_wire = wire;
   m_wire.parse();
+  m_prefixHashes.reset();
 }
 
 Name
@@ -256,6 +256,7 @@ public: // modifiers
   append(const Component& component)
   {
     m_wire.push_back(component);
+    m_prefixHashes.reset();
     return *this;
   }
 
@@ -311,6 +312,7 @@ public: // modifiers
     else {
       m_wire.push_back(Block(tlv::NameComponent, value));
     }
+    m_prefixHashes.reset();
 
     return *this;
   }
@@ -450,6 +452,7 @@ public: // modifiers
   clear()
   {
     m_wire = Block(tlv::Name);
+    m_prefixHashes.reset();
   }
 
 public: // algorithms
@@ -531,6 +534,30 @@ public: // algorithms
   compare(size_t pos1, size_t count1,
           const Name& other, size_t pos2 = 0, size_t count2 = npos) const;
 
+public: // hash cache
+  /** @brief Get the per-prefix hash values cached in this name
+   *  @return the values stored by setPrefixHashes, or nullptr if none were stored or the name
+   *          has been modified since
+   *
+   *  The cache lets a forwarder hash the components of a packet name once, and reuse the result
+   *  in every table lookup of that packet. The meaning of the values is defined by the caller.
+   *  Copies of a name share its cache until either of them is modified.
+   */
+  const std::vector<size_t>*
+  getPrefixHashes() const
+  {
+    return m_prefixHashes.get();
+  }
+
+  /** @brief Cache per-prefix hash values in this name
+   *  @sa getPrefixHashes
+   */
+  void
+  setPrefixHashes(std::vector<size_t> hashes) const
+  {
+    m_prefixHashes = make_shared<const std::vector<size_t>>(std::move(hashes));
+  }
+
 public:
   /** @brief indicates "until the end" in getSubName and compare
    */
@@ -538,6 +565,7 @@ public:
 
 private:
   mutable Block m_wire;
+  mutable shared_ptr<const std::vector<size_t>> m_prefixHashes;
 };
 
 NDN_CXX_DECLARE_WIRE_ENCODE_INSTANTIATIONS(Name);
@@ -22,32 +22,86 @@
 #include "scheduler.hpp"
 #include "detail/steady-timer.hpp"
 
-#include <boost/scope_exit.hpp>
+namespace ndn {
+namespace util {
+namespace scheduler {
+namespace detail {
 
-namespace ns3 {
+/** \brief head of the list of released EventInfo blocks
+ *
+ *  A plain pointer (rather than a container) so that blocks released during static destruction
+ *  can still be recycled.  The simulator is single-threaded.
+ */
+static void* g_freeEventInfos = nullptr;
 
-/// @cond include_hidden
+static size_t g_nEventInfos = 0; ///< number of EventInfo instances
+static size_t g_nEventInfoBlocks = 0; ///< number of blocks obtained from the system
 
-template<>
-struct EventMemberImplObjTraits<std::function<void()>> {
-  typedef std::function<void()> T;
-  static T&
-  GetReference(T& p)
-  {
-    return p;
+void*
+EventInfo::operator new(size_t size)
+{
+  BOOST_ASSERT(size == sizeof(EventInfo));
+  ++g_nEventInfos;
+  if (g_freeEventInfos == nullptr) {
+    ++g_nEventInfoBlocks;
+    return ::operator new(size);
   }
-};
+  void* p = g_freeEventInfos;
+  g_freeEventInfos = *static_cast<void**>(p);
+  return p;
+}
+
+void
+EventInfo::operator delete(void* p) noexcept
+{
+  --g_nEventInfos;
+  *static_cast<void**>(p) = g_freeEventInfos;
+  g_freeEventInfos = p;
+}
 
-/// @endcond
+EventInfo::EventInfo(Scheduler& scheduler, const EventCallback& callback)
+  : m_scheduler(&scheduler)
+  , m_callback(callback)
+  , m_prev(nullptr)
+  , m_next(nullptr)
+{
+}
 
-} // namespace ns3
+EventInfo::~EventInfo()
+{
+  if (m_scheduler != nullptr) {
+    m_scheduler->unlink(*this);
+  }
+}
 
-namespace ndn {
-namespace util {
-namespace scheduler {
+void
+EventInfo::cancel()
+{
+  if (m_scheduler == nullptr) {
+    return;
+  }
+  m_scheduler->unlink(*this);
+  m_scheduler = nullptr;
+  m_callback = nullptr;
+  Cancel();
+}
+
+void
+EventInfo::Notify()
+{
+  m_scheduler->unlink(*this);
+  m_scheduler = nullptr;
+
+  // the callback may schedule or cancel other events, and EventId is already expired
+  EventCallback callback = std::move(m_callback);
+  m_callback = nullptr;
+  callback();
+}
+
+} // namespace detail
 
 Scheduler::Scheduler(boost::asio::io_service& ioService)
-  : m_scheduledEvent(m_events.end())
+  : m_events(nullptr)
 {
 }
 
@@ -59,47 +113,64 @@ Scheduler::~Scheduler()
 EventId
 Scheduler::scheduleEvent(const time::nanoseconds& after, const Event& event)
 {
-  EventId eventId = std::make_shared<ns3::EventId>();
-  weak_ptr<ns3::EventId> eventWeak = eventId;
-  std::function<void()> eventWithCleanup = [this, event, eventWeak] () {
-    event();
-    shared_ptr<ns3::EventId> eventId = eventWeak.lock();
-    if (eventId != nullptr) {
-      this->m_events.erase(eventId); // remove the event from the set after it is executed
-    }
-  };
-
-  ns3::EventId id = ns3::Simulator::Schedule(ns3::NanoSeconds(after.count()),
-                                             &std::function<void()>::operator(), eventWithCleanup);
-  *eventId = std::move(id);
-  m_events.insert(eventId);
-
-  return eventId;
+  ns3::Ptr<detail::EventInfo> info(new detail::EventInfo(*this, event), false);
+  ns3::Simulator::Schedule(ns3::NanoSeconds(after.count()), info);
+  link(*info);
+  return EventId(std::move(info));
 }
 
 void
 Scheduler::cancelEvent(const EventId& eventId)
 {
-  if (eventId != nullptr) {
-    ns3::Simulator::Remove(*eventId);
-    m_events.erase(eventId);
-    const_cast<EventId&>(eventId).reset();
+  if (eventId) {
+    eventId.m_info->cancel();
   }
 }
 
+size_t
+Scheduler::getNAllocatedEvents()
+{
+  return detail::g_nEventInfos;
+}
+
+size_t
+Scheduler::getAllocatedEventBytes()
+{
+  return detail::g_nEventInfoBlocks * sizeof(detail::EventInfo);
+}
+
 void
 Scheduler::cancelAllEvents()
 {
-  for (auto i = m_events.begin(); i != m_events.end(); ) {
-    auto next = i;
-    ++next; // ns3::Simulator::Remove can call cancelEvent
-    if ((*i) != nullptr) {
-      ns3::Simulator::Remove((**i));
-      const_cast<EventId&>(*i).reset();
-    }
-    i = next;
+  while (m_events != nullptr) {
+    m_events->cancel();
+  }
+}
+
+void
+Scheduler::link(detail::EventInfo& info)
+{
+  info.m_prev = nullptr;
+  info.m_next = m_events;
+  if (m_events != nullptr) {
+    m_events->m_prev = &info;
+  }
+  m_events = &info;
+}
+
+void
+Scheduler::unlink(detail::EventInfo& info)
+{
+  if (info.m_prev != nullptr) {
+    info.m_prev->m_next = info.m_next;
+  }
+  else {
+    m_events = info.m_next;
+  }
+  if (info.m_next != nullptr) {
+    info.m_next->m_prev = info.m_prev;
   }
-  m_events.clear();
+  info.m_prev = info.m_next = nullptr;
 }
 
 } // namespace scheduler
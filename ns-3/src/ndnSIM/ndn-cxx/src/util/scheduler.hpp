@@ -29,10 +29,10 @@
 #include "../common.hpp"
 
 #include "ns3/simulator.h"
+#include "ns3/event-impl.h"
+#include "ns3/ptr.h"
 
-#include <set>
 #include <boost/asio/io_service.hpp>
-#include <set>
 
 namespace ndn {
 namespace util {
@@ -43,15 +43,130 @@ class SteadyTimer;
 
 namespace scheduler {
 
+class Scheduler;
+
 typedef function<void()> EventCallback;
 
-/** \class EventId
- *  \brief Opaque type (shared_ptr) representing ID of a scheduled event
+namespace detail {
+
+/** \brief Stores internal information about a scheduled event
+ *
+ *  EventInfo is the ns-3 event itself: the simulator queue and every EventId share it through its
+ *  intrusive reference count.  Cancelling an event only marks it cancelled (O(1)), the simulator
+ *  drops it when its time comes.  Released instances are recycled through a free list.
+ */
+class EventInfo final : public ns3::EventImpl
+{
+public:
+  EventInfo(Scheduler& scheduler, const EventCallback& callback);
+
+  /** \brief unlink the event from its Scheduler, if it is released while still pending
+   *
+   *  This happens when ns3::Simulator::Destroy drops the events in the simulator queue.
+   */
+  ~EventInfo() final;
+
+  /** \return whether the event has been executed or cancelled
+   */
+  bool
+  isExpired() const
+  {
+    return m_scheduler == nullptr;
+  }
+
+  /** \brief prevent the event from being executed
+   */
+  void
+  cancel();
+
+  static void*
+  operator new(size_t size);
+
+  static void
+  operator delete(void* p) noexcept;
+
+private:
+  void
+  Notify() final;
+
+private:
+  Scheduler* m_scheduler; ///< nullptr once the event has expired
+  EventCallback m_callback;
+
+  // list of pending events of m_scheduler
+  EventInfo* m_prev;
+  EventInfo* m_next;
+
+  friend class scheduler::Scheduler;
+};
+
+} // namespace detail
+
+/** \brief Identifies a scheduled event
+ *
+ *  An EventId evaluates to false if it was default-constructed, or after the event has been
+ *  executed or cancelled.  All such EventIds compare equal.
  */
-typedef std::shared_ptr<ns3::EventId> EventId;
+class EventId
+{
+public:
+  EventId() = default;
+
+  EventId(std::nullptr_t)
+  {
+  }
+
+  explicit
+  operator bool() const
+  {
+    return m_info != nullptr && !m_info->isExpired();
+  }
+
+  /** \brief clear this EventId
+   *  \note The event itself is not cancelled.
+   */
+  void
+  reset() noexcept
+  {
+    m_info = nullptr;
+  }
+
+  friend bool
+  operator==(const EventId& lhs, const EventId& rhs)
+  {
+    return (!lhs && !rhs) || lhs.m_info == rhs.m_info;
+  }
+
+  friend bool
+  operator!=(const EventId& lhs, const EventId& rhs)
+  {
+    return !(lhs == rhs);
+  }
+
+  friend std::ostream&
+  operator<<(std::ostream& os, const EventId& eventId)
+  {
+    return os << static_cast<const void*>(ns3::PeekPointer(eventId.m_info));
+  }
+
+private:
+  explicit
+  EventId(ns3::Ptr<detail::EventInfo> info)
+    : m_info(std::move(info))
+  {
+  }
+
+private:
+  ns3::Ptr<detail::EventInfo> m_info;
+
+  friend class Scheduler;
+};
 
 /**
  * \brief Generic scheduler
+ *
+ * Events are scheduled directly in the ns-3 simulator.  The scheduler only keeps an intrusive
+ * list of its pending events, for cancelAllEvents().
  */
 class Scheduler : noncopyable
 {
@@ -85,37 +200,35 @@ public:
   void
   cancelAllEvents();
 
-private:
-  struct EventInfo
-  {
-    EventInfo(const time::nanoseconds& after, const Event& event);
-
-    EventInfo(const time::steady_clock::TimePoint& when, const EventInfo& previousEvent);
-
-    bool
-    operator <=(const EventInfo& other) const
-    {
-      return this->m_scheduledTime <= other.m_scheduledTime;
-    }
+public: // memory accounting
+  /**
+   * \brief Get the number of events of all schedulers that are still allocated
+   *
+   * This includes executed and cancelled events that are still referenced by the ns-3 event
+   * queue or by an EventId.
+   */
+  static size_t
+  getNAllocatedEvents();
 
-    bool
-    operator <(const EventInfo& other) const
-    {
-      return this->m_scheduledTime < other.m_scheduledTime;
-    }
+  /**
+   * \brief Get the number of bytes obtained from the system for events of all schedulers
+   *
+   * This includes released events kept for reuse, but not the memory allocated by the callbacks.
+   */
+  static size_t
+  getAllocatedEventBytes();
 
-    time::nanoseconds
-    expiresFromNow() const;
+private:
+  void
+  link(detail::EventInfo& info);
 
-    time::steady_clock::TimePoint m_scheduledTime;
-    Event m_event;
-    mutable EventId m_eventId;
-  };
+  void
+  unlink(detail::EventInfo& info);
 
-  typedef std::multiset<EventId> EventQueue;
+private:
+  detail::EventInfo* m_events; ///< head of the list of pending events
 
-  EventQueue m_events;
-  EventQueue::iterator m_scheduledEvent;
+  friend class detail::EventInfo;
 };
 
 } // namespace scheduler
@@ -0,0 +1,92 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MAIN 1
+#define BOOST_TEST_DYN_LINK 1
+#define BOOST_TEST_MODULE ndn-cxx Interest Benchmark
+
+#include "interest.hpp"
+
+#include "boost-test.hpp"
+#include "timed-execute.hpp"
+
+#include <iostream>
+
+namespace ndn {
+namespace tests {
+
+static Interest
+makeHopInterest()
+{
+  Interest interest("/vanet/benchmark/road/42/segment/7");
+  interest.setNonce(0x2a2a2a2a);
+  interest.setInterestLifetime(2_s);
+  interest.setHopContext(17, 120.5, -33.25, 14.0, -2.5);
+  return interest;
+}
+
+// Benchmark of Interest encoding and decoding, as done on every hop of a multi-hop
+// broadcast: the forwarder decodes the Interest, updates its HopContext, and re-encodes it.
+// Run this benchmark with:
+//    ./interest-benchmark
+// For accurate results, it is required to compile ndn-cxx in release mode.
+BOOST_AUTO_TEST_CASE(EncodeDecode)
+{
+  const int N_ITERATIONS = 1000000;
+
+  const Interest prototype = makeHopInterest(); // never encoded, so copies are encoded from scratch
+  const Block wire = Interest(prototype).wireEncode();
+
+  int nCorrects = 0;
+  auto dDecode = timedExecute([&] {
+    for (int i = 0; i < N_ITERATIONS; ++i) {
+      Interest decoded(wire);
+      nCorrects += decoded.getHopId() == 17;
+    }
+  });
+  BOOST_CHECK_EQUAL(nCorrects, N_ITERATIONS);
+
+  size_t totalSize = 0;
+  auto dEncode = timedExecute([&] {
+    for (int i = 0; i < N_ITERATIONS; ++i) {
+      Interest encoded(prototype);
+      totalSize += encoded.wireEncode().size();
+    }
+  });
+  BOOST_CHECK_EQUAL(totalSize, wire.size() * N_ITERATIONS);
+
+  nCorrects = 0;
+  auto dHop = timedExecute([&] {
+    for (int i = 0; i < N_ITERATIONS; ++i) {
+      Interest forwarded(Block(wire.wire(), wire.size())); // a fresh copy, as received from a face
+      forwarded.setHopContext(18, 130.5, -30.25, 14.0, -2.5);
+      nCorrects += forwarded.wireEncode().size() == wire.size();
+    }
+  });
+  BOOST_CHECK_EQUAL(nCorrects, N_ITERATIONS);
+
+  std::cout << "decode " << N_ITERATIONS << " Interests: " << dDecode << std::endl;
+  std::cout << "encode " << N_ITERATIONS << " Interests: " << dEncode << std::endl;
+  std::cout << "decode-update-encode " << N_ITERATIONS << " Interests: " << dHop << std::endl;
+}
+
+} // namespace tests
+} // namespace ndn
@@ -62,6 +62,41 @@ BOOST_AUTO_TEST_CASE(ScheduleCancel)
   std::cout << "cancel " << nEvents << " events: " << d2 << std::endl;
 }
 
+BOOST_AUTO_TEST_CASE(CancelReschedule)
+{
+  boost::asio::io_service io;
+  Scheduler sched(io);
+
+  // NFD uses PIT and face timers this way: most are cancelled and rescheduled long before
+  // they expire
+  const size_t nPending = 10000;
+  const size_t nPairs = 1000000;
+  size_t nExpired = 0;
+  std::vector<EventId> eventIds(nPending);
+  for (size_t i = 0; i < nPending; ++i) {
+    eventIds[i] = sched.scheduleEvent(4_s, [&] { ++nExpired; });
+  }
+
+  auto d1 = timedExecute([&] {
+    for (size_t i = 0; i < nPairs; ++i) {
+      EventId& eventId = eventIds[i % nPending];
+      sched.cancelEvent(eventId);
+      eventId = sched.scheduleEvent(4_s, [&] { ++nExpired; });
+    }
+  });
+
+  // cancelled events stay in the simulator queue until they expire
+  auto d2 = timedExecute([&] {
+    ns3::Simulator::Run();
+  });
+  ns3::Simulator::Destroy();
+
+  BOOST_REQUIRE_EQUAL(nExpired, nPending);
+  std::cout << "cancel and reschedule " << nPairs << " events with " << nPending
+            << " pending: " << d1 << std::endl;
+  std::cout << "run simulator: " << d2 << std::endl;
+}
+
 BOOST_AUTO_TEST_CASE(Execute)
 {
   boost::asio::io_service io;
@@ -34,6 +34,8 @@
 #include "identity-management-fixture.hpp"
 #include <boost/lexical_cast.hpp>
 
+#include <algorithm>
+
 namespace ndn {
 namespace tests {
 
@@ -254,6 +256,26 @@ BOOST_FIXTURE_TEST_CASE(FullName, IdentityManagementFixture)
     "sha256digest=28bad4b5275bd392dbb670c75cf0b66f13f7942b21e80f55c0e86b374753a548");
 }
 
+BOOST_AUTO_TEST_CASE(SimulatedDigest)
+{
+  Data d1(Block(DATA1, sizeof(DATA1)));
+  Data d2(Block(DATA1, sizeof(DATA1)));
+
+  BOOST_CHECK_EQUAL(Data::isSimulatedDigest(), false);
+  Data::setSimulatedDigest(true);
+  Name fullName = d1.getFullName();
+  Data::setSimulatedDigest(false);
+
+  BOOST_CHECK_EQUAL(fullName.getPrefix(-1), d1.getName());
+  BOOST_REQUIRE(fullName.get(-1).isImplicitSha256Digest());
+  BOOST_CHECK_EQUAL(fullName.get(-1).value_size(), util::Sha256::DIGEST_SIZE);
+  BOOST_CHECK_NE(fullName, d2.getFullName());
+
+  const uint8_t* digest = fullName.get(-1).value();
+  BOOST_CHECK(std::all_of(digest + 8, digest + util::Sha256::DIGEST_SIZE,
+                          [] (uint8_t b) { return b == 0; }));
+}
+
 // ---- operators ----
 
 BOOST_AUTO_TEST_CASE(Equality)
@@ -46,13 +46,20 @@ BOOST_AUTO_TEST_CASE(DefaultConstructor)
 BOOST_AUTO_TEST_CASE(EncodeDecodeBasic)
 {
   const uint8_t WIRE[] = {
-    0x05, 0x1c, // Interest
+    0x05, 0x36, // Interest
           0x07, 0x14, // Name
                 0x08, 0x05, 0x6c, 0x6f, 0x63, 0x61, 0x6c, // NameComponent
                 0x08, 0x03, 0x6e, 0x64, 0x6e, // NameComponent
                 0x08, 0x06, 0x70, 0x72, 0x65, 0x66, 0x69, 0x78, // NameComponent
           0x0a, 0x04, // Nonce
-                0x01, 0x00, 0x00, 0x00
+                0x01, 0x00, 0x00, 0x00,
+          0x30, 0x18, // HopContext (unset)
+                0x00, 0x00, 0x00, 0x00,
+                0x40, 0x82, 0xbb, 0x27,
+                0x40, 0x82, 0xbb, 0x27,
+                0x40, 0x82, 0xbb, 0x27,
+                0x00, 0x00, 0x00, 0x00,
+                0x00, 0x00, 0x00, 0x00
   };
 
   Interest i1("/local/ndn/prefix");
@@ -72,7 +79,7 @@ BOOST_AUTO_TEST_CASE(EncodeDecodeBasic)
 BOOST_AUTO_TEST_CASE(EncodeDecodeFull)
 {
   const uint8_t WIRE[] = {
-    0x05, 0x31, // Interest
+    0x05, 0x4b, // Interest
           0x07, 0x14, // Name
                 0x08, 0x05, 0x6c, 0x6f, 0x63, 0x61, 0x6c, // NameComponent
                 0x08, 0x03, 0x6e, 0x64, 0x6e, // NameComponent
@@ -86,7 +93,14 @@ BOOST_AUTO_TEST_CASE(EncodeDecodeFull)
           0x1e, 0x0a, // ForwardingHint
                 0x1f, 0x08, // Delegation
                       0x1e, 0x01, 0x01, // Preference=1
-                      0x07, 0x03, 0x08, 0x01, 0x41 // Name=/A
+                      0x07, 0x03, 0x08, 0x01, 0x41, // Name=/A
+          0x30, 0x18, // HopContext
+                0x07, 0x00, 0x00, 0x00, // id=7
+                0x90, 0x05, 0x10, 0x00, // posX=10.5
+                0x28, 0xe6, 0x1e, 0x00, // posY=20.25
+                0x40, 0x82, 0xbb, 0x27, // direction (unset)
+                0xe0, 0x67, 0x35, 0x80, // velocityX=-3.5
+                0x80, 0x84, 0x1e, 0x00 // velocityY=2
   };
 
   Interest i1;
@@ -95,6 +109,7 @@ BOOST_AUTO_TEST_CASE(EncodeDecodeFull)
   i1.setNonce(1);
   i1.setInterestLifetime(1000_ms);
   i1.setForwardingHint({{1, "/A"}});
+  i1.setHopContext(7, 10.5, 20.25, -3.5, 2);
   Block wire1 = i1.wireEncode();
   BOOST_CHECK_EQUAL_COLLECTIONS(wire1.begin(), wire1.end(), WIRE, WIRE + sizeof(WIRE));
 
@@ -104,6 +119,11 @@ BOOST_AUTO_TEST_CASE(EncodeDecodeFull)
   BOOST_CHECK_EQUAL(i2.getNonce(), 1);
   BOOST_CHECK_EQUAL(i2.getInterestLifetime(), 1000_ms);
   BOOST_CHECK_EQUAL(i2.getForwardingHint(), DelegationList({{1, "/A"}}));
+  BOOST_CHECK_EQUAL(i2.getHopId(), 7);
+  BOOST_CHECK_EQUAL(i2.getHopPosx(), 10.5);
+  BOOST_CHECK_EQUAL(i2.getHopPosy(), 20.25);
+  BOOST_CHECK_EQUAL(i2.getHopVelocityX(), -3.5);
+  BOOST_CHECK_EQUAL(i2.getHopVelocityY(), 2);
 
   BOOST_CHECK_EQUAL(i1, i2);
 }
@@ -160,6 +180,38 @@ BOOST_AUTO_TEST_CASE(DecodeBadNonce)
   BOOST_CHECK_THROW(i.wireDecode(b), tlv::Error);
 }
 
+BOOST_AUTO_TEST_CASE(DecodeDuplicateElements) // first occurrence is used, as with Block::find
+{
+  Block b(tlv::Interest);
+  b.push_back(Name("/first").wireEncode());
+  b.push_back(makeBinaryBlock(tlv::Nonce, "\x01\x00\x00\x00", 4));
+  b.push_back(makeNonNegativeIntegerBlock(tlv::InterestLifetime, 1000));
+  b.push_back(Name("/second").wireEncode());
+  b.push_back(makeBinaryBlock(tlv::Nonce, "\x02\x00\x00\x00", 4));
+  b.push_back(makeNonNegativeIntegerBlock(tlv::InterestLifetime, 2000));
+  b.encode();
+
+  Interest i(b);
+  BOOST_CHECK_EQUAL(i.getName(), "/first");
+  BOOST_CHECK_EQUAL(i.getNonce(), 1);
+  BOOST_CHECK_EQUAL(i.getInterestLifetime(), 1_s);
+}
+
+BOOST_AUTO_TEST_CASE(DecodeTruncatedElement)
+{
+  const uint8_t WIRE[] = {
+    0x05, 0x0d, // Interest
+          0x07, 0x03, // Name
+                0x08, 0x01, 0x41, // NameComponent
+          0x0a, 0x04, // Nonce
+                0x01, 0x00, 0x00, 0x00,
+          0x0c, 0x02 // InterestLifetime, TLV-VALUE exceeds the Interest
+  };
+
+  Interest i;
+  BOOST_CHECK_THROW(i.wireDecode(Block(WIRE, sizeof(WIRE))), tlv::Error);
+}
+
 // ---- matching ----
 
 BOOST_AUTO_TEST_CASE(MatchesData)
@@ -359,6 +411,70 @@ BOOST_AUTO_TEST_CASE(ModifyForwardingHint)
   BOOST_CHECK_EQUAL(i.getForwardingHint(), DelegationList({{1, "/A"}, {2, "/B"}}));
 }
 
+BOOST_AUTO_TEST_CASE(SetHopContext)
+{
+  Interest i("/A");
+  BOOST_CHECK_EQUAL(i.getHopId(), 0);
+  BOOST_CHECK_EQUAL(i.getHopPosx(), 6666);
+  BOOST_CHECK_EQUAL(i.getHopVelocityX(), 0);
+
+  // fields of an encoded Interest are overwritten in place, once its wire is not shared
+  i.wireEncode();
+  i.setHopContext(1, 2.5, 3, 4, -5);
+  const Block& wire = i.wireEncode();
+  const uint8_t* buffer = wire.wire();
+  size_t size = wire.size();
+  i.setHopDir(90);
+  BOOST_CHECK_EQUAL(i.wireEncode().wire(), buffer);
+  BOOST_CHECK_EQUAL(i.wireEncode().size(), size);
+
+  Interest decoded(i.wireEncode());
+  BOOST_CHECK_EQUAL(decoded.getHopId(), 1);
+  BOOST_CHECK_EQUAL(decoded.getHopPosx(), 2.5);
+  BOOST_CHECK_EQUAL(decoded.getHopPosy(), 3);
+  BOOST_CHECK_EQUAL(decoded.getHopVelocityX(), 4);
+  BOOST_CHECK_EQUAL(decoded.getHopVelocityY(), -5);
+  BOOST_CHECK_EQUAL(decoded.getHopDir(), 90);
+
+  // an Interest decoded without HopContext is encoded again
+  const uint8_t WIRE[] = {
+    0x05, 0x0b, // Interest
+          0x07, 0x03, // Name
+                0x08, 0x01, 0x41, // NameComponent
+          0x0a, 0x04, // Nonce
+                0x01, 0x00, 0x00, 0x00
+  };
+  Interest noContext(Block(WIRE, sizeof(WIRE)));
+  BOOST_CHECK_EQUAL(noContext.getHopPosx(), 6666);
+  noContext.setHopId(2);
+  BOOST_CHECK_EQUAL(Interest(noContext.wireEncode()).getHopId(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(SetHopContextShared)
+{
+  Interest i("/A");
+  i.setHopContext(1, 2.5, 3, 4, -5);
+  Block wire = i.wireEncode();
+  Interest copy(i);
+  Interest decoded(wire);
+
+  i.setHopContext(6, 7, 8, 9, 10);
+  BOOST_CHECK_EQUAL(Interest(i.wireEncode()).getHopId(), 6);
+  BOOST_CHECK_EQUAL(Interest(i.wireEncode()).getHopPosx(), 7);
+
+  // a copy, and Interests or Blocks sharing the wire, keep the previous values
+  BOOST_CHECK_EQUAL(copy.getHopId(), 1);
+  BOOST_CHECK_EQUAL(Interest(copy.wireEncode()).getHopId(), 1);
+  BOOST_CHECK_EQUAL(Interest(copy.wireEncode()).getHopPosx(), 2.5);
+  BOOST_CHECK_EQUAL(Interest(decoded.wireEncode()).getHopId(), 1);
+  BOOST_CHECK_EQUAL(Interest(wire).getHopVelocityY(), -5);
+
+  copy.setHopId(11);
+  BOOST_CHECK_EQUAL(Interest(copy.wireEncode()).getHopId(), 11);
+  BOOST_CHECK_EQUAL(Interest(decoded.wireEncode()).getHopId(), 1);
+  BOOST_CHECK_EQUAL(Interest(i.wireEncode()).getHopId(), 6);
+}
+
 // ---- operators ----
 
 BOOST_AUTO_TEST_CASE(Equality)
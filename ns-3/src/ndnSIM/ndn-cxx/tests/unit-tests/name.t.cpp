@@ -429,6 +429,32 @@ BOOST_AUTO_TEST_CASE(UnorderedMap)
   BOOST_CHECK_EQUAL(map[name3], 3);
 }
 
+BOOST_AUTO_TEST_CASE(PrefixHashes)
+{
+  Name name("/A/B");
+  BOOST_CHECK(name.getPrefixHashes() == nullptr);
+
+  name.setPrefixHashes({0, 1, 2});
+  BOOST_REQUIRE(name.getPrefixHashes() != nullptr);
+  BOOST_CHECK_EQUAL(name.getPrefixHashes()->at(2), 2);
+
+  Name copy = name;
+  BOOST_CHECK_EQUAL(copy.getPrefixHashes(), name.getPrefixHashes());
+  name.wireEncode();
+  BOOST_CHECK(name.getPrefixHashes() != nullptr);
+
+  copy.append("C");
+  BOOST_CHECK(copy.getPrefixHashes() == nullptr);
+  BOOST_CHECK(name.getPrefixHashes() != nullptr);
+
+  name.wireDecode(Name("/D").wireEncode());
+  BOOST_CHECK(name.getPrefixHashes() == nullptr);
+
+  name.setPrefixHashes({0, 1});
+  name.clear();
+  BOOST_CHECK(name.getPrefixHashes() == nullptr);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestName
 
 } // namespace tests
@@ -104,6 +104,21 @@ BOOST_AUTO_TEST_CASE(CancelEmptyEvent)
   BOOST_CHECK(true);
 }
 
+BOOST_AUTO_TEST_CASE(CancelReleasesCallback)
+{
+  auto resource = make_shared<int>(1);
+  EventId i = scheduler.scheduleEvent(1_s, [resource] {
+      BOOST_ERROR("This event should not have been fired");
+    });
+  BOOST_CHECK_EQUAL(resource.use_count(), 2);
+
+  scheduler.cancelEvent(i);
+  BOOST_CHECK_EQUAL(resource.use_count(), 1);
+  BOOST_CHECK(!i);
+
+  advanceClocks(100_ms, 20);
+}
+
 BOOST_AUTO_TEST_CASE(SelfCancel)
 {
   EventId selfEventId;
@@ -243,6 +258,41 @@ BOOST_AUTO_TEST_CASE(CancelAllWithScopedEventId) // Bug 3691
   BOOST_CHECK(true);
 }
 
+BOOST_AUTO_TEST_CASE(SimulatorDestroy)
+{
+  scheduler.scheduleEvent(10_ms, []{});
+  EventId i2 = scheduler.scheduleEvent(20_ms, []{});
+  ns3::Simulator::Destroy(); // releases pending events, except the one still referenced by i2
+
+  // the next event reuses the released block, which must not be in the pending list anymore
+  size_t count = 0;
+  EventId i3 = scheduler.scheduleEvent(10_ms, [&] { ++count; });
+  scheduler.cancelAllEvents();
+  BOOST_CHECK(!i2);
+  BOOST_CHECK(!i3);
+
+  ns3::Simulator::Run();
+  BOOST_CHECK_EQUAL(count, 0);
+}
+
+BOOST_AUTO_TEST_CASE(AllocatedEvents)
+{
+  size_t nEvents = Scheduler::getNAllocatedEvents();
+
+  EventId i1 = scheduler.scheduleEvent(10_ms, []{});
+  EventId i2 = scheduler.scheduleEvent(20_ms, []{});
+  BOOST_CHECK_EQUAL(Scheduler::getNAllocatedEvents(), nEvents + 2);
+  BOOST_CHECK_GE(Scheduler::getAllocatedEventBytes(), 2 * sizeof(detail::EventInfo));
+
+  scheduler.cancelEvent(i2);
+  advanceClocks(10_ms, 3);
+  BOOST_CHECK_EQUAL(Scheduler::getNAllocatedEvents(), nEvents + 2); // still referenced by EventIds
+
+  i1.reset();
+  i2.reset();
+  BOOST_CHECK_EQUAL(Scheduler::getNAllocatedEvents(), nEvents);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // General
 
 BOOST_AUTO_TEST_SUITE(EventId)
@@ -0,0 +1,194 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-consumer-zipf-mandelbrot-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/apps/ndn-consumer-zipf-mandelbrot.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+namespace {
+
+int64_t g_nHeapBytes = 0;
+
+/// alignment-preserving header in front of each block, which records the block size
+const std::size_t HEADER_SIZE = 16;
+
+} // namespace
+
+// count the bytes held by every block obtained from the global allocator
+void*
+operator new(std::size_t size)
+{
+  char* p = static_cast<char*>(std::malloc(size + HEADER_SIZE));
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  *reinterpret_cast<std::size_t*>(p) = size;
+  g_nHeapBytes += size;
+  return p + HEADER_SIZE;
+}
+
+void
+operator delete(void* p) noexcept
+{
+  if (p == nullptr) {
+    return;
+  }
+  char* block = static_cast<char*>(p) - HEADER_SIZE;
+  g_nHeapBytes -= *reinterpret_cast<std::size_t*>(block);
+  std::free(block);
+}
+
+// used by libraries compiled with sized deallocation
+void
+operator delete(void* p, std::size_t) noexcept
+{
+  ::operator delete(p);
+}
+
+namespace ns3 {
+
+/**
+ * The sampler of ConsumerZipfMandelbrot before the distribution was shared: each consumer
+ * computed its own cumulative probabilities, and every draw scanned them linearly.
+ */
+class LinearZipfMandelbrotSampler : public SimpleRefCount<LinearZipfMandelbrotSampler> {
+public:
+  LinearZipfMandelbrotSampler(uint32_t N, double q, double s)
+    : m_N(N)
+    , m_Pcum(N + 1)
+    , m_seqRng(CreateObject<UniformRandomVariable>())
+  {
+    m_Pcum[0] = 0.0;
+    for (uint32_t i = 1; i <= m_N; i++) {
+      m_Pcum[i] = m_Pcum[i - 1] + 1.0 / std::pow(i + q, s);
+    }
+    for (uint32_t i = 1; i <= m_N; i++) {
+      m_Pcum[i] = m_Pcum[i] / m_Pcum[m_N];
+    }
+  }
+
+  uint32_t
+  GetNextSeq()
+  {
+    double p_random = m_seqRng->GetValue();
+    while (p_random == 0) {
+      p_random = m_seqRng->GetValue();
+    }
+    for (uint32_t i = 1; i <= m_N; i++) {
+      if (p_random <= m_Pcum[i]) {
+        return i;
+      }
+    }
+    return 1;
+  }
+
+private:
+  uint32_t m_N;
+  std::vector<double> m_Pcum;
+  Ptr<UniformRandomVariable> m_seqRng;
+};
+
+template<class Sampler>
+static void
+run(const std::string& label, const std::vector<Ptr<Sampler>>& samplers, int64_t nBytes,
+    uint32_t nSamples)
+{
+  uint64_t sum = 0;
+  auto begin = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < nSamples; ++i) {
+    sum += samplers[i % samplers.size()]->GetNextSeq();
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  double seconds = std::chrono::duration<double>(end - begin).count();
+  std::cout << label << "\t" << nSamples / seconds << "\t"
+            << static_cast<double>(nBytes) / samplers.size() << "\t"
+            << static_cast<double>(sum) / nSamples << std::endl;
+}
+
+/**
+ * Measures the popularity sampling of ConsumerZipfMandelbrot: --consumers consumers with the
+ * same catalog of --contents contents draw --samples content numbers in total.  The output
+ * lists the samples drawn per second of wall-clock time and the heap bytes per consumer, for
+ * ConsumerZipfMandelbrot (including the application object itself) and for the previous
+ * per-consumer linear scan:
+ *
+ *     ./waf --run "ndn-consumer-zipf-mandelbrot-benchmark --contents=1000000 --consumers=100"
+ */
+static int
+benchmark(int argc, char* argv[])
+{
+  uint32_t nContents = 1000000;
+  uint32_t nConsumers = 100;
+  uint32_t nSamples = 100000;
+  double q = 0.7;
+  double s = 0.7;
+  bool wantLinear = true;
+
+  CommandLine cmd;
+  cmd.AddValue("contents", "Number of contents in the catalog", nContents);
+  cmd.AddValue("consumers", "Number of consumers", nConsumers);
+  cmd.AddValue("samples", "Number of content numbers drawn by all consumers", nSamples);
+  cmd.AddValue("q", "q parameter of the distribution", q);
+  cmd.AddValue("s", "s parameter of the distribution", s);
+  cmd.AddValue("linear", "Also measure the previous linear scan sampler", wantLinear);
+  cmd.Parse(argc, argv);
+
+  std::cout << "sampler\tsamplesPerSecond\tbytesPerConsumer\tmeanContent" << std::endl;
+  {
+    int64_t initialHeapBytes = g_nHeapBytes;
+    std::vector<Ptr<ndn::ConsumerZipfMandelbrot>> consumers;
+    for (uint32_t i = 0; i < nConsumers; ++i) {
+      Ptr<ndn::ConsumerZipfMandelbrot> consumer = CreateObject<ndn::ConsumerZipfMandelbrot>();
+      consumer->SetAttribute("NumberOfContents", UintegerValue(nContents));
+      consumer->SetAttribute("q", DoubleValue(q));
+      consumer->SetAttribute("s", DoubleValue(s));
+      consumer->GetNextSeq(); // computes the distribution
+      consumers.push_back(consumer);
+    }
+    run("shared", consumers, g_nHeapBytes - initialHeapBytes, nSamples);
+  }
+
+  if (wantLinear) {
+    int64_t initialHeapBytes = g_nHeapBytes;
+    std::vector<Ptr<LinearZipfMandelbrotSampler>> samplers;
+    for (uint32_t i = 0; i < nConsumers; ++i) {
+      samplers.push_back(Create<LinearZipfMandelbrotSampler>(nContents, q, s));
+    }
+    run("linear", samplers, g_nHeapBytes - initialHeapBytes, nSamples);
+  }
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::benchmark(argc, argv);
+}
@@ -0,0 +1,196 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-content-store-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/model/cs/ndn-content-store.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <sstream>
+
+namespace {
+
+uint64_t g_nHeapAllocations = 0;
+
+} // namespace
+
+// count every call to the global allocator made by this program
+void*
+operator new(std::size_t size)
+{
+  ++g_nHeapAllocations;
+  void* p = std::malloc(size == 0 ? 1 : size);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void
+operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+namespace ns3 {
+
+/**
+ * Measures cache hits of the ndnSIM content store (ContentStoreImpl), which hands the cached
+ * Data to the forwarder as a shared pointer, against the previous behaviour of copying the
+ * Data on every hit.
+ *
+ * Interests for a catalog of --catalog Names follow a Zipf distribution, swept over
+ * alpha = 0.6, 0.8, 1.0 and 1.2.  Misses insert the Data into an LRU store of --size entries.
+ * For each alpha, the output lists the hit ratio, the wall-clock time per hit, and the heap
+ * allocations per hit:
+ *
+ *     ./waf --run "ndn-content-store-benchmark --catalog=10000 --size=1000 --n=1000000"
+ */
+class ContentStoreBenchmark
+{
+public:
+  ContentStoreBenchmark(uint32_t catalogSize, uint32_t csSize, uint32_t payloadSize)
+    : m_csSize(csSize)
+  {
+    auto payload = std::make_shared<::ndn::Buffer>(payloadSize);
+    for (uint32_t i = 0; i < catalogSize; ++i) {
+      ndn::Name name("/catalog");
+      name.appendNumber(i);
+      m_interests.push_back(std::make_shared<ndn::Interest>(name));
+      auto data = std::make_shared<ndn::Data>(name);
+      data->setFreshnessPeriod(::ndn::time::seconds(10));
+      data->setContent(payload);
+      m_data.push_back(data);
+    }
+  }
+
+  /**
+   * \brief draw n requests for catalog items from a Zipf distribution
+   */
+  void
+  GenerateRequests(double alpha, uint32_t n)
+  {
+    std::vector<double> cdf(m_interests.size());
+    double sum = 0;
+    for (size_t i = 0; i < cdf.size(); ++i) {
+      sum += 1.0 / std::pow(i + 1, alpha);
+      cdf[i] = sum;
+    }
+
+    Ptr<UniformRandomVariable> rand = CreateObject<UniformRandomVariable>();
+    m_requests.resize(n);
+    for (auto& request : m_requests) {
+      double u = rand->GetValue(0, sum);
+      request = std::min<size_t>(std::upper_bound(cdf.begin(), cdf.end(), u) - cdf.begin(),
+                                 cdf.size() - 1);
+    }
+  }
+
+  /**
+   * \brief replay the requests on an empty store
+   * \param shouldCopy emulate the previous Lookup, which returned a copy of the cached Data
+   */
+  void
+  Run(const std::string& label, bool shouldCopy)
+  {
+    ObjectFactory factory("ns3::ndn::cs::Lru");
+    factory.Set("MaxSize", UintegerValue(m_csSize));
+    Ptr<ndn::ContentStore> cs = factory.Create<ndn::ContentStore>();
+
+    uint64_t nHits = 0;
+    uint64_t nHitAllocations = 0;
+    std::chrono::steady_clock::duration hitTime(0);
+    size_t totalSize = 0;
+    for (size_t request : m_requests) {
+      uint64_t nAllocations = g_nHeapAllocations;
+      auto begin = std::chrono::steady_clock::now();
+      std::shared_ptr<const ndn::Data> match = cs->Lookup(m_interests[request]);
+      if (match != nullptr && shouldCopy) {
+        match = std::make_shared<ndn::Data>(*match);
+      }
+      auto end = std::chrono::steady_clock::now();
+
+      if (match != nullptr) {
+        ++nHits;
+        nHitAllocations += g_nHeapAllocations - nAllocations;
+        hitTime += end - begin;
+        totalSize += match->getContent().value_size();
+      }
+      else {
+        cs->Add(m_data[request]);
+      }
+    }
+
+    double hitNanoseconds = std::chrono::duration<double, std::nano>(hitTime).count();
+    std::cout << label << "\t" << static_cast<double>(nHits) / m_requests.size() << "\t"
+              << (nHits > 0 ? hitNanoseconds / nHits : 0) << "\t"
+              << (nHits > 0 ? static_cast<double>(nHitAllocations) / nHits : 0) << "\t"
+              << totalSize << std::endl;
+  }
+
+private:
+  uint32_t m_csSize;
+  std::vector<std::shared_ptr<ndn::Interest>> m_interests;
+  std::vector<std::shared_ptr<ndn::Data>> m_data;
+  std::vector<size_t> m_requests;
+};
+
+static int
+benchmark(int argc, char* argv[])
+{
+  uint32_t catalogSize = 10000;
+  uint32_t csSize = 1000;
+  uint32_t payloadSize = 1024;
+  uint32_t n = 1000000;
+
+  CommandLine cmd;
+  cmd.AddValue("catalog", "Number of distinct Names", catalogSize);
+  cmd.AddValue("size", "Maximum number of entries in the content store", csSize);
+  cmd.AddValue("payload", "Payload size of each Data, in bytes", payloadSize);
+  cmd.AddValue("n", "Number of Interests for each alpha", n);
+  cmd.Parse(argc, argv);
+
+  ContentStoreBenchmark benchmark(catalogSize, csSize, payloadSize);
+
+  std::cout << "alpha\tlookup\thitRatio\tnsPerHit\tallocationsPerHit\tbytesServed" << std::endl;
+  for (double alpha : {0.6, 0.8, 1.0, 1.2}) {
+    benchmark.GenerateRequests(alpha, n);
+    std::ostringstream os;
+    os << alpha;
+    benchmark.Run(os.str() + "\tshared", false);
+    benchmark.Run(os.str() + "\tcopy", true);
+  }
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::benchmark(argc, argv);
+}
@@ -0,0 +1,121 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-l3-rate-tracer-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <chrono>
+#include <iostream>
+
+namespace ns3 {
+
+/**
+ * Measures the overhead of L3RateTracer on a chain of nodes, with a consumer at one end and a
+ * producer at the other, by comparing the wall-clock time of the same simulation without
+ * tracing, with the text trace, and with the binary trace:
+ *
+ *     ./waf --run "ndn-l3-rate-tracer-benchmark --trace=none"
+ *     ./waf --run "ndn-l3-rate-tracer-benchmark --trace=text"
+ *     ./waf --run "ndn-l3-rate-tracer-benchmark --trace=binary"
+ *
+ * The binary trace can be converted to text with L3RateTracer::ConvertToText.
+ */
+static int
+benchmark(int argc, char* argv[])
+{
+  uint32_t nNodes = 100;
+  double frequency = 1000;
+  double simTime = 10;
+  double period = 0.1;
+  std::string trace = "none";
+  std::string file = "rate-trace";
+
+  CommandLine cmd;
+  cmd.AddValue("nodes", "Number of nodes", nNodes);
+  cmd.AddValue("frequency", "Interests per second sent by the consumer", frequency);
+  cmd.AddValue("time", "Simulated time, in seconds", simTime);
+  cmd.AddValue("period", "Averaging period of the tracer, in seconds", period);
+  cmd.AddValue("trace", "Trace format: none, text or binary", trace);
+  cmd.AddValue("file", "Trace file name, without extension", file);
+  cmd.Parse(argc, argv);
+
+  NodeContainer nodes;
+  nodes.Create(nNodes);
+
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute("DataRate", StringValue("1Gbps"));
+  for (uint32_t i = 1; i < nNodes; ++i) {
+    p2p.Install(nodes.Get(i - 1), nodes.Get(i));
+  }
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  for (uint32_t i = 1; i < nNodes; ++i) {
+    ndn::FibHelper::AddRoute(nodes.Get(i - 1), "/prefix", nodes.Get(i), 1);
+  }
+  ndn::StrategyChoiceHelper::InstallAll("/prefix", "/localhost/nfd/strategy/best-route");
+
+  ndn::AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetPrefix("/prefix");
+  consumerHelper.SetAttribute("Frequency", DoubleValue(frequency));
+  consumerHelper.Install(nodes.Get(0));
+
+  ndn::AppHelper producerHelper("ns3::ndn::Producer");
+  producerHelper.SetPrefix("/prefix");
+  producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+  producerHelper.Install(nodes.Get(nNodes - 1));
+
+  if (trace == "text") {
+    ndn::L3RateTracer::InstallAll(file + ".txt", Seconds(period));
+  }
+  else if (trace == "binary") {
+    ndn::L3RateTracer::InstallAll(file + ".bin", Seconds(period));
+  }
+  else if (trace != "none") {
+    std::cerr << "Unknown trace format: " << trace << std::endl;
+    return 1;
+  }
+
+  Simulator::Stop(Seconds(simTime));
+
+  auto begin = std::chrono::steady_clock::now();
+  Simulator::Run();
+  ndn::L3RateTracer::Destroy(); // flush the trace
+  auto end = std::chrono::steady_clock::now();
+
+  Simulator::Destroy();
+
+  double seconds = std::chrono::duration<double>(end - begin).count();
+  std::cout << "nodes: " << nNodes << ", trace: " << trace << "\n"
+            << "run time: " << seconds << " s" << std::endl;
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::benchmark(argc, argv);
+}
@@ -0,0 +1,115 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-net-device-transport-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/csma-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/model/ndn-net-device-transport.hpp"
+
+#include <chrono>
+#include <iostream>
+
+namespace ns3 {
+
+/**
+ * Measures NetDeviceTransport send/receive throughput on a shared CSMA segment, where every
+ * frame is delivered to all nodes.  Compare the wall-clock time with and without sharing the
+ * sent Blocks between the sending and the receiving transports:
+ *
+ *     ./waf --run "ndn-net-device-transport-benchmark --cache=4096"
+ *     ./waf --run "ndn-net-device-transport-benchmark --cache=0"
+ */
+static int
+benchmark(int argc, char* argv[])
+{
+  uint32_t nNodes = 20;
+  uint32_t cacheCapacity = 4096;
+  double rate = 10000;
+  uint32_t payloadSize = 1024;
+  Time simTime = Seconds(10);
+
+  CommandLine cmd;
+  cmd.AddValue("nodes", "Number of nodes attached to the CSMA segment", nNodes);
+  cmd.AddValue("cache", "Capacity of the sent Block cache (0 disables it)", cacheCapacity);
+  cmd.AddValue("rate", "Interest rate", rate);
+  cmd.AddValue("payload", "Data payload size", payloadSize);
+  cmd.AddValue("sim-time", "Simulation time", simTime);
+  cmd.Parse(argc, argv);
+
+  ndn::NetDeviceTransport::setSentBlockCacheCapacity(cacheCapacity);
+
+  NodeContainer nodes;
+  nodes.Create(nNodes);
+
+  CsmaHelper csma;
+  csma.SetChannelAttribute("DataRate", StringValue("100Gbps"));
+  csma.SetChannelAttribute("Delay", StringValue("1us"));
+  csma.Install(nodes);
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.setCsSize(1);
+  ndnHelper.InstallAll();
+
+  ndn::StrategyChoiceHelper::InstallAll("/", "/localhost/nfd/strategy/multicast");
+  ndn::FibHelper::AddRoute(nodes.Get(0), "/prefix", nodes.Get(1), 1);
+
+  ndn::AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetPrefix("/prefix");
+  consumerHelper.SetAttribute("Frequency", DoubleValue(rate));
+  consumerHelper.Install(nodes.Get(0));
+
+  ndn::AppHelper producerHelper("ns3::ndn::Producer");
+  producerHelper.SetPrefix("/prefix");
+  producerHelper.SetAttribute("PayloadSize", UintegerValue(payloadSize));
+  producerHelper.Install(nodes.Get(1));
+
+  Simulator::Stop(simTime);
+
+  auto begin = std::chrono::steady_clock::now();
+  Simulator::Run();
+  auto end = std::chrono::steady_clock::now();
+
+  uint64_t nReceived = 0;
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); ++node) {
+    const auto& faceTable = (*node)->GetObject<ndn::L3Protocol>()->getForwarder()->getFaceTable();
+    for (const auto& face : faceTable) {
+      nReceived += face.getCounters().nInPackets;
+    }
+  }
+  Simulator::Destroy();
+
+  double seconds = std::chrono::duration<double>(end - begin).count();
+  std::cout << "cache capacity: " << cacheCapacity << "\n"
+            << "packets received by transports: " << nReceived << "\n"
+            << "wall-clock time: " << seconds << " s (" << nReceived / seconds << " pkt/s)"
+            << std::endl;
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::benchmark(argc, argv);
+}
@@ -0,0 +1,103 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-stack-startup-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/utils/mem-usage.hpp"
+
+#include <chrono>
+#include <iostream>
+
+namespace ns3 {
+
+/**
+ * Measures the time and the memory (RSS) needed to install the NDN stack on a chain of nodes,
+ * set one route per node, and process the resulting management commands.  Compare the full
+ * NFD stack with the forwarder-only stack (StackHelper::disableManagement):
+ *
+ *     ./waf --run "ndn-stack-startup-benchmark --nodes=1000"
+ *     ./waf --run "ndn-stack-startup-benchmark --nodes=1000 --forwarder-only=1"
+ *     ./waf --run "ndn-stack-startup-benchmark --nodes=10000 --forwarder-only=1"
+ *     ./waf --run "ndn-stack-startup-benchmark --nodes=50000 --forwarder-only=1"
+ *
+ * Each configuration should be run in its own process, as memory is not returned to the system
+ * after Simulator::Destroy.
+ */
+static int
+benchmark(int argc, char* argv[])
+{
+  uint32_t nNodes = 1000;
+  bool isForwarderOnly = false;
+
+  CommandLine cmd;
+  cmd.AddValue("nodes", "Number of nodes", nNodes);
+  cmd.AddValue("forwarder-only", "Install the stack without NFD management", isForwarderOnly);
+  cmd.Parse(argc, argv);
+
+  NodeContainer nodes;
+  nodes.Create(nNodes);
+
+  PointToPointHelper p2p;
+  for (uint32_t i = 1; i < nNodes; ++i) {
+    p2p.Install(nodes.Get(i - 1), nodes.Get(i));
+  }
+
+  int64_t rssBefore = MemUsage::Get();
+  auto begin = std::chrono::steady_clock::now();
+
+  ndn::StackHelper ndnHelper;
+  if (isForwarderOnly) {
+    ndnHelper.disableManagement();
+  }
+  ndnHelper.InstallAll();
+
+  for (uint32_t i = 1; i < nNodes; ++i) {
+    ndn::FibHelper::AddRoute(nodes.Get(i), "/prefix", nodes.Get(i - 1), 1);
+  }
+  ndn::StrategyChoiceHelper::InstallAll("/prefix", "/localhost/nfd/strategy/best-route");
+
+  // let full stacks initialize the RIB manager and process the commands
+  Simulator::Stop(Seconds(0));
+  Simulator::Run();
+
+  auto end = std::chrono::steady_clock::now();
+  int64_t rssAfter = MemUsage::Get();
+
+  Simulator::Destroy();
+
+  double seconds = std::chrono::duration<double>(end - begin).count();
+  std::cout << "nodes: " << nNodes << (isForwarderOnly ? " (forwarder only)" : " (full NFD)") << "\n"
+            << "startup time: " << seconds << " s (" << seconds * 1e6 / nNodes << " us per node)\n"
+            << "RSS increase: " << (rssAfter - rssBefore) / 1024 / 1024 << " MiB ("
+            << (rssAfter - rssBefore) / nNodes << " bytes per node)" << std::endl;
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::benchmark(argc, argv);
+}
@@ -18,6 +18,11 @@
  **/
 
 #include "helper/ndn-stack-helper.hpp"
+#include "helper/ndn-fib-helper.hpp"
+#include "helper/ndn-strategy-choice-helper.hpp"
+
+#include "ns3/ndnSIM/NFD/daemon/fw/strategy.hpp"
+
 #include "../tests-common.hpp"
 
 #include "ns3/point-to-point-module.h"
@@ -62,6 +67,44 @@ BOOST_AUTO_TEST_CASE(TestNfdContentStorePolicy)
   BOOST_CHECK_EQUAL(protoNode1->getForwarder()->getCs().getPolicy()->getName(), "priority_fifo");
 }
 
+BOOST_AUTO_TEST_CASE(DisableManagement)
+{
+  NodeContainer nodes;
+  nodes.Create(2);
+
+  PointToPointHelper p2p;
+  p2p.Install(nodes.Get(0), nodes.Get(1));
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.disableManagement();
+  ndnHelper.InstallAll();
+
+  Ptr<L3Protocol> proto = L3Protocol::getL3Protocol(nodes.Get(0));
+  BOOST_CHECK(proto->isManagementDisabled());
+  BOOST_CHECK(proto->getFibManager() == nullptr);
+  BOOST_CHECK(proto->getStrategyChoiceManager() == nullptr);
+
+  shared_ptr<nfd::Forwarder> forwarder = proto->getForwarder();
+  BOOST_CHECK_EQUAL(forwarder->getCs().getLimit(), 100);
+  const Name multicast("/localhost/nfd/strategy/multicast");
+  nfd::StrategyChoice& sc = forwarder->getStrategyChoice();
+  BOOST_CHECK(multicast.isPrefixOf(sc.findEffectiveStrategy("/ndn/multicast").getInstanceName()));
+
+  // FIB and strategy choice are changed immediately, without command Interests
+  shared_ptr<Face> face = proto->getFaceByNetDevice(nodes.Get(0)->GetDevice(0));
+  FibHelper::AddRoute(nodes.Get(0), "/prefix", face, 10);
+  nfd::fib::Entry* entry = forwarder->getFib().findExactMatch("/prefix");
+  BOOST_REQUIRE(entry != nullptr);
+  BOOST_REQUIRE_EQUAL(entry->getNextHops().size(), 1);
+  BOOST_CHECK_EQUAL(entry->getNextHops().front().getCost(), 10);
+
+  StrategyChoiceHelper::Install(nodes.Get(0), "/prefix", multicast);
+  BOOST_CHECK(multicast.isPrefixOf(sc.findEffectiveStrategy("/prefix/A").getInstanceName()));
+
+  FibHelper::RemoveRoute(nodes.Get(0), "/prefix", face);
+  BOOST_CHECK(forwarder->getFib().findExactMatch("/prefix") == nullptr);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
@@ -20,6 +20,7 @@
 #include "model/ndn-block-header.hpp"
 #include "helper/ndn-stack-helper.hpp"
 
+#include <ndn-cxx/encoding/block-helpers.hpp>
 #include <ndn-cxx/lp/packet.hpp>
 
 #include "ns3/ndnSIM/NFD/daemon/face/transport.hpp"
@@ -155,6 +156,50 @@ BOOST_AUTO_TEST_CASE(PrintLpPacket)
   }
 }
 
+BOOST_AUTO_TEST_CASE(Deserialize)
+{
+  Data data("/other/prefix");
+  data.setContent(std::make_shared< ::ndn::Buffer>(1024));
+  ndn::StackHelper::getKeyChain().sign(data);
+  lp::Packet lpPacket(data.wireEncode());
+  Block wire = lpPacket.wireEncode();
+
+  {
+    Ptr<Packet> packet = Create<Packet>(wire.wire(), wire.size());
+    BlockHeader header;
+    BOOST_CHECK_EQUAL(packet->RemoveHeader(header), wire.size());
+    BOOST_CHECK_EQUAL_COLLECTIONS(header.getBlock().begin(), header.getBlock().end(),
+                                  wire.begin(), wire.end());
+    BOOST_CHECK_EQUAL(packet->GetSize(), 0);
+  }
+
+  {
+    // header in front of a payload that is still in the ns-3 "virtual zero area"
+    Ptr<Packet> packet = Create<Packet>(100);
+    packet->AddHeader(BlockHeader(nfd::face::Transport::Packet(Block(wire))));
+    BlockHeader header;
+    BOOST_CHECK_EQUAL(packet->RemoveHeader(header), wire.size());
+    BOOST_CHECK(header.getBlock() == wire);
+    BOOST_CHECK_EQUAL(packet->GetSize(), 100);
+  }
+
+  {
+    // short TLV entirely covered by the first peek
+    Block empty = ::ndn::encoding::makeEmptyBlock(lp::tlv::LpPacket);
+    Ptr<Packet> packet = Create<Packet>(empty.wire(), empty.size());
+    BlockHeader header;
+    BOOST_CHECK_EQUAL(packet->RemoveHeader(header), 2);
+    BOOST_CHECK_EQUAL(header.getBlock().type(), lp::tlv::LpPacket);
+    BOOST_CHECK_EQUAL(header.getBlock().value_size(), 0);
+  }
+
+  {
+    Ptr<Packet> packet = Create<Packet>(wire.wire(), wire.size() - 10);
+    BlockHeader header;
+    BOOST_CHECK_THROW(packet->RemoveHeader(header), ::ndn::tlv::Error);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
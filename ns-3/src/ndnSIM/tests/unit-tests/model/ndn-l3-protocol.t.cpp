@@ -151,6 +151,24 @@ BOOST_AUTO_TEST_CASE(DisabledForwarderStatusManager)
 
 BOOST_AUTO_TEST_SUITE_END() // ManagerCheck
 
+BOOST_AUTO_TEST_CASE(SharedConfig)
+{
+  getStackHelper().setCsSize(42);
+  createTopology({
+      {"1", "2"},
+        });
+
+  nfd::ConfigSection& config1 = getNode("1")->GetObject<L3Protocol>()->getConfig();
+  BOOST_CHECK_EQUAL(config1.get<size_t>("tables.cs_max_packets"), 42);
+  config1.put("tables.cs_max_packets", 1);
+
+  // the config is copied before it is modified
+  nfd::ConfigSection& config2 = getNode("2")->GetObject<L3Protocol>()->getConfig();
+  BOOST_CHECK_NE(&config1, &config2);
+  BOOST_CHECK_EQUAL(config2.get<size_t>("tables.cs_max_packets"), 42);
+  BOOST_CHECK_EQUAL(L3Protocol::getDefaultConfig()->get<size_t>("tables.cs_max_packets"), 100);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // ModelNdnL3Protocol
 
 } // namespace ndn
@@ -0,0 +1,87 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2018  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "model/ndn-net-device-transport.hpp"
+#include "model/ndn-l3-protocol.hpp"
+#include "helper/ndn-stack-helper.hpp"
+
+#include "../tests-common.hpp"
+
+#include "ns3/csma-module.h"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(ModelNdnNetDeviceTransport, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(BroadcastReceiversForward)
+{
+  NodeContainer nodes;
+  nodes.Create(3);
+  CsmaHelper csma;
+  NetDeviceContainer devices = csma.Install(nodes);
+
+  StackHelper ndnHelper;
+  ndnHelper.Install(nodes);
+
+  Interest interest("/prefix");
+  interest.setHopContext(1, 10, 20, 1, -1);
+
+  // both receivers of the broadcast get the wire of the sent Block, and forward the Interest
+  // with their own hop fields, as Forwarder::onOutgoingInterest does
+  std::vector<uint32_t> receivedHopIds;
+  std::vector<double> receivedHopPosx;
+  std::vector<shared_ptr<const Interest>> forwarded;
+  for (uint32_t i = 1; i < nodes.GetN(); ++i) {
+    shared_ptr<Face> face = nodes.Get(i)->GetObject<L3Protocol>()->getFaceByNetDevice(devices.Get(i));
+    BOOST_REQUIRE(face != nullptr);
+    face->afterReceiveInterest.connect([&, i] (const Interest& received) {
+        receivedHopIds.push_back(received.getHopId());
+        receivedHopPosx.push_back(received.getHopPosx());
+        const_cast<Interest&>(received).setHopContext(i + 1, 100 * i, 0, 0, 0);
+        forwarded.push_back(received.shared_from_this());
+      });
+  }
+
+  shared_ptr<Face> face = nodes.Get(0)->GetObject<L3Protocol>()->getFaceByNetDevice(devices.Get(0));
+  Simulator::Schedule(Seconds(0.1), &Face::sendInterest, face.get(), interest);
+
+  Simulator::Stop(Seconds(1.0));
+  Simulator::Run();
+
+  BOOST_REQUIRE_EQUAL(receivedHopIds.size(), 2);
+  BOOST_CHECK_EQUAL(receivedHopIds[0], 1);
+  BOOST_CHECK_EQUAL(receivedHopIds[1], 1);
+  BOOST_CHECK_EQUAL(receivedHopPosx[0], 10);
+  BOOST_CHECK_EQUAL(receivedHopPosx[1], 10);
+
+  std::set<uint32_t> forwardedHopIds;
+  for (const auto& i : forwarded) {
+    forwardedHopIds.insert(Interest(i->wireEncode()).getHopId());
+  }
+  BOOST_CHECK_EQUAL(forwardedHopIds.size(), 2);
+  BOOST_CHECK_EQUAL(forwardedHopIds.count(2), 1);
+  BOOST_CHECK_EQUAL(forwardedHopIds.count(3), 1);
+  BOOST_CHECK_EQUAL(Interest(interest.wireEncode()).getHopId(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // ModelNdnNetDeviceTransport
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,102 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-delay-histogram.hpp"
+
+#include <cmath>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(UtilsNdnDelayHistogram)
+
+BOOST_AUTO_TEST_CASE(Empty)
+{
+  DelayHistogram histogram;
+  BOOST_CHECK_EQUAL(histogram.getCount(), 0);
+  BOOST_CHECK_EQUAL(histogram.getMin(), 0);
+  BOOST_CHECK_EQUAL(histogram.getMax(), 0);
+  BOOST_CHECK_EQUAL(histogram.getMean(), 0);
+  BOOST_CHECK_EQUAL(histogram.getQuantile(0.5), 0);
+}
+
+BOOST_AUTO_TEST_CASE(SmallValuesAreExact)
+{
+  DelayHistogram histogram(5);
+  for (uint64_t value = 1; value <= 64; ++value) {
+    histogram.record(value);
+  }
+
+  BOOST_CHECK_EQUAL(histogram.getCount(), 64);
+  BOOST_CHECK_EQUAL(histogram.getMin(), 1);
+  BOOST_CHECK_EQUAL(histogram.getMax(), 64);
+  BOOST_CHECK_EQUAL(histogram.getMean(), 32.5);
+  BOOST_CHECK_EQUAL(histogram.getQuantile(0), 1);
+  BOOST_CHECK_EQUAL(histogram.getQuantile(0.5), 32);
+  BOOST_CHECK_EQUAL(histogram.getQuantile(0.9), 58);
+  BOOST_CHECK_EQUAL(histogram.getQuantile(1), 64);
+}
+
+BOOST_AUTO_TEST_CASE(RelativeError)
+{
+  DelayHistogram histogram(5);
+  for (uint64_t value = 1000; value <= 1000000; value += 1000) {
+    histogram.record(value * 1000);
+  }
+
+  for (double q : {0.01, 0.1, 0.5, 0.9, 0.99}) {
+    double exact = std::ceil(q * 1000) * 1000000;
+    BOOST_CHECK_CLOSE(static_cast<double>(histogram.getQuantile(q)), exact, 100.0 / 32);
+  }
+  BOOST_CHECK_EQUAL(histogram.getQuantile(1), 1000000000);
+  BOOST_CHECK_EQUAL(histogram.getMean(), 500500000);
+}
+
+BOOST_AUTO_TEST_CASE(MergeReset)
+{
+  DelayHistogram histogram1;
+  histogram1.record(5);
+  histogram1.record(7);
+
+  DelayHistogram histogram2;
+  histogram2.record(1000000);
+  histogram2.record(1);
+
+  histogram1.merge(histogram2);
+  BOOST_CHECK_EQUAL(histogram1.getCount(), 4);
+  BOOST_CHECK_EQUAL(histogram1.getMin(), 1);
+  BOOST_CHECK_EQUAL(histogram1.getMax(), 1000000);
+  BOOST_CHECK_EQUAL(histogram1.getQuantile(0.5), 5);
+  BOOST_CHECK_EQUAL(histogram1.getQuantile(1), 1000000);
+
+  histogram1.reset();
+  BOOST_CHECK_EQUAL(histogram1.getCount(), 0);
+  BOOST_CHECK_EQUAL(histogram1.getQuantile(0.5), 0);
+
+  histogram1.record(41766400);
+  BOOST_CHECK_EQUAL(histogram1.getMin(), 41766400);
+  BOOST_CHECK_EQUAL(histogram1.getQuantile(0.5), 41766400); // clamped to [min, max]
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,151 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-stats-sink.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <sstream>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_STATS = boost::filesystem::path(TEST_CONFIG_PATH) / "stats";
+
+class StatsSinkFixture : public CleanupFixture
+{
+public:
+  StatsSinkFixture()
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+  }
+
+  ~StatsSinkFixture()
+  {
+    StatsSink::Destroy();
+    StatsSink::SetFormat(StatsSink::TEXT);
+    StatsSink::SetBatchSize(4096);
+    boost::filesystem::remove(TEST_STATS.string() + ".csv");
+    boost::filesystem::remove(TEST_STATS.string() + ".bin");
+  }
+
+  static std::string
+  readFile(const std::string& fileName)
+  {
+    std::ifstream is(fileName, std::ifstream::binary);
+    std::stringstream buffer;
+    buffer << is.rdbuf();
+    return buffer.str();
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnStatsSink, StatsSinkFixture)
+
+BOOST_AUTO_TEST_CASE(Text)
+{
+  StatsSink::SetBatchSize(2);
+  std::shared_ptr<StatsStream> stream = StatsSink::GetStream(TEST_STATS.string());
+  BOOST_CHECK_EQUAL(stream, StatsSink::GetStream(TEST_STATS.string()));
+  BOOST_CHECK_EQUAL(stream->getFileName(), TEST_STATS.string() + ".csv");
+
+  stream->record(1000, "/prefix/1", 2);
+  BOOST_CHECK_EQUAL(readFile(stream->getFileName()), ""); // still buffered
+
+  stream->record(2000, "/prefix/2", 0.5);
+  BOOST_CHECK_EQUAL(readFile(stream->getFileName()),
+                    "1000,/prefix/1,2\n"
+                    "2000,/prefix/2,0.5\n");
+
+  stream->record(3000, "/prefix/3", 3);
+  Simulator::Destroy(); // flushes all streams
+  BOOST_CHECK_EQUAL(readFile(stream->getFileName()),
+                    "1000,/prefix/1,2\n"
+                    "2000,/prefix/2,0.5\n"
+                    "3000,/prefix/3,3\n");
+}
+
+BOOST_AUTO_TEST_CASE(Binary)
+{
+  StatsSink::SetFormat(StatsSink::BINARY);
+  std::shared_ptr<StatsStream> stream = StatsSink::GetStream(TEST_STATS.string());
+  BOOST_CHECK_EQUAL(stream->getFileName(), TEST_STATS.string() + ".bin");
+
+  stream->record(1, "/a");
+  stream->record(2, "/bc");
+  StatsSink::FlushAll();
+
+  const uint8_t expected[] = {
+    2, 0, 0, 0, // nRows
+    2, 0, 0, 0, // nColumns
+    0, 16, 0, 0, 0, // INTEGER, 16 bytes
+    1, 0, 0, 0, 0, 0, 0, 0,
+    2, 0, 0, 0, 0, 0, 0, 0,
+    2, 13, 0, 0, 0, // STRING, 13 bytes
+    2, 0, 0, 0, '/', 'a',
+    3, 0, 0, 0, '/', 'b', 'c'
+  };
+  std::string actual = readFile(stream->getFileName());
+  BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(),
+                                expected, expected + sizeof(expected));
+}
+
+BOOST_AUTO_TEST_CASE(Destroy)
+{
+  std::shared_ptr<StatsStream> stream = StatsSink::GetStream(TEST_STATS.string());
+  std::weak_ptr<StatsStream> weakStream = stream;
+  stream->record(1, "/a");
+
+  // a stream still referenced by a recorder is flushed, then released by the sink
+  StatsSink::Destroy();
+  BOOST_CHECK_EQUAL(readFile(TEST_STATS.string() + ".csv"), "1,/a\n");
+  BOOST_CHECK(!weakStream.expired());
+  stream.reset();
+  BOOST_CHECK(weakStream.expired());
+
+  StatsSink::GetStream(TEST_STATS.string())->record(2, "/b");
+  StatsSink::FlushAll();
+  BOOST_CHECK_EQUAL(readFile(TEST_STATS.string() + ".csv"), "1,/a\n2,/b\n");
+}
+
+BOOST_AUTO_TEST_CASE(ConvertToText)
+{
+  StatsSink::SetBatchSize(2);
+  for (auto format : {StatsSink::TEXT, StatsSink::BINARY}) {
+    StatsSink::SetFormat(format);
+    std::shared_ptr<StatsStream> stream = StatsSink::GetStream(TEST_STATS.string());
+    for (int i = 0; i < 5; ++i) {
+      stream->record(1.5 * i, "/prefix/" + std::to_string(i), i);
+    }
+    StatsSink::Destroy(); // flush, so that the next stream is created in the next format
+  }
+
+  std::ostringstream os;
+  BOOST_CHECK(StatsSink::ConvertToText(TEST_STATS.string() + ".bin", os));
+  BOOST_CHECK_EQUAL(os.str(), readFile(TEST_STATS.string() + ".csv"));
+
+  BOOST_CHECK(!StatsSink::ConvertToText(TEST_STATS.string() + ".missing", os));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -28,6 +28,7 @@ namespace ns3 {
 namespace ndn {
 
 const boost::filesystem::path TEST_TRACE = boost::filesystem::path(TEST_CONFIG_PATH) / "trace.txt";
+const boost::filesystem::path TEST_RAW_TRACE = boost::filesystem::path(TEST_CONFIG_PATH) / "raw.txt";
 
 class AppDelayTracerFixture : public ScenarioHelperWithCleanupFixture
 {
@@ -68,6 +69,7 @@ public:
   ~AppDelayTracerFixture()
   {
     boost::filesystem::remove(TEST_TRACE);
+    boost::filesystem::remove(TEST_RAW_TRACE);
     AppDelayTracer::Destroy(); // additional cleanup
   }
 };
@@ -157,6 +159,62 @@ BOOST_AUTO_TEST_CASE(InstallNodeDumpStream)
     "3.02088	2	0	1	FullDelay	0.0208832	20883.2	1	1\n"));
 }
 
+BOOST_AUTO_TEST_CASE(Summary)
+{
+  AppDelayTracer::InstallAll(TEST_TRACE.string(), Seconds(1.5), TEST_RAW_TRACE.string(), 2);
+
+  Simulator::Stop(Seconds(5));
+  Simulator::Run();
+
+  AppDelayTracer::Destroy(); // to force log to be written
+
+  std::ifstream t(TEST_TRACE.string().c_str());
+  std::stringstream buffer;
+  buffer << t.rdbuf();
+
+  BOOST_CHECK_EQUAL(buffer.str(),
+    "Time	Node	AppId	Type	Count	MinUS	MeanUS	P50US	P90US	P99US	MaxUS\n"
+    "1.5	1	0	LastDelay	1	41766.4	41766.4	41766.4	41766.4	41766.4	41766.4\n"
+    "1.5	1	0	FullDelay	1	41766.4	41766.4	41766.4	41766.4	41766.4	41766.4\n"
+    "3	2	0	LastDelay	1	0	0	0	0	0	0\n"
+    "3	2	0	FullDelay	1	0	0	0	0	0	0\n"
+    "4.5	2	0	LastDelay	1	20883.2	20883.2	20883.2	20883.2	20883.2	20883.2\n"
+    "4.5	2	0	FullDelay	1	20883.2	20883.2	20883.2	20883.2	20883.2	20883.2\n");
+
+  // only the first of every two received Data of each node
+  std::ifstream raw(TEST_RAW_TRACE.string().c_str());
+  std::stringstream rawBuffer;
+  rawBuffer << raw.rdbuf();
+
+  BOOST_CHECK_EQUAL(rawBuffer.str(),
+    "Time	Node	AppId	SeqNo	Type	DelayS	DelayUS	RetxCount	HopCount\n"
+    "0.0417664	1	0	0	LastDelay	0.0417664	41766.4	1	2\n"
+    "0.0417664	1	0	0	FullDelay	0.0417664	41766.4	1	2\n"
+    "2	2	0	0	LastDelay	0	0	1	0\n"
+    "2	2	0	0	FullDelay	0	0	1	0\n");
+}
+
+BOOST_AUTO_TEST_CASE(SummaryLastPeriod)
+{
+  AppDelayTracer::InstallAll(TEST_TRACE.string(), Seconds(1.5));
+
+  Simulator::Stop(Seconds(2.5));
+  Simulator::Run();
+
+  AppDelayTracer::Destroy(); // writes the delays received after the last summary
+
+  std::ifstream t(TEST_TRACE.string().c_str());
+  std::stringstream buffer;
+  buffer << t.rdbuf();
+
+  BOOST_CHECK_EQUAL(buffer.str(),
+    "Time	Node	AppId	Type	Count	MinUS	MeanUS	P50US	P90US	P99US	MaxUS\n"
+    "1.5	1	0	LastDelay	1	41766.4	41766.4	41766.4	41766.4	41766.4	41766.4\n"
+    "1.5	1	0	FullDelay	1	41766.4	41766.4	41766.4	41766.4	41766.4	41766.4\n"
+    "2.5	2	0	LastDelay	1	0	0	0	0	0	0\n"
+    "2.5	2	0	FullDelay	1	0	0	0	0	0	0\n");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
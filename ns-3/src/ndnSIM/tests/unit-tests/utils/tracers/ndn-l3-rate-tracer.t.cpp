@@ -22,12 +22,15 @@
 #include <boost/filesystem.hpp>
 #include <boost/test/output_test_stream.hpp>
 
+#include <sstream>
+
 #include "../../tests-common.hpp"
 
 namespace ns3 {
 namespace ndn {
 
 const boost::filesystem::path TEST_TRACE = boost::filesystem::path(TEST_CONFIG_PATH) / "trace.txt";
+const boost::filesystem::path TEST_TRACE_BIN = boost::filesystem::path(TEST_CONFIG_PATH) / "trace.bin";
 
 class L3RateTracerFixture : public ScenarioHelperWithCleanupFixture
 {
@@ -55,6 +58,7 @@ public:
   ~L3RateTracerFixture()
   {
     boost::filesystem::remove(TEST_TRACE);
+    boost::filesystem::remove(TEST_TRACE_BIN);
     L3RateTracer::Destroy(); // additional cleanup
   }
 };
@@ -119,6 +123,59 @@ BOOST_AUTO_TEST_CASE(NackTracing)
   BOOST_CHECK(os.match_pattern());
 }
 
+BOOST_AUTO_TEST_CASE(BinaryOutput)
+{
+  NodeContainer nodes;
+  nodes.Add(getNode("1"));
+
+  L3RateTracer::Install(nodes, TEST_TRACE_BIN.string(), Seconds(1));
+
+  Simulator::Stop(Seconds(1.5));
+  Simulator::Run();
+
+  L3RateTracer::Destroy(); // to force log to be written
+
+  std::ostringstream text;
+  BOOST_REQUIRE(L3RateTracer::ConvertToText(TEST_TRACE_BIN.string(), text));
+
+  boost::test_tools::output_test_stream os;
+  os << text.str();
+  BOOST_CHECK(os.is_equal(
+    "Time\tNode\tFaceId\tFaceDescr\tType\tPackets\tKilobytes\tPacketRaw\tKilobytesRaw\n"
+    "1\t1\t1\tinternal://\tInInterests\t0\t0\t0\t0\n"
+    "1\t1\t1\tinternal://\tOutInterests\t0\t0\t0\t0\n"
+    "1\t1\t1\tinternal://\tInData\t0\t0\t0\t0\n"
+    "1\t1\t1\tinternal://\tOutData\t0\t0\t0\t0\n"
+    "1\t1\t1\tinternal://\tInNacks\t0\t0\t0\t0\n"
+    "1\t1\t1\tinternal://\tOutNacks\t0\t0\t0\t0\n"
+    "1\t1\t1\tinternal://\tInSatisfiedInterests\t0\t0\t0\t0\n"
+    "1\t1\t1\tinternal://\tInTimedOutInterests\t0\t0\t0\t0\n"
+    "1\t1\t1\tinternal://\tOutSatisfiedInterests\t2.4\t0\t3\t0\n"
+    "1\t1\t1\tinternal://\tOutTimedOutInterests\t0\t0\t0\t0\n"
+    "1\t1\t256\tinternal://\tInInterests\t0\t0\t0\t0\n"
+    "1\t1\t256\tinternal://\tOutInterests\t0\t0\t0\t0\n"
+    "1\t1\t256\tinternal://\tInData\t0\t0\t0\t0\n"
+    "1\t1\t256\tinternal://\tOutData\t0\t0\t0\t0\n"
+    "1\t1\t256\tinternal://\tInNacks\t0\t0\t0\t0\n"
+    "1\t1\t256\tinternal://\tOutNacks\t0\t0\t0\t0\n"
+    "1\t1\t256\tinternal://\tInSatisfiedInterests\t2.4\t0\t3\t0\n"
+    "1\t1\t256\tinternal://\tInTimedOutInterests\t0\t0\t0\t0\n"
+    "1\t1\t256\tinternal://\tOutSatisfiedInterests\t0\t0\t0\t0\n"
+    "1\t1\t256\tinternal://\tOutTimedOutInterests\t0\t0\t0\t0\n"
+    "1\t1\t257\tappFace://\tInInterests\t0.8\t0\t1\t0\n"
+    "1\t1\t257\tappFace://\tOutInterests\t0\t0\t0\t0\n"
+    "1\t1\t257\tappFace://\tInData\t0\t0\t0\t0\n"
+    "1\t1\t257\tappFace://\tOutData\t0\t0\t0\t0\n"
+    "1\t1\t257\tappFace://\tInNacks\t0\t0\t0\t0\n"
+    "1\t1\t257\tappFace://\tOutNacks\t0.8\t0\t1\t0\n"
+    "1\t1\t257\tappFace://\tInSatisfiedInterests\t0\t0\t0\t0\n"
+    "1\t1\t257\tappFace://\tInTimedOutInterests\t0\t0\t0\t0\n"
+    "1\t1\t257\tappFace://\tOutSatisfiedInterests\t0\t0\t0\t0\n"
+    "1\t1\t257\tappFace://\tOutTimedOutInterests\t0\t0\t0\t0\n"
+    "1\t1\t-1\tall\tSatisfiedInterests\t3.2\t0\t4\t0\n"
+    "1\t1\t-1\tall\tTimedOutInterests\t0\t0\t0\t0\n"));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
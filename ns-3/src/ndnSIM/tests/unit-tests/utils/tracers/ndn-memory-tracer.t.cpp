@@ -0,0 +1,158 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-memory-tracer.hpp"
+#include "model/ndn-l3-protocol.hpp"
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <sstream>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_TRACE = boost::filesystem::path(TEST_CONFIG_PATH) / "trace.txt";
+
+class MemoryTracerFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  MemoryTracerFixture()
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+
+    // setting default parameters for PointToPoint links and channels
+    Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+    Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+    Config::SetDefault("ns3::QueueBase::MaxPackets", UintegerValue(20));
+  }
+
+  ~MemoryTracerFixture()
+  {
+    Config::SetDefault("ns3::ndn::L3Protocol::MemoryUsagePeriod", TimeValue(Seconds(0)));
+    boost::filesystem::remove(TEST_TRACE);
+    MemoryTracer::Destroy(); // additional cleanup
+  }
+
+  void
+  createScenario()
+  {
+    createTopology({
+        {"1", "2"}
+      });
+
+    addRoutes({
+        {"1", "2", "/prefix", 1}
+      });
+
+    addApps({
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+            "0s", "0.95s"}, // send 10 Interests
+        {"2", "ns3::ndn::Producer",
+            {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+            "0s", "100s"}
+      });
+  }
+
+  void
+  recordTableMemoryUsage(const TableMemoryUsage& usage)
+  {
+    times.push_back(Simulator::Now().ToDouble(Time::S));
+    nPitEntries.push_back(usage.pit.nObjects);
+  }
+
+public:
+  std::vector<double> times;
+  std::vector<uint64_t> nPitEntries;
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnMemoryTracer, MemoryTracerFixture)
+
+BOOST_AUTO_TEST_CASE(GetTableMemoryUsage)
+{
+  createScenario();
+
+  Simulator::Stop(Seconds(2));
+  Simulator::Run();
+
+  auto usage = L3Protocol::getL3Protocol(getNode("1"))->getTableMemoryUsage();
+  BOOST_CHECK_EQUAL(usage.cs.nObjects, 10);
+  BOOST_CHECK_GT(usage.cs.nBytes, 10 * 1024);
+  BOOST_CHECK_EQUAL(usage.pit.nObjects, 0);
+  BOOST_CHECK_EQUAL(usage.pitInRecords.nObjects, 0);
+  BOOST_CHECK_GE(usage.fib.nObjects, 1);
+  BOOST_CHECK_GE(usage.nameTree.nObjects, usage.fib.nObjects);
+  BOOST_CHECK_GT(usage.tablePool.nBytes, 0);
+
+  auto processUsage = ProcessMemoryUsage::get();
+  BOOST_CHECK_GT(processUsage.packetBuffers.nObjects, 0);
+  BOOST_CHECK_GT(processUsage.rss.nBytes, 0);
+}
+
+BOOST_AUTO_TEST_CASE(TraceSource)
+{
+  Config::SetDefault("ns3::ndn::L3Protocol::MemoryUsagePeriod", TimeValue(Seconds(0.5)));
+  createScenario();
+
+  L3Protocol::getL3Protocol(getNode("1"))->TraceConnectWithoutContext("TableMemoryUsage",
+    MakeCallback(&MemoryTracerFixture::recordTableMemoryUsage, this));
+
+  Simulator::Stop(Seconds(1.75));
+  Simulator::Run();
+
+  std::vector<double> expectedTimes = {0.5, 1.0, 1.5};
+  BOOST_CHECK_EQUAL_COLLECTIONS(times.begin(), times.end(),
+                                expectedTimes.begin(), expectedTimes.end());
+  BOOST_REQUIRE_EQUAL(nPitEntries.size(), 3);
+  BOOST_CHECK_EQUAL(nPitEntries[2], 0);
+}
+
+BOOST_AUTO_TEST_CASE(InstallAll)
+{
+  createScenario();
+  MemoryTracer::InstallAll(TEST_TRACE.string(), Seconds(1));
+
+  Simulator::Stop(Seconds(2.5));
+  Simulator::Run();
+
+  MemoryTracer::Destroy(); // to force log to be written
+
+  std::ifstream is(TEST_TRACE.string().c_str());
+  std::string line;
+  std::vector<std::string> lines;
+  while (std::getline(is, line)) {
+    lines.push_back(line);
+  }
+
+  // header, then 2 snapshots of 9 tables of 2 nodes and 3 process-wide counters
+  BOOST_REQUIRE_EQUAL(lines.size(), 1 + 2 * (2 * 9 + 3));
+  BOOST_CHECK_EQUAL(lines[0], "Time\tNode\tTable\tObjects\tBytes");
+  BOOST_CHECK(boost::starts_with(lines[1], "1\t1\tNameTree\t"));
+  BOOST_CHECK(boost::starts_with(lines[22 + 5], "2\t1\tCs\t10\t"));
+  BOOST_CHECK(boost::starts_with(lines[22 + 18], "2\tall\tSchedulerEvents\t"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
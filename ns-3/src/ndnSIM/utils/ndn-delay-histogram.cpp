@@ -0,0 +1,155 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-delay-histogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <boost/assert.hpp>
+
+namespace ns3 {
+namespace ndn {
+
+DelayHistogram::DelayHistogram(int precisionBits)
+  : m_precisionBits(precisionBits)
+  , m_nSubBuckets(uint64_t(1) << precisionBits)
+  , m_count(0)
+  , m_sum(0)
+  , m_min(std::numeric_limits<uint64_t>::max())
+  , m_max(0)
+{
+  BOOST_ASSERT(precisionBits >= 0 && precisionBits < 32);
+}
+
+size_t
+DelayHistogram::getBucketIndex(uint64_t value) const
+{
+  if (value < 2 * m_nSubBuckets) {
+    return value;
+  }
+
+  // keep the precisionBits + 1 most significant bits
+  int msb = 63 - __builtin_clzll(value);
+  int shift = msb - m_precisionBits;
+  return shift * m_nSubBuckets + (value >> shift);
+}
+
+uint64_t
+DelayHistogram::getBucketStart(size_t index) const
+{
+  if (index < 2 * m_nSubBuckets) {
+    return index;
+  }
+
+  uint64_t shift = index / m_nSubBuckets - 1;
+  return (index % m_nSubBuckets + m_nSubBuckets) << shift;
+}
+
+uint64_t
+DelayHistogram::getBucketWidth(size_t index) const
+{
+  if (index < 2 * m_nSubBuckets) {
+    return 1;
+  }
+
+  return uint64_t(1) << (index / m_nSubBuckets - 1);
+}
+
+void
+DelayHistogram::record(uint64_t value)
+{
+  size_t index = getBucketIndex(value);
+  if (index >= m_buckets.size()) {
+    m_buckets.resize(index + 1);
+  }
+  ++m_buckets[index];
+
+  ++m_count;
+  m_sum += value;
+  m_min = std::min(m_min, value);
+  m_max = std::max(m_max, value);
+}
+
+void
+DelayHistogram::merge(const DelayHistogram& other)
+{
+  BOOST_ASSERT(other.m_precisionBits == m_precisionBits);
+
+  if (other.m_buckets.size() > m_buckets.size()) {
+    m_buckets.resize(other.m_buckets.size());
+  }
+  for (size_t i = 0; i < other.m_buckets.size(); ++i) {
+    m_buckets[i] += other.m_buckets[i];
+  }
+
+  m_count += other.m_count;
+  m_sum += other.m_sum;
+  m_min = std::min(m_min, other.m_min);
+  m_max = std::max(m_max, other.m_max);
+}
+
+void
+DelayHistogram::reset()
+{
+  std::fill(m_buckets.begin(), m_buckets.end(), 0);
+
+  m_count = 0;
+  m_sum = 0;
+  m_min = std::numeric_limits<uint64_t>::max();
+  m_max = 0;
+}
+
+double
+DelayHistogram::getMean() const
+{
+  return m_count == 0 ? 0 : m_sum / m_count;
+}
+
+uint64_t
+DelayHistogram::getQuantile(double q) const
+{
+  if (m_count == 0) {
+    return 0;
+  }
+
+  uint64_t rank = static_cast<uint64_t>(std::ceil(q * m_count));
+  rank = std::min(std::max(rank, uint64_t(1)), m_count);
+  if (rank == 1) {
+    return getMin();
+  }
+  if (rank == m_count) {
+    return m_max;
+  }
+
+  uint64_t seen = 0;
+  for (size_t i = 0; i < m_buckets.size(); ++i) {
+    seen += m_buckets[i];
+    if (seen >= rank) {
+      uint64_t value = getBucketStart(i) + (getBucketWidth(i) - 1) / 2;
+      return std::min(std::max(value, m_min), m_max);
+    }
+  }
+
+  return m_max;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,129 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_DELAY_HISTOGRAM_HPP
+#define NDN_DELAY_HISTOGRAM_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Streaming histogram of non-negative integer values (e.g., delays in nanoseconds)
+ *
+ * Values are counted in logarithmic buckets, as in HDR histograms: each power of two is split
+ * into 2^precisionBits equal sub-buckets, so that any quantile is reported with a relative error
+ * below 2^-precisionBits, while the memory needed does not depend on the number of values.
+ * Values below 2^(precisionBits + 1) are counted exactly.  Buckets are allocated up to the
+ * largest value seen, e.g. 960 buckets (7.5 KiB) for delays up to 10 s in nanoseconds with the
+ * default precision.  Count, sum, minimum and maximum are tracked exactly.
+ */
+class DelayHistogram
+{
+public:
+  explicit
+  DelayHistogram(int precisionBits = 5);
+
+  void
+  record(uint64_t value);
+
+  /**
+   * @brief Add all values counted by @p other
+   * @pre other has the same precision
+   */
+  void
+  merge(const DelayHistogram& other);
+
+  /**
+   * @brief Forget all values, keeping the allocated buckets
+   */
+  void
+  reset();
+
+  uint64_t
+  getCount() const
+  {
+    return m_count;
+  }
+
+  /**
+   * @return smallest value, or 0 if the histogram is empty
+   */
+  uint64_t
+  getMin() const
+  {
+    return m_count == 0 ? 0 : m_min;
+  }
+
+  uint64_t
+  getMax() const
+  {
+    return m_max;
+  }
+
+  /**
+   * @return mean value, or 0 if the histogram is empty
+   */
+  double
+  getMean() const;
+
+  /**
+   * @brief Estimate the @p q quantile (0 <= q <= 1)
+   * @return middle of the bucket holding the value of rank ceil(q * count), clamped to
+   *         [getMin(), getMax()]; the exact minimum or maximum for the first or the last rank;
+   *         0 if the histogram is empty
+   */
+  uint64_t
+  getQuantile(double q) const;
+
+private:
+  size_t
+  getBucketIndex(uint64_t value) const;
+
+  /**
+   * @return smallest value counted in the bucket at @p index
+   */
+  uint64_t
+  getBucketStart(size_t index) const;
+
+  /**
+   * @return number of distinct values counted in the bucket at @p index
+   */
+  uint64_t
+  getBucketWidth(size_t index) const;
+
+private:
+  int m_precisionBits;
+  uint64_t m_nSubBuckets; ///< @brief 2^precisionBits
+  std::vector<uint64_t> m_buckets;
+
+  uint64_t m_count;
+  double m_sum;
+  uint64_t m_min;
+  uint64_t m_max;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_DELAY_HISTOGRAM_HPP
@@ -0,0 +1,48 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-memory-usage.hpp"
+#include "mem-usage.hpp"
+
+#include "ns3/buffer.h"
+
+#include <ndn-cxx/util/scheduler.hpp>
+
+namespace ns3 {
+namespace ndn {
+
+ProcessMemoryUsage
+ProcessMemoryUsage::get()
+{
+  ProcessMemoryUsage usage;
+
+  usage.schedulerEvents.nObjects = ::ndn::util::scheduler::Scheduler::getNAllocatedEvents();
+  usage.schedulerEvents.nBytes = ::ndn::util::scheduler::Scheduler::getAllocatedEventBytes();
+
+  usage.packetBuffers.nObjects = Buffer::GetNAllocatedData();
+  usage.packetBuffers.nBytes = Buffer::GetAllocatedDataBytes();
+
+  int64_t rss = MemUsage::Get();
+  usage.rss.nBytes = rss > 0 ? rss : 0;
+
+  return usage;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,109 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_MEMORY_USAGE_HPP
+#define NDN_MEMORY_USAGE_HPP
+
+#include <cstdint>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Number of objects and bytes used by one subsystem
+ */
+struct MemoryCounter
+{
+  uint64_t nObjects = 0;
+  uint64_t nBytes = 0;
+};
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Snapshot of the memory used by the NDN tables of one node
+ *
+ * The snapshot is computed on request (see L3Protocol::getTableMemoryUsage), so that keeping
+ * the tables costs nothing extra.  Bytes of table entries are estimated as the number of entries
+ * times the size of the entry type; names, packets and strategy information referenced by the
+ * entries are not included.  tablePool is exact: it counts the blocks handed out by the memory
+ * pool that holds name tree nodes, PIT entries and PIT records, and the bytes that the pool
+ * obtained from the system.  For the CS, nBytes is the total size of the cached Data packets.
+ */
+struct TableMemoryUsage
+{
+  MemoryCounter nameTree;
+  MemoryCounter pit;
+  MemoryCounter pitInRecords;
+  MemoryCounter pitOutRecords;
+  MemoryCounter tablePool;
+  MemoryCounter cs;
+  MemoryCounter deadNonceList;
+  MemoryCounter measurements;
+  MemoryCounter fib;
+
+  /**
+   * @brief Invoke @p f with the name and the counter of each table
+   */
+  template<typename F>
+  void
+  forEach(const F& f) const
+  {
+    f("NameTree", nameTree);
+    f("Pit", pit);
+    f("PitInRecords", pitInRecords);
+    f("PitOutRecords", pitOutRecords);
+    f("TablePool", tablePool);
+    f("Cs", cs);
+    f("DeadNonceList", deadNonceList);
+    f("Measurements", measurements);
+    f("Fib", fib);
+  }
+};
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Snapshot of the memory used by the whole simulation process
+ */
+struct ProcessMemoryUsage
+{
+  MemoryCounter schedulerEvents; ///< @brief events of ndn-cxx schedulers, i.e. NFD timers
+  MemoryCounter packetBuffers; ///< @brief data areas of ns-3 packet buffers
+  MemoryCounter rss; ///< @brief resident set size (nObjects is always 0)
+
+  static ProcessMemoryUsage
+  get();
+
+  /**
+   * @brief Invoke @p f with the name and the counter of each subsystem
+   */
+  template<typename F>
+  void
+  forEach(const F& f) const
+  {
+    f("SchedulerEvents", schedulerEvents);
+    f("PacketBuffers", packetBuffers);
+    f("Rss", rss);
+  }
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_MEMORY_USAGE_HPP
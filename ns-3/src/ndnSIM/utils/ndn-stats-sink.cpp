@@ -0,0 +1,322 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-stats-sink.hpp"
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+NS_LOG_COMPONENT_DEFINE("ndn.StatsSink");
+
+namespace ns3 {
+namespace ndn {
+
+static const size_t DEFAULT_BATCH_SIZE = 4096;
+
+template<typename T>
+static void
+appendLittleEndian(std::string& buffer, T value)
+{
+  uint8_t bytes[sizeof(T)];
+  uint64_t bits = 0;
+  std::memcpy(&bits, &value, sizeof(T));
+  for (size_t i = 0; i < sizeof(T); ++i) {
+    bytes[i] = static_cast<uint8_t>(bits >> (8 * i));
+  }
+  buffer.append(reinterpret_cast<const char*>(bytes), sizeof(T));
+}
+
+template<typename T>
+static bool
+readLittleEndian(std::istream& is, T& value)
+{
+  uint8_t bytes[sizeof(T)];
+  if (!is.read(reinterpret_cast<char*>(bytes), sizeof(T))) {
+    return false;
+  }
+  uint64_t bits = 0;
+  for (size_t i = 0; i < sizeof(T); ++i) {
+    bits |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+  }
+  std::memcpy(&value, &bits, sizeof(T));
+  return true;
+}
+
+static void
+formatReal(std::string& text, double value)
+{
+  char buf[32];
+  int n = std::snprintf(buf, sizeof(buf), "%g", value);
+  text.append(buf, n);
+}
+
+StatsStream::StatsStream(const std::string& name, size_t batchSize, bool isBinary)
+  : m_fileName(name + (isBinary ? ".bin" : ".csv"))
+  , m_batchSize(batchSize)
+  , m_isBinary(isBinary)
+  , m_nRows(0)
+  , m_column(0)
+{
+}
+
+StatsStream::~StatsStream()
+{
+  flush();
+}
+
+std::string&
+StatsStream::getColumn(ColumnType type)
+{
+  if (m_column >= m_columns.size()) {
+    m_columns.resize(m_column + 1);
+    m_columns[m_column].first = type;
+  }
+  NS_ASSERT_MSG(m_columns[m_column].first == type,
+                "Column " << m_column << " of " << m_fileName << " changed its type");
+  return m_columns[m_column].second;
+}
+
+void
+StatsStream::appendInteger(int64_t value)
+{
+  if (m_isBinary) {
+    appendLittleEndian(getColumn(INTEGER), value);
+  }
+  else {
+    m_text += std::to_string(value);
+    m_text += ',';
+  }
+}
+
+void
+StatsStream::appendReal(double value)
+{
+  if (m_isBinary) {
+    appendLittleEndian(getColumn(REAL), value);
+  }
+  else {
+    formatReal(m_text, value);
+    m_text += ',';
+  }
+}
+
+void
+StatsStream::appendString(const std::string& value)
+{
+  if (m_isBinary) {
+    std::string& column = getColumn(STRING);
+    appendLittleEndian(column, static_cast<uint32_t>(value.size()));
+    column += value;
+  }
+  else {
+    m_text += value;
+    m_text += ',';
+  }
+}
+
+void
+StatsStream::flush()
+{
+  if (m_nRows == 0) {
+    return;
+  }
+
+  std::ofstream os(m_fileName, std::ofstream::app | std::ofstream::binary);
+  if (!os.is_open()) {
+    NS_LOG_ERROR("Cannot open " << m_fileName << ", dropping " << m_nRows << " rows");
+  }
+  else if (m_isBinary) {
+    std::string header;
+    appendLittleEndian(header, static_cast<uint32_t>(m_nRows));
+    appendLittleEndian(header, static_cast<uint32_t>(m_columns.size()));
+    os.write(header.data(), header.size());
+    for (const auto& column : m_columns) {
+      std::string columnHeader(1, static_cast<char>(column.first));
+      appendLittleEndian(columnHeader, static_cast<uint32_t>(column.second.size()));
+      os.write(columnHeader.data(), columnHeader.size());
+      os.write(column.second.data(), column.second.size());
+    }
+  }
+  else {
+    os.write(m_text.data(), m_text.size());
+  }
+
+  m_nRows = 0;
+  m_text.clear();
+  for (auto& column : m_columns) {
+    column.second.clear();
+  }
+}
+
+StatsSink::StatsSink()
+  : m_format(TEXT)
+  , m_batchSize(DEFAULT_BATCH_SIZE)
+  , m_isFlushScheduled(false)
+{
+}
+
+StatsSink::~StatsSink()
+{
+  // streams flush themselves on destruction
+}
+
+StatsSink&
+StatsSink::getInstance()
+{
+  static StatsSink instance;
+  return instance;
+}
+
+std::shared_ptr<StatsStream>
+StatsSink::GetStream(const std::string& name)
+{
+  StatsSink& sink = getInstance();
+
+  auto& stream = sink.m_streams[name];
+  if (stream == nullptr) {
+    stream = std::make_shared<StatsStream>(name, sink.m_batchSize, sink.m_format == BINARY);
+  }
+
+  if (!sink.m_isFlushScheduled) {
+    Simulator::ScheduleDestroy(&StatsSink::onSimulatorDestroy);
+    sink.m_isFlushScheduled = true;
+  }
+  return stream;
+}
+
+void
+StatsSink::SetFormat(Format format)
+{
+  getInstance().m_format = format;
+}
+
+void
+StatsSink::SetBatchSize(size_t nRows)
+{
+  getInstance().m_batchSize = std::max<size_t>(nRows, 1);
+}
+
+void
+StatsSink::FlushAll()
+{
+  StatsSink& sink = getInstance();
+  for (auto& stream : sink.m_streams) {
+    stream.second->flush();
+  }
+}
+
+void
+StatsSink::onSimulatorDestroy()
+{
+  FlushAll();
+  // a new simulation run will need its own flush on Simulator::Destroy
+  getInstance().m_isFlushScheduled = false;
+}
+
+void
+StatsSink::Destroy()
+{
+  // streams still referenced elsewhere are not destroyed here, so flush them explicitly
+  FlushAll();
+  getInstance().m_streams.clear();
+}
+
+bool
+StatsSink::ConvertToText(const std::string& fileName, std::ostream& os, char separator)
+{
+  std::ifstream is(fileName, std::ifstream::binary);
+  if (!is.is_open()) {
+    NS_LOG_ERROR("Cannot open " << fileName);
+    return false;
+  }
+
+  uint32_t nRows = 0;
+  while (readLittleEndian(is, nRows)) {
+    uint32_t nColumns = 0;
+    if (!readLittleEndian(is, nColumns)) {
+      return false;
+    }
+
+    // format the columns of a block one by one, then write the block row by row
+    std::vector<std::vector<std::string>> fields(nColumns, std::vector<std::string>(nRows));
+    for (uint32_t column = 0; column < nColumns; ++column) {
+      char type = 0;
+      uint32_t nBytes = 0;
+      if (!is.get(type) || !readLittleEndian(is, nBytes)) {
+        return false;
+      }
+
+      for (uint32_t row = 0; row < nRows; ++row) {
+        std::string& field = fields[column][row];
+        switch (type) {
+        case StatsStream::INTEGER: {
+          int64_t value = 0;
+          if (!readLittleEndian(is, value)) {
+            return false;
+          }
+          field = std::to_string(value);
+          break;
+        }
+        case StatsStream::REAL: {
+          double value = 0;
+          if (!readLittleEndian(is, value)) {
+            return false;
+          }
+          formatReal(field, value);
+          break;
+        }
+        case StatsStream::STRING: {
+          uint32_t length = 0;
+          if (!readLittleEndian(is, length)) {
+            return false;
+          }
+          field.resize(length);
+          if (!is.read(&field[0], length)) {
+            return false;
+          }
+          break;
+        }
+        default:
+          NS_LOG_ERROR("Unknown column type " << static_cast<int>(type) << " in " << fileName);
+          return false;
+        }
+      }
+    }
+
+    for (uint32_t row = 0; row < nRows; ++row) {
+      for (uint32_t column = 0; column < nColumns; ++column) {
+        if (column > 0) {
+          os << separator;
+        }
+        os << fields[column][row];
+      }
+      os << '\n';
+    }
+  }
+
+  return is.eof();
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,257 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_STATS_SINK_HPP
+#define NDN_STATS_SINK_HPP
+
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Buffered writer of one statistics stream (one output file)
+ *
+ * Each call to record() adds one row.  Rows are kept in memory and appended to the file in
+ * batches, so that recording a row does not involve any system call.  The file is opened only
+ * for the duration of a flush, which keeps the number of open descriptors independent of the
+ * number of streams (there are several per node).
+ *
+ * In StatsSink::TEXT format rows are written as comma-separated lines into `<name>.csv`.
+ * In StatsSink::BINARY format each flushed batch is appended to `<name>.bin` as one columnar
+ * block (all values are little-endian):
+ *
+ *     uint32 nRows, uint32 nColumns,
+ *     nColumns times: uint8 columnType, uint32 nBytes, nBytes of column data
+ *
+ * where the column data is nRows values of type int64 (columnType 0), double (1), or
+ * string (2, each value is uint32 length followed by the characters).
+ */
+class StatsStream
+{
+public:
+  enum ColumnType : uint8_t {
+    INTEGER = 0,
+    REAL = 1,
+    STRING = 2
+  };
+
+  StatsStream(const std::string& name, size_t batchSize, bool isBinary);
+
+  ~StatsStream();
+
+  StatsStream(const StatsStream&) = delete;
+
+  StatsStream&
+  operator=(const StatsStream&) = delete;
+
+  /**
+   * @brief Record one row
+   *
+   * Integral fields are stored as int64, floating point fields as double, anything convertible
+   * to std::string as string.  All rows of a stream are expected to have the same layout.
+   */
+  template<typename... Fields>
+  void
+  record(const Fields&... fields)
+  {
+    static_assert(sizeof...(Fields) > 0, "a row must have at least one field");
+    m_column = 0;
+    appendFields(fields...);
+    if (!m_isBinary) {
+      m_text.back() = '\n';
+    }
+    if (++m_nRows >= m_batchSize) {
+      flush();
+    }
+  }
+
+  /**
+   * @brief Append all buffered rows to the file
+   */
+  void
+  flush();
+
+  const std::string&
+  getFileName() const
+  {
+    return m_fileName;
+  }
+
+private:
+  void
+  appendFields()
+  {
+  }
+
+  template<typename Field, typename... Fields>
+  void
+  appendFields(const Field& field, const Fields&... fields)
+  {
+    append(field);
+    ++m_column;
+    appendFields(fields...);
+  }
+
+  template<typename T>
+  typename std::enable_if<std::is_integral<T>::value>::type
+  append(T value)
+  {
+    appendInteger(static_cast<int64_t>(value));
+  }
+
+  template<typename T>
+  typename std::enable_if<std::is_floating_point<T>::value>::type
+  append(T value)
+  {
+    appendReal(static_cast<double>(value));
+  }
+
+  template<typename T>
+  typename std::enable_if<!std::is_arithmetic<T>::value>::type
+  append(const T& value)
+  {
+    appendString(value);
+  }
+
+  void
+  appendInteger(int64_t value);
+
+  void
+  appendReal(double value);
+
+  void
+  appendString(const std::string& value);
+
+  std::string&
+  getColumn(ColumnType type);
+
+private:
+  std::string m_fileName;
+  size_t m_batchSize;
+  bool m_isBinary;
+
+  size_t m_nRows;
+  size_t m_column;
+
+  std::string m_text; ///< @brief buffered rows in TEXT format
+  std::vector<std::pair<ColumnType, std::string>> m_columns; ///< @brief buffered BINARY columns
+};
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Process-wide registry of buffered statistics streams
+ *
+ * Streams are created on the first request and are held by the sink until Destroy() is called.
+ * All streams are flushed when the simulation is destroyed (Simulator::Destroy) and when the
+ * process exits.
+ *
+ * Example:
+ *
+ *     auto stream = StatsSink::GetStream("HopRecord/hop_" + std::to_string(nodeId) + "_Node");
+ *     stream->record(Simulator::Now().GetNanoSeconds(), interest.getName().toUri(), hopCount);
+ *
+ * An object recording many rows may cache the stream as a std::weak_ptr, and call GetStream()
+ * again once it has expired, so that rows recorded after Destroy() go to a new stream.
+ */
+class StatsSink
+{
+public:
+  enum Format {
+    TEXT,
+    BINARY
+  };
+
+  /**
+   * @brief Get (create if necessary) the stream with the given name
+   * @param name path of the output file, without extension
+   *
+   * The sink releases its reference when Destroy() is called.
+   */
+  static std::shared_ptr<StatsStream>
+  GetStream(const std::string& name);
+
+  /**
+   * @brief Select the output format of streams created after this call (default TEXT)
+   */
+  static void
+  SetFormat(Format format);
+
+  /**
+   * @brief Set number of rows buffered per stream before they are appended to the file
+   *
+   * Applies to streams created after this call (default 4096 rows).
+   */
+  static void
+  SetBatchSize(size_t nRows);
+
+  /**
+   * @brief Flush all streams
+   */
+  static void
+  FlushAll();
+
+  /**
+   * @brief Flush and remove all streams
+   */
+  static void
+  Destroy();
+
+  /**
+   * @brief Write the rows of a file in BINARY format as text, one line per row
+   * @param fileName file written by a stream in BINARY format
+   * @param os output stream
+   * @param separator written between the fields of a row
+   * @return false if the file cannot be opened or is truncated
+   *
+   * Fields are formatted as in TEXT format, so that converting a BINARY file gives the same
+   * rows as recording in TEXT format with ',' as the separator.
+   */
+  static bool
+  ConvertToText(const std::string& fileName, std::ostream& os, char separator = ',');
+
+private:
+  StatsSink();
+
+  ~StatsSink();
+
+  static StatsSink&
+  getInstance();
+
+  static void
+  onSimulatorDestroy();
+
+private:
+  std::map<std::string, std::shared_ptr<StatsStream>> m_streams;
+  Format m_format;
+  size_t m_batchSize;
+  bool m_isFlushScheduled;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_STATS_SINK_HPP
@@ -45,9 +45,84 @@ static std::list<std::tuple<shared_ptr<std::ostream>, std::list<Ptr<AppDelayTrac
 void
 AppDelayTracer::Destroy()
 {
+  for (const auto& outputAndTracers : g_tracers) {
+    for (const auto& tracer : std::get<1>(outputAndTracers)) {
+      tracer->FlushSummaries();
+    }
+  }
   g_tracers.clear();
 }
 
+/**
+ * @return stream for the file, std::cout if file is "-", or nullptr if the file cannot be opened
+ */
+static shared_ptr<std::ostream>
+openOutputStream(const std::string& file)
+{
+  if (file == "-") {
+    return shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  }
+
+  shared_ptr<std::ofstream> os(new std::ofstream());
+  os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+
+  if (!os->is_open()) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+    return nullptr;
+  }
+
+  return os;
+}
+
+void
+AppDelayTracer::InstallAll(const std::string& file, Time summaryPeriod,
+                           const std::string& rawFile, uint32_t rawSamplingInterval)
+{
+  NodeContainer nodes;
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    nodes.Add(*node);
+  }
+
+  Install(nodes, file, summaryPeriod, rawFile, rawSamplingInterval);
+}
+
+void
+AppDelayTracer::Install(const NodeContainer& nodes, const std::string& file, Time summaryPeriod,
+                        const std::string& rawFile, uint32_t rawSamplingInterval)
+{
+  shared_ptr<std::ostream> summaryStream = openOutputStream(file);
+  if (summaryStream == nullptr) {
+    return;
+  }
+
+  shared_ptr<std::ostream> rawStream;
+  if (!rawFile.empty()) {
+    rawStream = openOutputStream(rawFile);
+    if (rawStream == nullptr) {
+      return;
+    }
+  }
+
+  std::list<Ptr<AppDelayTracer>> tracers;
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    Ptr<AppDelayTracer> trace = Install(*node, summaryStream, summaryPeriod, rawStream,
+                                        rawSamplingInterval);
+    tracers.push_back(trace);
+  }
+
+  if (tracers.size() > 0) {
+    tracers.front()->PrintSummaryHeader(*summaryStream);
+    *summaryStream << "\n";
+
+    if (rawStream != nullptr) {
+      tracers.front()->PrintHeader(*rawStream);
+      *rawStream << "\n";
+    }
+  }
+
+  g_tracers.push_back(std::make_tuple(summaryStream, tracers));
+}
+
 void
 AppDelayTracer::InstallAll(const std::string& file)
 {
@@ -167,6 +242,18 @@ AppDelayTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream)
   return trace;
 }
 
+Ptr<AppDelayTracer>
+AppDelayTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> summaryStream, Time summaryPeriod,
+                        shared_ptr<std::ostream> rawStream, uint32_t rawSamplingInterval)
+{
+  NS_LOG_DEBUG("Node: " << node->GetId());
+
+  Ptr<AppDelayTracer> trace = Create<AppDelayTracer>(summaryStream, summaryPeriod, rawStream,
+                                                     rawSamplingInterval, node);
+
+  return trace;
+}
+
 //////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
@@ -174,6 +261,9 @@ AppDelayTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream)
 AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
   : m_nodePtr(node)
   , m_os(os)
+  , m_rawSamplingInterval(1)
+  , m_nLastDelays(0)
+  , m_nFullDelays(0)
 {
   m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
 
@@ -188,11 +278,33 @@ AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
 AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, const std::string& node)
   : m_node(node)
   , m_os(os)
+  , m_rawSamplingInterval(1)
+  , m_nLastDelays(0)
+  , m_nFullDelays(0)
 {
   Connect();
 }
 
-AppDelayTracer::~AppDelayTracer(){};
+AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> summaryOs, Time summaryPeriod,
+                               shared_ptr<std::ostream> rawOs, uint32_t rawSamplingInterval,
+                               Ptr<Node> node)
+  : AppDelayTracer(rawOs, node)
+{
+  NS_ASSERT(rawSamplingInterval > 0);
+
+  m_summaryOs = summaryOs;
+  m_summaryPeriod = summaryPeriod;
+  m_rawSamplingInterval = rawSamplingInterval;
+  m_printEvent = Simulator::Schedule(m_summaryPeriod, &AppDelayTracer::PeriodicPrinter, this);
+  m_flushEvent = Simulator::ScheduleDestroy(&AppDelayTracer::FlushSummaries, this);
+}
+
+AppDelayTracer::~AppDelayTracer()
+{
+  m_printEvent.Cancel();
+  m_flushEvent.Cancel();
+  FlushSummaries();
+}
 
 void
 AppDelayTracer::Connect()
@@ -230,10 +342,84 @@ AppDelayTracer::PrintHeader(std::ostream& os) const
      << "";
 }
 
+void
+AppDelayTracer::PrintSummaryHeader(std::ostream& os) const
+{
+  os << "Time"
+     << "\t"
+     << "Node"
+     << "\t"
+     << "AppId"
+     << "\t"
+
+     << "Type"
+     << "\t"
+     << "Count"
+     << "\t"
+     << "MinUS"
+     << "\t"
+     << "MeanUS"
+     << "\t"
+     << "P50US"
+     << "\t"
+     << "P90US"
+     << "\t"
+     << "P99US"
+     << "\t"
+     << "MaxUS"
+     << "";
+}
+
+void
+AppDelayTracer::PeriodicPrinter()
+{
+  FlushSummaries();
+  m_printEvent = Simulator::Schedule(m_summaryPeriod, &AppDelayTracer::PeriodicPrinter, this);
+}
+
+void
+AppDelayTracer::FlushSummaries()
+{
+  if (m_summaryOs == nullptr) {
+    return;
+  }
+
+  for (auto& app : m_appDelays) {
+    PrintSummary(app.first, "LastDelay", app.second.lastDelay);
+    PrintSummary(app.first, "FullDelay", app.second.fullDelay);
+
+    app.second.lastDelay.reset();
+    app.second.fullDelay.reset();
+  }
+}
+
+void
+AppDelayTracer::PrintSummary(uint32_t appId, const char* type, const DelayHistogram& delays) const
+{
+  if (delays.getCount() == 0) {
+    return;
+  }
+
+  // delays are counted in nanoseconds
+  *m_summaryOs << Simulator::Now().ToDouble(Time::S) << "\t" << m_node << "\t" << appId << "\t"
+               << type << "\t" << delays.getCount() << "\t" << delays.getMin() / 1000.0 << "\t"
+               << delays.getMean() / 1000.0 << "\t" << delays.getQuantile(0.5) / 1000.0 << "\t"
+               << delays.getQuantile(0.9) / 1000.0 << "\t" << delays.getQuantile(0.99) / 1000.0
+               << "\t" << delays.getMax() / 1000.0 << "\n";
+}
+
 void
 AppDelayTracer::LastRetransmittedInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay,
                                                    int32_t hopCount)
 {
+  if (m_summaryOs != nullptr) {
+    m_appDelays[app->GetId()].lastDelay.record(delay.GetNanoSeconds());
+  }
+
+  if (m_os == nullptr || m_nLastDelays++ % m_rawSamplingInterval != 0) {
+    return;
+  }
+
   *m_os << Simulator::Now().ToDouble(Time::S) << "\t" << m_node << "\t" << app->GetId() << "\t"
         << seqno << "\t"
         << "LastDelay"
@@ -245,6 +431,14 @@ void
 AppDelayTracer::FirstInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay, uint32_t retxCount,
                                        int32_t hopCount)
 {
+  if (m_summaryOs != nullptr) {
+    m_appDelays[app->GetId()].fullDelay.record(delay.GetNanoSeconds());
+  }
+
+  if (m_os == nullptr || m_nFullDelays++ % m_rawSamplingInterval != 0) {
+    return;
+  }
+
   *m_os << Simulator::Now().ToDouble(Time::S) << "\t" << m_node << "\t" << app->GetId() << "\t"
         << seqno << "\t"
         << "FullDelay"
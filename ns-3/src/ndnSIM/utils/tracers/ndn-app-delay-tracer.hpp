@@ -21,6 +21,7 @@
 #define CCNX_APP_DELAY_TRACER_H
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/utils/ndn-delay-histogram.hpp"
 
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
@@ -30,6 +31,7 @@
 
 #include <tuple>
 #include <list>
+#include <map>
 
 namespace ns3 {
 
@@ -43,6 +45,13 @@ class App;
 /**
  * @ingroup ndn-tracers
  * @brief Tracer to obtain application-level delays
+ *
+ * By default, one line is written for each received Data.  In summary mode (Install methods
+ * with a summary period), delays of each application are instead counted in DelayHistogram
+ * objects, and one line with count, mean and quantiles of the delays received within the
+ * period is written per application and type of delay.  Per-packet lines can still be written
+ * to a separate stream, for all or only one of every N received Data.  Delays received after the
+ * last periodic summary are written when the simulation or the tracer is destroyed.
  */
 class AppDelayTracer : public SimpleRefCount<AppDelayTracer> {
 public:
@@ -91,11 +100,53 @@ public:
   static Ptr<AppDelayTracer>
   Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream);
 
+  /**
+   * @brief Helper method to install summary tracers on all simulation nodes
+   *
+   * @param file File to which summaries will be written.  If filename is -, then std::out is used
+   * @param summaryPeriod How often summaries will be written into the file
+   * @param rawFile If not empty, file to which per-packet delays will be written
+   * @param rawSamplingInterval Write per-packet delays of only one of every rawSamplingInterval
+   *        received Data of each node
+   */
+  static void
+  InstallAll(const std::string& file, Time summaryPeriod, const std::string& rawFile = "",
+             uint32_t rawSamplingInterval = 1);
+
+  /**
+   * @brief Helper method to install summary tracers on the selected simulation nodes
+   *
+   * @param nodes Nodes on which to install tracer
+   * @param file File to which summaries will be written.  If filename is -, then std::out is used
+   * @param summaryPeriod How often summaries will be written into the file
+   * @param rawFile If not empty, file to which per-packet delays will be written
+   * @param rawSamplingInterval Write per-packet delays of only one of every rawSamplingInterval
+   *        received Data of each node
+   */
+  static void
+  Install(const NodeContainer& nodes, const std::string& file, Time summaryPeriod,
+          const std::string& rawFile = "", uint32_t rawSamplingInterval = 1);
+
+  /**
+   * @brief Helper method to install a summary tracer on a specific simulation node
+   *
+   * @param node Node on which to install tracer
+   * @param summaryStream Smart pointer to a stream for summaries
+   * @param summaryPeriod How often summaries will be written into the stream
+   * @param rawStream Smart pointer to a stream for per-packet delays, can be nullptr
+   * @param rawSamplingInterval Write per-packet delays of only one of every rawSamplingInterval
+   *        received Data
+   */
+  static Ptr<AppDelayTracer>
+  Install(Ptr<Node> node, shared_ptr<std::ostream> summaryStream, Time summaryPeriod,
+          shared_ptr<std::ostream> rawStream = nullptr, uint32_t rawSamplingInterval = 1);
+
   /**
    * @brief Explicit request to remove all statically created tracers
    *
    * This method can be helpful if simulation scenario contains several independent run,
-   * or if it is desired to do a postprocessing of the resulting data
+   * or if it is desired to do a postprocessing of the resulting data.
+   * Summary tracers first write the delays received since their last summary.
    */
   static void
   Destroy();
@@ -114,6 +165,17 @@ public:
    */
   AppDelayTracer(shared_ptr<std::ostream> os, const std::string& node);
 
+  /**
+   * @brief Summary trace constructor that attaches to all applications on the node
+   * @param summaryOs      reference to the output stream for summaries
+   * @param summaryPeriod  how often summaries are written
+   * @param rawOs          reference to the output stream for per-packet delays, can be nullptr
+   * @param rawSamplingInterval  write one of every rawSamplingInterval per-packet delays
+   * @param node           pointer to the node
+   */
+  AppDelayTracer(shared_ptr<std::ostream> summaryOs, Time summaryPeriod,
+                 shared_ptr<std::ostream> rawOs, uint32_t rawSamplingInterval, Ptr<Node> node);
+
   /**
    * @brief Destructor
    */
@@ -127,10 +189,30 @@ public:
   void
   PrintHeader(std::ostream& os) const;
 
+  /**
+   * @brief Print head of the summary trace
+   *
+   * @param os reference to output stream
+   */
+  void
+  PrintSummaryHeader(std::ostream& os) const;
+
 private:
   void
   Connect();
 
+  void
+  PeriodicPrinter();
+
+  /**
+   * @brief Write and reset the summaries of the current period, if any delay was received
+   */
+  void
+  FlushSummaries();
+
+  void
+  PrintSummary(uint32_t appId, const char* type, const DelayHistogram& delays) const;
+
   void
   LastRetransmittedInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay, int32_t hopCount);
 
@@ -143,6 +225,25 @@ private:
   Ptr<Node> m_nodePtr;
 
   shared_ptr<std::ostream> m_os;
+
+  /**
+   * @brief Delays received by one application within the current summary period
+   */
+  struct AppDelays
+  {
+    DelayHistogram lastDelay;
+    DelayHistogram fullDelay;
+  };
+
+  shared_ptr<std::ostream> m_summaryOs; ///< @brief nullptr if summary mode is disabled
+  Time m_summaryPeriod;
+  EventId m_printEvent;
+  EventId m_flushEvent; ///< @brief flushes the last period when the simulation is destroyed
+  std::map<uint32_t, AppDelays> m_appDelays; ///< @brief indexed by application ID
+
+  uint32_t m_rawSamplingInterval;
+  uint32_t m_nLastDelays; ///< @brief number of LastDelay values received, for sampling
+  uint32_t m_nFullDelays; ///< @brief number of FullDelay values received, for sampling
 };
 
 } // namespace ndn
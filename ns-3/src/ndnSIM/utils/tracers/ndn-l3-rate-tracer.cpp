@@ -26,9 +26,11 @@
 #include "ns3/log.h"
 #include "ns3/node-list.h"
 #include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
+#include "ns3/ndnSIM/utils/ndn-stats-sink.hpp"
 
 #include "daemon/table/pit-entry.hpp"
 
+#include <algorithm>
 #include <fstream>
 #include <boost/lexical_cast.hpp>
 
@@ -40,6 +42,53 @@ namespace ndn {
 static std::list<std::tuple<shared_ptr<std::ostream>, std::list<Ptr<L3RateTracer>>>>
   g_tracers;
 
+static const char* const COUNTER_NAMES[] = {
+  "InInterests",
+  "OutInterests",
+  "InData",
+  "OutData",
+  "InNacks",
+  "OutNacks",
+  "InSatisfiedInterests",
+  "InTimedOutInterests",
+  "OutSatisfiedInterests",
+  "OutTimedOutInterests"
+};
+
+static const size_t BINARY_BATCH_SIZE = 4096;
+
+static bool
+isBinaryFile(const std::string& file)
+{
+  static const std::string suffix = ".bin";
+  return file.size() > suffix.size() &&
+         file.compare(file.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+static void
+printHeader(std::ostream& os)
+{
+  os << "Time"
+     << "\t"
+
+     << "Node"
+     << "\t"
+     << "FaceId"
+     << "\t"
+     << "FaceDescr"
+     << "\t"
+
+     << "Type"
+     << "\t"
+     << "Packets"
+     << "\t"
+     << "Kilobytes"
+     << "\t"
+     << "PacketRaw"
+     << "\t"
+     << "KilobytesRaw";
+}
+
 void
 L3RateTracer::Destroy()
 {
@@ -49,47 +98,28 @@ L3RateTracer::Destroy()
 void
 L3RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/)
 {
-  std::list<Ptr<L3RateTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
-  }
-
-  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<L3RateTracer> trace = Install(*node, outputStream, averagingPeriod);
-    tracers.push_back(trace);
-  }
-
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
-  }
-
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  Install(NodeContainer::GetGlobal(), file, averagingPeriod);
 }
 
 void
 L3RateTracer::Install(const NodeContainer& nodes, const std::string& file,
                       Time averagingPeriod /* = Seconds (0.5)*/)
 {
-  using namespace boost;
-  using namespace std;
-
   std::list<Ptr<L3RateTracer>> tracers;
   shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
+  shared_ptr<StatsStream> binaryStream;
+  if (isBinaryFile(file)) {
+    // StatsStream appends to the file
+    std::ofstream os(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+    if (!os.is_open()) {
+      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+      return;
+    }
+
+    binaryStream = make_shared<StatsStream>(file.substr(0, file.size() - 4), BINARY_BATCH_SIZE,
+                                            true);
+  }
+  else if (file != "-") {
     shared_ptr<std::ofstream> os(new std::ofstream());
     os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
 
@@ -105,11 +135,13 @@ L3RateTracer::Install(const NodeContainer& nodes, const std::string& file,
   }
 
   for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
-    Ptr<L3RateTracer> trace = Install(*node, outputStream, averagingPeriod);
+    Ptr<L3RateTracer> trace = binaryStream != nullptr ?
+                              Install(*node, binaryStream, averagingPeriod) :
+                              Install(*node, outputStream, averagingPeriod);
     tracers.push_back(trace);
   }
 
-  if (tracers.size() > 0) {
+  if (outputStream != nullptr && tracers.size() > 0) {
     // *m_l3RateTrace << "# "; // not necessary for R's read.table
     tracers.front()->PrintHeader(*outputStream);
     *outputStream << "\n";
@@ -122,53 +154,45 @@ void
 L3RateTracer::Install(Ptr<Node> node, const std::string& file,
                       Time averagingPeriod /* = Seconds (0.5)*/)
 {
-  using namespace boost;
-  using namespace std;
-
-  std::list<Ptr<L3RateTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
-  }
+  Install(NodeContainer(node), file, averagingPeriod);
+}
 
-  Ptr<L3RateTracer> trace = Install(node, outputStream, averagingPeriod);
-  tracers.push_back(trace);
+Ptr<L3RateTracer>
+L3RateTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
+                      Time averagingPeriod /* = Seconds (0.5)*/)
+{
+  NS_LOG_DEBUG("Node: " << node->GetId());
 
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
-  }
+  Ptr<L3RateTracer> trace = Create<L3RateTracer>(outputStream, node);
+  trace->SetAveragingPeriod(averagingPeriod);
 
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  return trace;
 }
 
 Ptr<L3RateTracer>
-L3RateTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
+L3RateTracer::Install(Ptr<Node> node, shared_ptr<StatsStream> binaryStream,
                       Time averagingPeriod /* = Seconds (0.5)*/)
 {
   NS_LOG_DEBUG("Node: " << node->GetId());
 
-  Ptr<L3RateTracer> trace = Create<L3RateTracer>(outputStream, node);
+  Ptr<L3RateTracer> trace = Create<L3RateTracer>(binaryStream, node);
   trace->SetAveragingPeriod(averagingPeriod);
 
   return trace;
 }
 
+bool
+L3RateTracer::ConvertToText(const std::string& binaryFile, std::ostream& os)
+{
+  printHeader(os);
+  os << "\n";
+  return StatsSink::ConvertToText(binaryFile, os, '\t');
+}
+
 L3RateTracer::L3RateTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
   : L3Tracer(node)
   , m_os(os)
+  , m_hasNodeStats(false)
 {
   SetAveragingPeriod(Seconds(1.0));
 }
@@ -176,6 +200,15 @@ L3RateTracer::L3RateTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
 L3RateTracer::L3RateTracer(shared_ptr<std::ostream> os, const std::string& node)
   : L3Tracer(node)
   , m_os(os)
+  , m_hasNodeStats(false)
+{
+  SetAveragingPeriod(Seconds(1.0));
+}
+
+L3RateTracer::L3RateTracer(shared_ptr<StatsStream> binaryStream, Ptr<Node> node)
+  : L3Tracer(node)
+  , m_binaryStream(binaryStream)
+  , m_hasNodeStats(false)
 {
   SetAveragingPeriod(Seconds(1.0));
 }
@@ -193,211 +226,210 @@ L3RateTracer::SetAveragingPeriod(const Time& period)
   m_printEvent = Simulator::Schedule(m_period, &L3RateTracer::PeriodicPrinter, this);
 }
 
+void
+L3RateTracer::PrintHeader(std::ostream& os) const
+{
+  printHeader(os);
+}
+
 void
 L3RateTracer::PeriodicPrinter()
 {
-  Print(*m_os);
+  UpdateRates();
+
+  if (m_binaryStream != nullptr) {
+    double time = Simulator::Now().ToDouble(Time::S);
+    ForEachRow([&] (int64_t faceId, const std::string& description, const char* type,
+                    double packetRate, double kilobyteRate, uint64_t packets, double kilobytes) {
+        m_binaryStream->record(time, m_node, faceId, description, type,
+                               packetRate, kilobyteRate, packets, kilobytes);
+      });
+  }
+  else {
+    Print(*m_os);
+  }
   Reset();
 
   m_printEvent = Simulator::Schedule(m_period, &L3RateTracer::PeriodicPrinter, this);
 }
 
+
+const double alpha = 0.8;
+
 void
-L3RateTracer::PrintHeader(std::ostream& os) const
+L3RateTracer::UpdateRates()
 {
-  os << "Time"
-     << "\t"
-
-     << "Node"
-     << "\t"
-     << "FaceId"
-     << "\t"
-     << "FaceDescr"
-     << "\t"
+  double period = m_period.ToDouble(Time::S);
+  auto update = [period] (FaceStats& stats) {
+    for (size_t i = 0; i < N_COUNTERS; ++i) {
+      stats.packetRate[i] = /*new value*/ alpha * stats.packets[i] / period
+                            + /*old value*/ (1 - alpha) * stats.packetRate[i];
+      stats.kilobyteRate[i] = /*new value*/ alpha * stats.bytes[i] / period / 1024.0
+                              + /*old value*/ (1 - alpha) * stats.kilobyteRate[i];
+    }
+  };
 
-     << "Type"
-     << "\t"
-     << "Packets"
-     << "\t"
-     << "Kilobytes"
-     << "\t"
-     << "PacketRaw"
-     << "\t"
-     << "KilobytesRaw";
+  update(m_nodeStats);
+  std::for_each(m_reservedFaces.begin(), m_reservedFaces.end(), update);
+  std::for_each(m_faces.begin(), m_faces.end(), update);
 }
 
 void
 L3RateTracer::Reset()
 {
-  for (auto& stats : m_stats) {
-    std::get<0>(stats.second).Reset();
-    std::get<1>(stats.second).Reset();
-  }
+  auto reset = [] (FaceStats& stats) {
+    std::fill_n(stats.packets, N_COUNTERS, 0);
+    std::fill_n(stats.bytes, N_COUNTERS, 0);
+  };
+
+  reset(m_nodeStats);
+  std::for_each(m_reservedFaces.begin(), m_reservedFaces.end(), reset);
+  std::for_each(m_faces.begin(), m_faces.end(), reset);
 }
 
-const double alpha = 0.8;
+template<typename F>
+void
+L3RateTracer::ForEachRow(const F& f) const
+{
+  auto faceRows = [&f] (const FaceStats& stats) {
+    if (stats.faceId == nfd::face::INVALID_FACEID) {
+      return;
+    }
+    for (size_t i = 0; i < N_COUNTERS; ++i) {
+      f(stats.faceId, stats.description, COUNTER_NAMES[i], stats.packetRate[i],
+        stats.kilobyteRate[i], stats.packets[i], stats.bytes[i] / 1024.0);
+    }
+  };
 
-#define STATS(INDEX) std::get<INDEX>(stats.second)
-#define RATE(INDEX, fieldName) STATS(INDEX).fieldName / m_period.ToDouble(Time::S)
-
-#define PRINTER(printName, fieldName)                                                              \
-  STATS(2).fieldName =                                                                             \
-    /*new value*/ alpha * RATE(0, fieldName) + /*old value*/ (1 - alpha) * STATS(2).fieldName;     \
-  STATS(3).fieldName = /*new value*/ alpha * RATE(1, fieldName) / 1024.0                           \
-                       + /*old value*/ (1 - alpha) * STATS(3).fieldName;                           \
-                                                                                                   \
-  os << time.ToDouble(Time::S) << "\t" << m_node << "\t";                                          \
-  if (stats.first != nfd::face::INVALID_FACEID) {                                                  \
-    os << stats.first << "\t";                                                                     \
-    NS_ASSERT(m_faceInfos.find(stats.first) != m_faceInfos.end());                                 \
-    os << m_faceInfos.find(stats.first)->second << "\t";                                           \
-  }                                                                                                \
-  else {                                                                                           \
-    os << "-1\tall\t";                                                                             \
-  }                                                                                                \
-  os << printName << "\t" << STATS(2).fieldName << "\t" << STATS(3).fieldName << "\t"              \
-     << STATS(0).fieldName << "\t" << STATS(1).fieldName / 1024.0 << "\n";
+  std::for_each(m_reservedFaces.begin(), m_reservedFaces.end(), faceRows);
+  std::for_each(m_faces.begin(), m_faces.end(), faceRows);
+
+  if (m_hasNodeStats) {
+    static const std::string ALL = "all";
+    for (Counter i : {IN_SATISFIED_INTERESTS, IN_TIMED_OUT_INTERESTS}) {
+      // node totals are reported without the "In" prefix
+      f(-1, ALL, COUNTER_NAMES[i] + 2, m_nodeStats.packetRate[i], m_nodeStats.kilobyteRate[i],
+        m_nodeStats.packets[i], m_nodeStats.bytes[i] / 1024.0);
+    }
+  }
+}
 
 void
 L3RateTracer::Print(std::ostream& os) const
 {
   Time time = Simulator::Now();
 
-  for (auto& stats : m_stats) {
-    if (stats.first == nfd::face::INVALID_FACEID)
-      continue;
-
-    PRINTER("InInterests", m_inInterests);
-    PRINTER("OutInterests", m_outInterests);
-
-    PRINTER("InData", m_inData);
-    PRINTER("OutData", m_outData);
-
-    PRINTER("InNacks", m_inNack);
-    PRINTER("OutNacks", m_outNack);
-
-    PRINTER("InSatisfiedInterests", m_satisfiedInterests);
-    PRINTER("InTimedOutInterests", m_timedOutInterests);
+  ForEachRow([&] (int64_t faceId, const std::string& description, const char* type,
+                  double packetRate, double kilobyteRate, uint64_t packets, double kilobytes) {
+      os << time.ToDouble(Time::S) << "\t" << m_node << "\t" << faceId << "\t" << description
+         << "\t" << type << "\t" << packetRate << "\t" << kilobyteRate << "\t" << packets
+         << "\t" << kilobytes << "\n";
+    });
+}
 
-    PRINTER("OutSatisfiedInterests", m_outSatisfiedInterests);
-    PRINTER("OutTimedOutInterests", m_outTimedOutInterests);
+L3RateTracer::FaceStats&
+L3RateTracer::GetStats(const Face& face)
+{
+  nfd::FaceId faceId = face.getId();
+  FaceStats* stats = nullptr;
+  if (faceId > nfd::face::FACEID_RESERVED_MAX) {
+    size_t index = faceId - nfd::face::FACEID_RESERVED_MAX - 1;
+    if (index >= m_faces.size()) {
+      m_faces.resize(index + 1);
+    }
+    stats = &m_faces[index];
   }
-
-  {
-    auto i = m_stats.find(nfd::face::INVALID_FACEID);
-    if (i != m_stats.end()) {
-      auto& stats = *i;
-      PRINTER("SatisfiedInterests", m_satisfiedInterests);
-      PRINTER("TimedOutInterests", m_timedOutInterests);
+  else {
+    auto it = std::lower_bound(m_reservedFaces.begin(), m_reservedFaces.end(), faceId,
+                               [] (const FaceStats& stats, nfd::FaceId id) {
+                                 return stats.faceId < id;
+                               });
+    if (it == m_reservedFaces.end() || it->faceId != faceId) {
+      it = m_reservedFaces.emplace(it);
     }
+    stats = &*it;
+  }
+
+  if (stats->faceId == nfd::face::INVALID_FACEID) {
+    stats->faceId = faceId;
+    stats->description = boost::lexical_cast<std::string>(face.getLocalUri());
   }
+  return *stats;
+}
+
+void
+L3RateTracer::Count(const Face& face, Counter counter, size_t nBytes)
+{
+  FaceStats& stats = GetStats(face);
+  stats.packets[counter]++;
+  stats.bytes[counter] += nBytes;
 }
 
 void
 L3RateTracer::OutInterests(const Interest& interest, const Face& face)
 {
-  AddInfo(face);
-  std::get<0>(m_stats[face.getId()]).m_outInterests++;
-  if (interest.hasWire()) {
-    std::get<1>(m_stats[face.getId()]).m_outInterests +=
-      interest.wireEncode().size();
-  }
+  Count(face, OUT_INTERESTS, interest.hasWire() ? interest.wireEncode().size() : 0);
 }
 
 void
 L3RateTracer::InInterests(const Interest& interest, const Face& face)
 {
-  AddInfo(face);
-  std::get<0>(m_stats[face.getId()]).m_inInterests++;
-  if (interest.hasWire()) {
-    std::get<1>(m_stats[face.getId()]).m_inInterests +=
-      interest.wireEncode().size();
-  }
+  Count(face, IN_INTERESTS, interest.hasWire() ? interest.wireEncode().size() : 0);
 }
 
 void
 L3RateTracer::OutData(const Data& data, const Face& face)
 {
-  AddInfo(face);
-  std::get<0>(m_stats[face.getId()]).m_outData++;
-  if (data.hasWire()) {
-    std::get<1>(m_stats[face.getId()]).m_outData +=
-      data.wireEncode().size();
-  }
+  Count(face, OUT_DATA, data.hasWire() ? data.wireEncode().size() : 0);
 }
 
 void
 L3RateTracer::InData(const Data& data, const Face& face)
 {
-  AddInfo(face);
-  std::get<0>(m_stats[face.getId()]).m_inData++;
-  if (data.hasWire()) {
-    std::get<1>(m_stats[face.getId()]).m_inData +=
-      data.wireEncode().size();
-  }
+  Count(face, IN_DATA, data.hasWire() ? data.wireEncode().size() : 0);
 }
 
 void
 L3RateTracer::OutNack(const lp::Nack& nack, const Face& face)
 {
-  AddInfo(face);
-  std::get<0>(m_stats[face.getId()]).m_outNack++;
-  if (nack.getInterest().hasWire()) {
-    std::get<1>(m_stats[face.getId()]).m_outNack +=
-      nack.getInterest().wireEncode().size();
-  }
+  Count(face, OUT_NACKS, nack.getInterest().hasWire() ? nack.getInterest().wireEncode().size() : 0);
 }
 
 void
 L3RateTracer::InNack(const lp::Nack& nack, const Face& face)
 {
-  AddInfo(face);
-  std::get<0>(m_stats[face.getId()]).m_inNack++;
-  if (nack.getInterest().hasWire()) {
-    std::get<1>(m_stats[face.getId()]).m_inNack +=
-      nack.getInterest().wireEncode().size();
-  }
+  Count(face, IN_NACKS, nack.getInterest().hasWire() ? nack.getInterest().wireEncode().size() : 0);
 }
 
 void
 L3RateTracer::SatisfiedInterests(const nfd::pit::Entry& entry, const Face&, const Data&)
 {
-  std::get<0>(m_stats[nfd::face::INVALID_FACEID]).m_satisfiedInterests++;
   // no "size" stats
+  m_hasNodeStats = true;
+  m_nodeStats.packets[IN_SATISFIED_INTERESTS]++;
 
   for (const auto& in : entry.getInRecords()) {
-    AddInfo(in.getFace());
-    std::get<0>(m_stats[(in.getFace()).getId()]).m_satisfiedInterests ++;
+    Count(in.getFace(), IN_SATISFIED_INTERESTS, 0);
   }
 
   for (const auto& out : entry.getOutRecords()) {
-    AddInfo(out.getFace());
-    std::get<0>(m_stats[(out.getFace()).getId()]).m_outSatisfiedInterests ++;
+    Count(out.getFace(), OUT_SATISFIED_INTERESTS, 0);
   }
 }
 
 void
 L3RateTracer::TimedOutInterests(const nfd::pit::Entry& entry)
 {
-  std::get<0>(m_stats[nfd::face::INVALID_FACEID]).m_timedOutInterests++;
   // no "size" stats
+  m_hasNodeStats = true;
+  m_nodeStats.packets[IN_TIMED_OUT_INTERESTS]++;
 
   for (const auto& in : entry.getInRecords()) {
-    AddInfo(in.getFace());
-    std::get<0>(m_stats[(in.getFace()).getId()]).m_timedOutInterests++;
+    Count(in.getFace(), IN_TIMED_OUT_INTERESTS, 0);
   }
 
   for (const auto& out : entry.getOutRecords()) {
-    AddInfo(out.getFace());
-    std::get<0>(m_stats[(out.getFace()).getId()]).m_outTimedOutInterests++;
-  }
-}
-
-void
-L3RateTracer::AddInfo(const Face& face)
-{
-  if (m_faceInfos.find(face.getId()) == m_faceInfos.end()) {
-    m_faceInfos.insert(make_pair(face.getId(), boost::lexical_cast<std::string>(face.getLocalUri())));
+    Count(out.getFace(), OUT_TIMED_OUT_INTERESTS, 0);
   }
 }
 
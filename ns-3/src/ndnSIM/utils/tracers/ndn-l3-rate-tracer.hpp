@@ -28,23 +28,30 @@
 #include "ns3/event-id.h"
 #include "ns3/node-container.h"
 
-#include <tuple>
-#include <map>
 #include <list>
+#include <vector>
 
 namespace ns3 {
 namespace ndn {
 
+class StatsStream;
+
 /**
  * @ingroup ndn-tracers
  * @brief NDN network-layer rate tracer
+ *
+ * Counters of each face are kept in a per-node array indexed by FaceId, so that counting a
+ * packet is an array access.  The trace is written as tab-separated text, or, if the file name
+ * ends with ".bin", in the columnar binary format of StatsStream, with the same columns; such
+ * a file can be converted to the text format with ConvertToText().
  */
 class L3RateTracer : public L3Tracer {
 public:
   /**
    * @brief Helper method to install tracers on all simulation nodes
    *
-   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param file File to which traces will be written.  If filename is -, then std::out is used.
+   *             If filename ends with ".bin", the trace is written in binary format.
    * @param averagingPeriod Defines averaging period for the rate calculation,
    *        as well as how often data will be written into the trace file (default, every half
    *second)
@@ -56,7 +63,8 @@ public:
    * @brief Helper method to install tracers on the selected simulation nodes
    *
    * @param nodes Nodes on which to install tracer
-   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param file File to which traces will be written.  If filename is -, then std::out is used.
+   *             If filename ends with ".bin", the trace is written in binary format.
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *second)
    */
@@ -67,7 +75,8 @@ public:
    * @brief Helper method to install tracers on a specific simulation node
    *
    * @param nodes Nodes on which to install tracer
-   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param file File to which traces will be written.  If filename is -, then std::out is used.
+   *             If filename ends with ".bin", the trace is written in binary format.
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *second)
    */
@@ -83,6 +92,14 @@ public:
   static void
   Destroy();
 
+  /**
+   * @brief Write a trace file in binary format as tab-separated text, as if it had been
+   *        written in text format
+   * @return false if the file cannot be opened or is truncated
+   */
+  static bool
+  ConvertToText(const std::string& binaryFile, std::ostream& os);
+
   /**
    * @brief Trace constructor that attaches to the node using node pointer
    * @param os    reference to the output stream
@@ -97,6 +114,13 @@ public:
    */
   L3RateTracer(shared_ptr<std::ostream> os, const std::string& node);
 
+  /**
+   * @brief Trace constructor that attaches to the node using node pointer
+   * @param binaryStream stream in binary format, can be shared by tracers of several nodes
+   * @param node  pointer to the node
+   */
+  L3RateTracer(shared_ptr<StatsStream> binaryStream, Ptr<Node> node);
+
   /**
    * @brief Destructor
    */
@@ -118,6 +142,13 @@ public:
   Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
           Time averagingPeriod = Seconds(0.5));
 
+  /**
+   * @brief Helper method to install a tracer writing in binary format on a specific node
+   */
+  static Ptr<L3RateTracer>
+  Install(Ptr<Node> node, shared_ptr<StatsStream> binaryStream,
+          Time averagingPeriod = Seconds(0.5));
+
   // from L3Tracer
   virtual void
   PrintHeader(std::ostream& os) const;
@@ -152,25 +183,69 @@ protected:
   TimedOutInterests(const nfd::pit::Entry&);
 
 private:
+  enum Counter {
+    IN_INTERESTS,
+    OUT_INTERESTS,
+    IN_DATA,
+    OUT_DATA,
+    IN_NACKS,
+    OUT_NACKS,
+    IN_SATISFIED_INTERESTS,
+    IN_TIMED_OUT_INTERESTS,
+    OUT_SATISFIED_INTERESTS,
+    OUT_TIMED_OUT_INTERESTS,
+    N_COUNTERS
+  };
+
+  /**
+   * @brief Counters of one face, or totals of the node
+   */
+  struct FaceStats
+  {
+    nfd::FaceId faceId = nfd::face::INVALID_FACEID; ///< @brief INVALID_FACEID if not used
+    std::string description; ///< @brief kept, because face may no longer exist when printed
+
+    uint64_t packets[N_COUNTERS] = {}; ///< @brief number of packets in the current period
+    uint64_t bytes[N_COUNTERS] = {}; ///< @brief number of bytes in the current period
+    double packetRate[N_COUNTERS] = {}; ///< @brief EWMA of packets per second
+    double kilobyteRate[N_COUNTERS] = {}; ///< @brief EWMA of kilobytes per second
+  };
+
   void
   SetAveragingPeriod(const Time& period);
 
   void
   PeriodicPrinter();
 
+  void
+  UpdateRates();
+
   void
   Reset();
 
+  /**
+   * @brief Invoke @p f for each row of the trace, in output order
+   */
+  template<typename F>
+  void
+  ForEachRow(const F& f) const;
+
   void
-  AddInfo(const Face& face);
+  Count(const Face& face, Counter counter, size_t nBytes);
+
+  FaceStats&
+  GetStats(const Face& face);
 
 private:
   shared_ptr<std::ostream> m_os;
+  shared_ptr<StatsStream> m_binaryStream;
   Time m_period;
   EventId m_printEvent;
 
-  mutable std::map<nfd::FaceId, std::tuple<Stats, Stats, Stats, Stats>> m_stats;
-  std::map<nfd::FaceId, std::string> m_faceInfos; // needed, because face may no longer exists at the time of stat printing
+  FaceStats m_nodeStats; ///< @brief SatisfiedInterests and TimedOutInterests of the node
+  bool m_hasNodeStats; ///< @brief whether any Interest has been satisfied or timed out
+  std::vector<FaceStats> m_reservedFaces; ///< @brief faces with reserved FaceIds, sorted by FaceId
+  std::vector<FaceStats> m_faces; ///< @brief indexed by FaceId - FACEID_RESERVED_MAX - 1
 };
 
 } // namespace ndn
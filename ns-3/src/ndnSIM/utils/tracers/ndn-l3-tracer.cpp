@@ -46,6 +46,7 @@ L3Tracer::L3Tracer(Ptr<Node> node)
 
 L3Tracer::L3Tracer(const std::string& node)
   : m_node(node)
+  , m_nodePtr(Names::Find<Node>(node))
 {
   Connect();
 }
@@ -57,19 +58,17 @@ L3Tracer::Connect()
 {
   Ptr<L3Protocol> l3 = m_nodePtr->GetObject<L3Protocol>();
 
-  l3->TraceConnectWithoutContext("OutInterests", MakeCallback(&L3Tracer::OutInterests, this));
-  l3->TraceConnectWithoutContext("InInterests", MakeCallback(&L3Tracer::InInterests, this));
-  l3->TraceConnectWithoutContext("OutData", MakeCallback(&L3Tracer::OutData, this));
-  l3->TraceConnectWithoutContext("InData", MakeCallback(&L3Tracer::InData, this));
-  l3->TraceConnectWithoutContext("OutNack", MakeCallback(&L3Tracer::OutNack, this));
-  l3->TraceConnectWithoutContext("InNack", MakeCallback(&L3Tracer::InNack, this));
+  // same as TraceConnectWithoutContext("OutInterests", ...) etc., without the lookup by name
+  l3->m_outInterests.ConnectWithoutContext(MakeCallback(&L3Tracer::OutInterests, this));
+  l3->m_inInterests.ConnectWithoutContext(MakeCallback(&L3Tracer::InInterests, this));
+  l3->m_outData.ConnectWithoutContext(MakeCallback(&L3Tracer::OutData, this));
+  l3->m_inData.ConnectWithoutContext(MakeCallback(&L3Tracer::InData, this));
+  l3->m_outNack.ConnectWithoutContext(MakeCallback(&L3Tracer::OutNack, this));
+  l3->m_inNack.ConnectWithoutContext(MakeCallback(&L3Tracer::InNack, this));
 
   // satisfied/timed out PIs
-  l3->TraceConnectWithoutContext("SatisfiedInterests",
-                                 MakeCallback(&L3Tracer::SatisfiedInterests, this));
-
-  l3->TraceConnectWithoutContext("TimedOutInterests",
-                                 MakeCallback(&L3Tracer::TimedOutInterests, this));
+  l3->m_satisfiedInterests.ConnectWithoutContext(MakeCallback(&L3Tracer::SatisfiedInterests, this));
+  l3->m_timedOutInterests.ConnectWithoutContext(MakeCallback(&L3Tracer::TimedOutInterests, this));
 }
 
 } // namespace ndn
@@ -0,0 +1,148 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-memory-tracer.hpp"
+#include "ns3/node.h"
+#include "ns3/names.h"
+#include "ns3/simulator.h"
+#include "ns3/node-list.h"
+#include "ns3/log.h"
+
+#include "model/ndn-l3-protocol.hpp"
+#include "utils/ndn-memory-usage.hpp"
+
+#include <boost/lexical_cast.hpp>
+
+#include <fstream>
+#include <list>
+
+NS_LOG_COMPONENT_DEFINE("ndn.MemoryTracer");
+
+namespace ns3 {
+namespace ndn {
+
+static std::list<Ptr<MemoryTracer>> g_tracers;
+
+void
+MemoryTracer::Destroy()
+{
+  g_tracers.clear();
+}
+
+void
+MemoryTracer::InstallAll(const std::string& file, Time period /* = Seconds (1.0)*/)
+{
+  NodeContainer nodes;
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    nodes.Add(*node);
+  }
+
+  Install(nodes, file, period);
+}
+
+void
+MemoryTracer::Install(const NodeContainer& nodes, const std::string& file,
+                      Time period /* = Seconds (1.0)*/)
+{
+  shared_ptr<std::ostream> outputStream;
+  if (file != "-") {
+    shared_ptr<std::ofstream> os(new std::ofstream());
+    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+
+    if (!os->is_open()) {
+      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+      return;
+    }
+
+    outputStream = os;
+  }
+  else {
+    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  }
+
+  Ptr<MemoryTracer> trace = Create<MemoryTracer>(outputStream, nodes, period);
+  trace->PrintHeader(*outputStream);
+  *outputStream << "\n";
+
+  g_tracers.push_back(trace);
+}
+
+MemoryTracer::MemoryTracer(shared_ptr<std::ostream> os, const NodeContainer& nodes, Time period)
+  : m_os(os)
+  , m_period(period)
+{
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    Ptr<L3Protocol> l3 = (*node)->GetObject<L3Protocol>();
+    if (l3 == nullptr) {
+      continue;
+    }
+
+    std::string name = Names::FindName(*node);
+    if (name.empty()) {
+      name = boost::lexical_cast<std::string>((*node)->GetId());
+    }
+    m_stacks.emplace_back(name, l3);
+  }
+
+  m_printEvent = Simulator::Schedule(m_period, &MemoryTracer::PeriodicPrinter, this);
+}
+
+MemoryTracer::~MemoryTracer()
+{
+  m_printEvent.Cancel();
+}
+
+void
+MemoryTracer::PrintHeader(std::ostream& os) const
+{
+  os << "Time"
+     << "\t"
+     << "Node"
+     << "\t"
+     << "Table"
+     << "\t"
+     << "Objects"
+     << "\t"
+     << "Bytes";
+}
+
+void
+MemoryTracer::PeriodicPrinter()
+{
+  double time = Simulator::Now().ToDouble(Time::S);
+  const std::string* node = nullptr;
+  auto printRow = [&] (const char* table, const MemoryCounter& counter) {
+    *m_os << time << "\t" << *node << "\t" << table << "\t" << counter.nObjects << "\t"
+          << counter.nBytes << "\n";
+  };
+
+  for (const auto& stack : m_stacks) {
+    node = &stack.first;
+    stack.second->getTableMemoryUsage().forEach(printRow);
+  }
+
+  static const std::string ALL = "all";
+  node = &ALL;
+  ProcessMemoryUsage::get().forEach(printRow);
+
+  m_printEvent = Simulator::Schedule(m_period, &MemoryTracer::PeriodicPrinter, this);
+}
+
+} // namespace ndn
+} // namespace ns3
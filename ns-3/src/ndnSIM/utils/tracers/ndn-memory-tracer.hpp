@@ -0,0 +1,114 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_MEMORY_TRACER_H
+#define NDN_MEMORY_TRACER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+#include "ns3/node-container.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ns3 {
+
+class Node;
+
+namespace ndn {
+
+class L3Protocol;
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Tracer of the memory used by NDN tables and by the simulation process
+ *
+ * Periodically writes the number of objects and bytes of each table of each node (see
+ * TableMemoryUsage), followed by process-wide counters (see ProcessMemoryUsage) with "all" as
+ * node.  Nothing is counted between snapshots, so that the tracer costs nothing when it is not
+ * installed.
+ */
+class MemoryTracer : public SimpleRefCount<MemoryTracer> {
+public:
+  /**
+   * @brief Helper method to install the tracer on all simulation nodes
+   *
+   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param period How often snapshots will be written into the trace file
+   */
+  static void
+  InstallAll(const std::string& file, Time period = Seconds(1.0));
+
+  /**
+   * @brief Helper method to install the tracer on the selected simulation nodes
+   *
+   * @param nodes Nodes on which to install tracer
+   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param period How often snapshots will be written into the trace file
+   */
+  static void
+  Install(const NodeContainer& nodes, const std::string& file, Time period = Seconds(1.0));
+
+  /**
+   * @brief Explicit request to remove all statically created tracers
+   *
+   * This method can be helpful if simulation scenario contains several independent run,
+   * or if it is desired to do a postprocessing of the resulting data
+   */
+  static void
+  Destroy();
+
+  /**
+   * @brief Trace constructor that attaches to the NDN stacks of the nodes
+   * @param os     reference to the output stream
+   * @param nodes  nodes with NDN stack
+   * @param period how often snapshots are written
+   */
+  MemoryTracer(shared_ptr<std::ostream> os, const NodeContainer& nodes, Time period);
+
+  ~MemoryTracer();
+
+  /**
+   * @brief Print head of the trace (e.g., for post-processing)
+   *
+   * @param os reference to output stream
+   */
+  void
+  PrintHeader(std::ostream& os) const;
+
+private:
+  void
+  PeriodicPrinter();
+
+private:
+  shared_ptr<std::ostream> m_os;
+  std::vector<std::pair<std::string, Ptr<L3Protocol>>> m_stacks; ///< @brief node name and stack
+  Time m_period;
+  EventId m_printEvent;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_MEMORY_TRACER_H
@@ -196,7 +196,7 @@ public:
     trie* trieNode = this;
 
     BOOST_FOREACH (const Key& subkey, key) {
-      typename unordered_set::iterator item = trieNode->children_.find(subkey);
+      typename unordered_set::iterator item = trieNode->find_child(subkey);
       if (item == trieNode->children_.end()) {
         trie* newNode = new trie(subkey, initialBucketSize_, bucketIncrement_);
         // std::cout << "new " << newNode << "\n";
@@ -295,7 +295,7 @@ public:
     bool reachLast = true;
 
     BOOST_FOREACH (const Key& subkey, key) {
-      typename unordered_set::iterator item = trieNode->children_.find(subkey);
+      typename unordered_set::iterator item = trieNode->find_child(subkey);
       if (item == trieNode->children_.end()) {
         reachLast = false;
         break;
@@ -326,7 +326,7 @@ public:
     bool reachLast = true;
 
     BOOST_FOREACH (const Key& subkey, key) {
-      typename unordered_set::iterator item = trieNode->children_.find(subkey);
+      typename unordered_set::iterator item = trieNode->find_child(subkey);
       if (item == trieNode->children_.end()) {
         reachLast = false;
         break;
@@ -492,6 +492,35 @@ private:
   typedef typename unordered_set::bucket_type bucket_type;
   typedef typename unordered_set::bucket_traits bucket_traits;
 
+  // hash and compare a name component with trie nodes, without constructing a temporary node
+  struct key_hash {
+    std::size_t
+    operator()(const Key& key) const
+    {
+      return boost::hash_value(key);
+    }
+  };
+
+  struct key_equal {
+    bool
+    operator()(const Key& key, const trie& trie_node) const
+    {
+      return key == trie_node.key_;
+    }
+
+    bool
+    operator()(const trie& trie_node, const Key& key) const
+    {
+      return key == trie_node.key_;
+    }
+  };
+
+  typename unordered_set::iterator
+  find_child(const Key& key)
+  {
+    return children_.find(key, key_hash(), key_equal());
+  }
+
   template<class T, class NonConstT>
   friend class trie_iterator;
 
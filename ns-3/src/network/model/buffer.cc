@@ -20,6 +20,7 @@
 #include "buffer.h"
 #include "ns3/assert.h"
 #include "ns3/log.h"
+#include <algorithm>
 
 #define LOG_INTERNAL_STATE(y)                                                                    \
   NS_LOG_LOGIC (y << "start="<<m_start<<", end="<<m_end<<", zero start="<<m_zeroAreaStart<<              \
@@ -51,6 +52,8 @@ NS_LOG_COMPONENT_DEFINE ("Buffer");
 
 
 uint32_t Buffer::g_recommendedStart = 0;
+uint64_t Buffer::g_nAllocatedData = 0;
+uint64_t Buffer::g_allocatedDataBytes = 0;
 #ifdef BUFFER_FREE_LIST
 /* The following macros are pretty evil but they are needed to allow us to
  * keep track of 3 possible states for the g_freeList variable:
@@ -159,6 +162,18 @@ Buffer::Create (uint32_t size)
 }
 #endif /* BUFFER_FREE_LIST */
 
+uint64_t
+Buffer::GetNAllocatedData (void)
+{
+  return g_nAllocatedData;
+}
+
+uint64_t
+Buffer::GetAllocatedDataBytes (void)
+{
+  return g_allocatedDataBytes;
+}
+
 struct Buffer::Data *
 Buffer::Allocate (uint32_t reqSize)
 {
@@ -173,6 +188,8 @@ Buffer::Allocate (uint32_t reqSize)
   struct Buffer::Data *data = reinterpret_cast<struct Buffer::Data*>(b);
   data->m_size = reqSize;
   data->m_count = 1;
+  g_nAllocatedData++;
+  g_allocatedDataBytes += size;
   return data;
 }
 
@@ -181,6 +198,8 @@ Buffer::Deallocate (struct Buffer::Data *data)
 {
   NS_LOG_FUNCTION (data);
   NS_ASSERT (data->m_count == 0);
+  g_nAllocatedData--;
+  g_allocatedDataBytes -= data->m_size - 1 + sizeof (struct Buffer::Data);
   uint8_t *buf = reinterpret_cast<uint8_t *> (data);
   delete [] buf;
 }
@@ -1126,9 +1145,32 @@ void
 Buffer::Iterator::Read (uint8_t *buffer, uint32_t size)
 {
   NS_LOG_FUNCTION (this << &buffer << size);
-  for (uint32_t i = 0; i < size; i++)
+  NS_ASSERT_MSG (m_current >= m_dataStart &&
+                 m_current + size <= m_dataEnd,
+                 GetReadErrorMessage ());
+  // copy the requested range in at most three chunks: the data before the
+  // "virtual zero area", the zero area itself, and the data after it.
+  while (size > 0)
     {
-      buffer[i] = ReadU8 ();
+      uint32_t chunk;
+      if (m_current < m_zeroStart)
+        {
+          chunk = std::min (size, m_zeroStart - m_current);
+          memcpy (buffer, m_data + m_current, chunk);
+        }
+      else if (m_current < m_zeroEnd)
+        {
+          chunk = std::min (size, m_zeroEnd - m_current);
+          memset (buffer, 0, chunk);
+        }
+      else
+        {
+          chunk = size;
+          memcpy (buffer, m_data + m_current - (m_zeroEnd - m_zeroStart), chunk);
+        }
+      buffer += chunk;
+      size -= chunk;
+      m_current += chunk;
     }
 }
 
@@ -642,6 +642,17 @@ private:
    */
   Buffer (uint32_t dataSize, bool initialize);
   ~Buffer ();
+
+  /**
+   * \returns the number of data storage areas currently allocated by all
+   *          buffers, including those kept in the free list for reuse
+   */
+  static uint64_t GetNAllocatedData (void);
+  /**
+   * \returns the number of bytes currently allocated for data storage areas
+   *          by all buffers, including those kept in the free list for reuse
+   */
+  static uint64_t GetAllocatedDataBytes (void);
 private:
   /**
    * This data structure is variable-sized through its last member whose size
@@ -790,6 +801,9 @@ private:
    */
   uint32_t m_end;
 
+  static uint64_t g_nAllocatedData; //!< Number of allocated data storage areas
+  static uint64_t g_allocatedDataBytes; //!< Bytes of allocated data storage areas
+
 #ifdef BUFFER_FREE_LIST
   /// Container for buffer data
   typedef std::vector<struct Buffer::Data*> FreeList;
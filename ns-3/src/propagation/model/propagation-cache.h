@@ -21,7 +21,9 @@
 #define PROPAGATION_CACHE_H_
 
 #include "ns3/mobility-model.h"
+#include <cmath>
 #include <map>
+#include <unordered_map>
 
 namespace ns3
 {
@@ -122,6 +124,187 @@ private:
 private:
   PathCache m_pathCache; //!< Path cache
 };
+
+/**
+ * \ingroup propagation
+ * \brief Cache of the path loss (dB) of deterministic propagation loss models.
+ *
+ * The positions of the two nodes of a path are quantized to a grid of
+ * the given resolution (m).  A cached loss is reused as long as both
+ * nodes stay in the grid cells they were in when the loss was stored,
+ * i.e., the loss is approximated with an error bounded by the change of
+ * the loss over a distance of twice the cell diagonal.  As in
+ * PropagationCache, paths a-->b and b-->a are the same thing.
+ *
+ * The cache holds one entry per path that has been used, so its size is
+ * bounded by the square of the number of nodes.
+ */
+class PathLossCache
+{
+public:
+  PathLossCache ()
+    : m_resolution (0)
+  {
+  }
+
+  /**
+   * Set the size of the grid cells and drop all cached losses
+   * \param resolution the size (m) of the grid cells; 0 disables the cache
+   */
+  void SetResolution (double resolution)
+  {
+    m_resolution = resolution;
+    m_pathCache.clear ();
+  }
+
+  /**
+   * \return the size (m) of the grid cells; 0 if the cache is disabled
+   */
+  double GetResolution (void) const
+  {
+    return m_resolution;
+  }
+
+  /**
+   * Look up the loss of a path
+   * \param a 1st node mobility model
+   * \param aPosition current position of the 1st node
+   * \param b 2nd node mobility model
+   * \param bPosition current position of the 2nd node
+   * \param lossDb set to the cached loss (dB) on success
+   * \return true if a loss was stored for the grid cells of both positions
+   */
+  bool Lookup (Ptr<const MobilityModel> a, const Vector &aPosition,
+               Ptr<const MobilityModel> b, const Vector &bPosition, double &lossDb) const
+  {
+    if (m_resolution <= 0)
+      {
+        return false;
+      }
+    PathIdentifier key (a, b);
+    PathCache::const_iterator it = m_pathCache.find (key);
+    if (it == m_pathCache.end ())
+      {
+        return false;
+      }
+    bool isSwapped = key.m_first != a;
+    if (it->second.m_first != GetCell (isSwapped ? bPosition : aPosition)
+        || it->second.m_second != GetCell (isSwapped ? aPosition : bPosition))
+      {
+        return false;
+      }
+    lossDb = it->second.m_lossDb;
+    return true;
+  }
+
+  /**
+   * Store the loss of a path, replacing the loss stored for other grid cells
+   * \param a 1st node mobility model
+   * \param aPosition position of the 1st node the loss was computed for
+   * \param b 2nd node mobility model
+   * \param bPosition position of the 2nd node the loss was computed for
+   * \param lossDb the loss (dB)
+   */
+  void Store (Ptr<const MobilityModel> a, const Vector &aPosition,
+              Ptr<const MobilityModel> b, const Vector &bPosition, double lossDb)
+  {
+    if (m_resolution <= 0)
+      {
+        return;
+      }
+    PathIdentifier key (a, b);
+    bool isSwapped = key.m_first != a;
+    PathData &data = m_pathCache[key];
+    data.m_first = GetCell (isSwapped ? bPosition : aPosition);
+    data.m_second = GetCell (isSwapped ? aPosition : bPosition);
+    data.m_lossDb = lossDb;
+  }
+
+private:
+  /// Index of a grid cell
+  struct Cell
+  {
+    int64_t x; //!< index along the x axis
+    int64_t y; //!< index along the y axis
+    int64_t z; //!< index along the z axis
+
+    /**
+     * \param other the cell to compare with
+     * \return true if the cells are different
+     */
+    bool operator != (const Cell &other) const
+    {
+      return x != other.x || y != other.y || z != other.z;
+    }
+  };
+
+  /**
+   * \param position the position
+   * \return the grid cell containing the position
+   */
+  Cell GetCell (const Vector &position) const
+  {
+    Cell cell;
+    cell.x = static_cast<int64_t> (std::floor (position.x / m_resolution));
+    cell.y = static_cast<int64_t> (std::floor (position.y / m_resolution));
+    cell.z = static_cast<int64_t> (std::floor (position.z / m_resolution));
+    return cell;
+  }
+
+  /// Each path is identified by its two mobility models, in pointer order
+  struct PathIdentifier
+  {
+    /**
+     * Constructor
+     * @param a 1st node mobility model
+     * @param b 2nd node mobility model
+     */
+    PathIdentifier (Ptr<const MobilityModel> a, Ptr<const MobilityModel> b)
+      : m_first (std::min (a, b)), m_second (std::max (a, b))
+    {
+    }
+    Ptr<const MobilityModel> m_first;  //!< mobility model with the lower address
+    Ptr<const MobilityModel> m_second; //!< mobility model with the higher address
+
+    /**
+     * \param other Right value of the operator.
+     * \returns True if both identifiers refer to the same path.
+     */
+    bool operator == (const PathIdentifier &other) const
+    {
+      return m_first == other.m_first && m_second == other.m_second;
+    }
+  };
+
+  /// Hash of a PathIdentifier
+  struct PathIdentifierHash
+  {
+    /**
+     * \param key the path identifier
+     * \return the hash of both mobility model addresses
+     */
+    size_t operator () (const PathIdentifier &key) const
+    {
+      size_t first = std::hash<const MobilityModel *> () (PeekPointer (key.m_first));
+      size_t second = std::hash<const MobilityModel *> () (PeekPointer (key.m_second));
+      return first ^ (second + 0x9e3779b9 + (first << 6) + (first >> 2));
+    }
+  };
+
+  /// Cached loss of a path, with the grid cells of m_first and m_second of the PathIdentifier
+  struct PathData
+  {
+    Cell m_first;    //!< cell of the 1st node of the path
+    Cell m_second;   //!< cell of the 2nd node of the path
+    double m_lossDb; //!< loss (dB)
+  };
+
+  /// Typedef: PathIdentifier, PathData
+  typedef std::unordered_map<PathIdentifier, PathData, PathIdentifierHash> PathCache;
+
+  double m_resolution;   //!< size (m) of the grid cells
+  PathCache m_pathCache; //!< Path cache
+};
 } // namespace ns3
 
 #endif // PROPAGATION_CACHE_H_
@@ -82,6 +82,30 @@ PropagationLossModel::CalcRxPower (double txPowerDbm,
   return self;
 }
 
+void
+PropagationLossModel::CalcRxPower (double txPowerDbm,
+                                   Ptr<MobilityModel> a,
+                                   const std::vector<Ptr<MobilityModel> > &receivers,
+                                   std::vector<double> &rxPowerDbm) const
+{
+  rxPowerDbm.assign (receivers.size (), txPowerDbm);
+  for (const PropagationLossModel *model = this; model != 0; model = PeekPointer (model->m_next))
+    {
+      model->DoCalcRxPowers (a, receivers, rxPowerDbm);
+    }
+}
+
+void
+PropagationLossModel::DoCalcRxPowers (Ptr<MobilityModel> a,
+                                      const std::vector<Ptr<MobilityModel> > &receivers,
+                                      std::vector<double> &powerDbm) const
+{
+  for (size_t i = 0; i < receivers.size (); i++)
+    {
+      powerDbm[i] = DoCalcRxPower (powerDbm[i], a, receivers[i]);
+    }
+}
+
 int64_t
 PropagationLossModel::AssignStreams (int64_t stream)
 {
@@ -586,6 +610,14 @@ ThreeLogDistancePropagationLossModel::GetTypeId (void)
                    DoubleValue (46.6777),
                    MakeDoubleAccessor (&ThreeLogDistancePropagationLossModel::m_referenceLoss),
                    MakeDoubleChecker<double> ())
+    .AddAttribute ("CacheResolution",
+                   "Size (m) of the grid cells used to cache the path loss between two nodes; "
+                   "a cached loss is reused while both nodes stay in their cells. "
+                   "0 disables the cache.",
+                   DoubleValue (0.0),
+                   MakeDoubleAccessor (&ThreeLogDistancePropagationLossModel::SetCacheResolution,
+                                       &ThreeLogDistancePropagationLossModel::GetCacheResolution),
+                   MakeDoubleChecker<double> (0.0))
   ;
   return tid;
 
@@ -595,17 +627,32 @@ ThreeLogDistancePropagationLossModel::ThreeLogDistancePropagationLossModel ()
 {
 }
 
-double 
-ThreeLogDistancePropagationLossModel::DoCalcRxPower (double txPowerDbm,
-                                                     Ptr<MobilityModel> a,
-                                                     Ptr<MobilityModel> b) const
+void
+ThreeLogDistancePropagationLossModel::SetCacheResolution (double resolution)
 {
-  double distance = a->GetDistanceFrom (b);
-  NS_ASSERT (distance >= 0);
+  m_cache.SetResolution (resolution);
+}
 
-  // See doxygen comments for the formula and explanation
+double
+ThreeLogDistancePropagationLossModel::GetCacheResolution (void) const
+{
+  return m_cache.GetResolution ();
+}
 
+double
+ThreeLogDistancePropagationLossModel::GetLoss (Ptr<MobilityModel> a, const Vector &aPosition,
+                                               Ptr<MobilityModel> b, const Vector &bPosition) const
+{
   double pathLossDb;
+  if (m_cache.Lookup (a, aPosition, b, bPosition, pathLossDb))
+    {
+      return pathLossDb;
+    }
+
+  double distance = CalculateDistance (aPosition, bPosition);
+  NS_ASSERT (distance >= 0);
+
+  // See doxygen comments for the formula and explanation
 
   if (distance < m_distance0)
     {
@@ -633,7 +680,28 @@ ThreeLogDistancePropagationLossModel::DoCalcRxPower (double txPowerDbm,
   NS_LOG_DEBUG ("ThreeLogDistance distance=" << distance << "m, " <<
                 "attenuation=" << pathLossDb << "dB");
 
-  return txPowerDbm - pathLossDb;
+  m_cache.Store (a, aPosition, b, bPosition, pathLossDb);
+  return pathLossDb;
+}
+
+double 
+ThreeLogDistancePropagationLossModel::DoCalcRxPower (double txPowerDbm,
+                                                     Ptr<MobilityModel> a,
+                                                     Ptr<MobilityModel> b) const
+{
+  return txPowerDbm - GetLoss (a, a->GetPosition (), b, b->GetPosition ());
+}
+
+void
+ThreeLogDistancePropagationLossModel::DoCalcRxPowers (Ptr<MobilityModel> a,
+                                                      const std::vector<Ptr<MobilityModel> > &receivers,
+                                                      std::vector<double> &powerDbm) const
+{
+  Vector aPosition = a->GetPosition ();
+  for (size_t i = 0; i < receivers.size (); i++)
+    {
+      powerDbm[i] -= GetLoss (a, aPosition, receivers[i], receivers[i]->GetPosition ());
+    }
 }
 
 int64_t
@@ -701,10 +769,27 @@ double
 NakagamiPropagationLossModel::DoCalcRxPower (double txPowerDbm,
                                              Ptr<MobilityModel> a,
                                              Ptr<MobilityModel> b) const
+{
+  return GetFadedPower (txPowerDbm, a->GetDistanceFrom (b));
+}
+
+void
+NakagamiPropagationLossModel::DoCalcRxPowers (Ptr<MobilityModel> a,
+                                              const std::vector<Ptr<MobilityModel> > &receivers,
+                                              std::vector<double> &powerDbm) const
+{
+  Vector aPosition = a->GetPosition ();
+  for (size_t i = 0; i < receivers.size (); i++)
+    {
+      powerDbm[i] = GetFadedPower (powerDbm[i], CalculateDistance (aPosition, receivers[i]->GetPosition ()));
+    }
+}
+
+double
+NakagamiPropagationLossModel::GetFadedPower (double txPowerDbm, double distance) const
 {
   // select m parameter
 
-  double distance = a->GetDistanceFrom (b);
   NS_ASSERT (distance >= 0);
 
   double m;
@@ -720,7 +805,6 @@ NakagamiPropagationLossModel::DoCalcRxPower (double txPowerDbm,
     {
       m = m_m2;
     }
-
   // the current power unit is dBm, but Watt is put into the Nakagami /
   // Rayleigh distribution.
   double powerW = std::pow (10, (txPowerDbm - 30) / 10);
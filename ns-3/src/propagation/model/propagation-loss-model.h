@@ -27,7 +27,9 @@
 
 #include "ns3/object.h"
 #include "ns3/random-variable-stream.h"
+#include "propagation-cache.h"
 #include <map>
+#include <vector>
 
 namespace ns3 {
 
@@ -93,6 +95,26 @@ public:
                       Ptr<MobilityModel> a,
                       Ptr<MobilityModel> b) const;
 
+  /**
+   * Returns the Rx Power at each of several receivers of one transmission,
+   * taking into account all the PropagationLossModel(s) chained to the
+   * current one.
+   *
+   * Each model of the chain processes all receivers before the next model
+   * does.  For every model, the receivers are processed in order, so the
+   * random variables of the models are drawn in the same order as with
+   * one CalcRxPower call per receiver.
+   *
+   * \param txPowerDbm current transmission power (in dBm)
+   * \param a the mobility model of the source
+   * \param receivers the mobility models of the destinations
+   * \param rxPowerDbm set to the reception power at each destination (in dBm)
+   */
+  void CalcRxPower (double txPowerDbm,
+                    Ptr<MobilityModel> a,
+                    const std::vector<Ptr<MobilityModel> > &receivers,
+                    std::vector<double> &rxPowerDbm) const;
+
   /**
    * If this loss model uses objects of type RandomVariableStream,
    * set the stream numbers to the integers starting with the offset
@@ -134,6 +156,20 @@ private:
                                 Ptr<MobilityModel> a,
                                 Ptr<MobilityModel> b) const = 0;
 
+  /**
+   * Applies only the particular PropagationLossModel to the power at each
+   * of several receivers.  The default implementation calls DoCalcRxPower
+   * for each receiver; subclasses can override it to share the work that
+   * only depends on the source.
+   *
+   * \param a the mobility model of the source
+   * \param receivers the mobility models of the destinations
+   * \param powerDbm the power at each destination (in dBm), updated in place
+   */
+  virtual void DoCalcRxPowers (Ptr<MobilityModel> a,
+                               const std::vector<Ptr<MobilityModel> > &receivers,
+                               std::vector<double> &powerDbm) const;
+
   /**
    * Subclasses must implement this; those not using random variables
    * can return zero
@@ -594,6 +630,18 @@ public:
 
   // Parameters are all accessible via attributes.
 
+  /**
+   * \param resolution the size (m) of the grid cells used by the path loss
+   *        cache; 0 disables the cache
+   *
+   * \sa PathLossCache
+   */
+  void SetCacheResolution (double resolution);
+  /**
+   * \return the size (m) of the grid cells used by the path loss cache
+   */
+  double GetCacheResolution (void) const;
+
 private:
   /**
    * \brief Copy constructor
@@ -612,8 +660,21 @@ private:
   virtual double DoCalcRxPower (double txPowerDbm,
                                 Ptr<MobilityModel> a,
                                 Ptr<MobilityModel> b) const;
+  virtual void DoCalcRxPowers (Ptr<MobilityModel> a,
+                               const std::vector<Ptr<MobilityModel> > &receivers,
+                               std::vector<double> &powerDbm) const;
   virtual int64_t DoAssignStreams (int64_t stream);
 
+  /**
+   * \param a the mobility model of the source
+   * \param aPosition the position of the source
+   * \param b the mobility model of the destination
+   * \param bPosition the position of the destination
+   * \returns the path loss (dB), from the cache if possible
+   */
+  double GetLoss (Ptr<MobilityModel> a, const Vector &aPosition,
+                  Ptr<MobilityModel> b, const Vector &bPosition) const;
+
   double m_distance0; //!< Beginning of the first (near) distance field
   double m_distance1; //!< Beginning of the second (middle) distance field.
   double m_distance2; //!< Beginning of the third (far) distance field.
@@ -623,6 +684,8 @@ private:
   double m_exponent2; //!< The exponent for the third field.
 
   double m_referenceLoss; //!< The reference loss at distance d0 (dB).
+
+  mutable PathLossCache m_cache; //!< Path loss cache
 };
 
 /**
@@ -683,8 +746,18 @@ private:
   virtual double DoCalcRxPower (double txPowerDbm,
                                 Ptr<MobilityModel> a,
                                 Ptr<MobilityModel> b) const;
+  virtual void DoCalcRxPowers (Ptr<MobilityModel> a,
+                               const std::vector<Ptr<MobilityModel> > &receivers,
+                               std::vector<double> &powerDbm) const;
   virtual int64_t DoAssignStreams (int64_t stream);
 
+  /**
+   * \param txPowerDbm the power before fading (in dBm)
+   * \param distance the distance between the source and the destination (m)
+   * \returns the power after fading (in dBm)
+   */
+  double GetFadedPower (double txPowerDbm, double distance) const;
+
   double m_distance1; //!< Distance1
   double m_distance2; //!< Distance2
 
@@ -436,6 +436,94 @@ RangePropagationLossModelTestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+class ThreeLogDistanceNakagamiBatchTestCase : public TestCase
+{
+public:
+  ThreeLogDistanceNakagamiBatchTestCase ();
+  virtual ~ThreeLogDistanceNakagamiBatchTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \param cacheResolution the CacheResolution of the ThreeLogDistancePropagationLossModel
+   * \param stream the random variable stream of the NakagamiPropagationLossModel
+   * \return a ThreeLogDistancePropagationLossModel chained with a NakagamiPropagationLossModel
+   */
+  Ptr<PropagationLossModel> CreateChain (double cacheResolution, int64_t stream);
+};
+
+ThreeLogDistanceNakagamiBatchTestCase::ThreeLogDistanceNakagamiBatchTestCase ()
+  : TestCase ("Test batch and cached evaluation of ThreeLogDistance + Nakagami")
+{
+}
+
+ThreeLogDistanceNakagamiBatchTestCase::~ThreeLogDistanceNakagamiBatchTestCase ()
+{
+}
+
+Ptr<PropagationLossModel>
+ThreeLogDistanceNakagamiBatchTestCase::CreateChain (double cacheResolution, int64_t stream)
+{
+  Ptr<ThreeLogDistancePropagationLossModel> threeLog = CreateObject<ThreeLogDistancePropagationLossModel> ();
+  threeLog->SetAttribute ("CacheResolution", DoubleValue (cacheResolution));
+  threeLog->SetNext (CreateObject<NakagamiPropagationLossModel> ());
+  threeLog->AssignStreams (stream);
+  return threeLog;
+}
+
+void
+ThreeLogDistanceNakagamiBatchTestCase::DoRun (void)
+{
+  Ptr<MobilityModel> a = CreateObject<ConstantPositionMobilityModel> ();
+  a->SetPosition (Vector (0,0,0));
+  std::vector<Ptr<MobilityModel> > receivers;
+  double distances[] = { 0.5, 50, 250, 700, 1200 };
+  for (uint32_t i = 0; i < sizeof (distances) / sizeof (distances[0]); i++)
+    {
+      Ptr<MobilityModel> b = CreateObject<ConstantPositionMobilityModel> ();
+      b->SetPosition (Vector (distances[i],0,0));
+      receivers.push_back (b);
+    }
+
+  double txPwrdBm = 20.0;
+  double tolerance = 1e-9;
+
+  // the batch evaluation draws the same random numbers as one call per receiver
+  Ptr<PropagationLossModel> sequential = CreateChain (0, 1);
+  Ptr<PropagationLossModel> batch = CreateChain (0, 1);
+  Ptr<PropagationLossModel> cached = CreateChain (1.0, 1);
+  for (uint32_t round = 0; round < 3; round++)
+    {
+      std::vector<double> batchdBm;
+      batch->CalcRxPower (txPwrdBm, a, receivers, batchdBm);
+      std::vector<double> cacheddBm;
+      cached->CalcRxPower (txPwrdBm, a, receivers, cacheddBm);
+      NS_TEST_ASSERT_MSG_EQ (batchdBm.size (), receivers.size (), "Got unexpected number of rcv powers");
+      for (uint32_t i = 0; i < receivers.size (); i++)
+        {
+          double resultdBm = sequential->CalcRxPower (txPwrdBm, a, receivers[i]);
+          NS_TEST_EXPECT_MSG_EQ_TOL (batchdBm[i], resultdBm, tolerance, "Got unexpected rcv power");
+          NS_TEST_EXPECT_MSG_EQ_TOL (cacheddBm[i], resultdBm, tolerance, "Got unexpected cached rcv power");
+        }
+    }
+
+  // the cached loss is reused within the grid cell, and recomputed outside of it
+  Ptr<ThreeLogDistancePropagationLossModel> threeLog = CreateObject<ThreeLogDistancePropagationLossModel> ();
+  threeLog->SetAttribute ("CacheResolution", DoubleValue (10.0));
+  Ptr<MobilityModel> b = CreateObject<ConstantPositionMobilityModel> ();
+  b->SetPosition (Vector (301,0,0));
+  double resultdBm = threeLog->CalcRxPower (txPwrdBm, a, b);
+  b->SetPosition (Vector (309,0,0));
+  NS_TEST_EXPECT_MSG_EQ_TOL (threeLog->CalcRxPower (txPwrdBm, a, b), resultdBm, tolerance, "Loss should be cached");
+  NS_TEST_EXPECT_MSG_EQ_TOL (threeLog->CalcRxPower (txPwrdBm, b, a), resultdBm, tolerance, "Loss should be symmetric");
+  b->SetPosition (Vector (311,0,0));
+  double uncacheddBm = CreateObject<ThreeLogDistancePropagationLossModel> ()->CalcRxPower (txPwrdBm, a, b);
+  NS_TEST_EXPECT_MSG_EQ_TOL (threeLog->CalcRxPower (txPwrdBm, a, b), uncacheddBm, tolerance, "Loss should be recomputed");
+  NS_TEST_EXPECT_MSG_NE (uncacheddBm, resultdBm, "Loss should depend on the distance");
+  Simulator::Destroy ();
+}
+
 class PropagationLossModelsTestSuite : public TestSuite
 {
 public:
@@ -450,6 +538,7 @@ PropagationLossModelsTestSuite::PropagationLossModelsTestSuite ()
   AddTestCase (new LogDistancePropagationLossModelTestCase, TestCase::QUICK);
   AddTestCase (new MatrixPropagationLossModelTestCase, TestCase::QUICK);
   AddTestCase (new RangePropagationLossModelTestCase, TestCase::QUICK);
+  AddTestCase (new ThreeLogDistanceNakagamiBatchTestCase, TestCase::QUICK);
 }
 
 static PropagationLossModelsTestSuite propagationLossModelsTestSuite;
@@ -0,0 +1,172 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+//
+// This program measures the cost of the InterferenceHelper bookkeeping as
+// the number of concurrent signals seen by a PHY grows.
+//
+// Signals of a fixed --duration arrive at a constant rate, chosen so that
+// --signals of them overlap at any time.  As WifiPhy does, every arrival
+// updates the CCA busy duration with GetEnergyDuration, and whenever the
+// receiver is idle it synchronizes on the new signal and computes the SNR
+// and PER of its PLCP header and payload when the signal ends.
+//
+// The output lists, per number of concurrent signals, the number of
+// signals added, the number of receptions evaluated, the wall-clock time,
+// and the wall-clock time per signal.
+//
+//   ./waf --run "interference-helper-benchmark --signals=100"
+//
+
+#include "ns3/core-module.h"
+#include "ns3/interference-helper.h"
+#include "ns3/nist-error-rate-model.h"
+#include "ns3/wifi-phy.h"
+#include "ns3/wifi-utils.h"
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+using namespace ns3;
+
+class InterferenceBenchmark
+{
+public:
+  InterferenceBenchmark (uint32_t nSignals, Time duration);
+
+  /**
+   * Run the benchmark for the given number of signals and print the results.
+   *
+   * \param nTotal the number of signals to add
+   */
+  void Run (uint32_t nTotal);
+
+private:
+  void AddSignal (uint32_t remaining);
+  void EndRx (Ptr<InterferenceHelper::Event> event);
+
+  InterferenceHelper m_interference;
+  WifiTxVector m_txVector;
+  Ptr<UniformRandomVariable> m_powerDbm;
+  uint32_t m_nSignals;
+  Time m_duration;
+  Time m_interval;
+  bool m_rxing;
+  uint64_t m_nRx;
+  double m_sumPer;
+};
+
+InterferenceBenchmark::InterferenceBenchmark (uint32_t nSignals, Time duration)
+  : m_powerDbm (CreateObject<UniformRandomVariable> ()),
+    m_nSignals (nSignals),
+    m_duration (duration),
+    m_interval (duration / nSignals),
+    m_rxing (false),
+    m_nRx (0),
+    m_sumPer (0)
+{
+  m_interference.SetNoiseFigure (DbToRatio (7));
+  m_interference.SetErrorRateModel (CreateObject<NistErrorRateModel> ());
+  m_txVector.SetMode (WifiPhy::GetOfdmRate6Mbps ());
+  m_txVector.SetPreambleType (WIFI_PREAMBLE_LONG);
+  m_txVector.SetChannelWidth (20);
+  m_txVector.SetNss (1);
+  m_powerDbm->SetAttribute ("Min", DoubleValue (-95));
+  m_powerDbm->SetAttribute ("Max", DoubleValue (-60));
+}
+
+void
+InterferenceBenchmark::AddSignal (uint32_t remaining)
+{
+  Ptr<InterferenceHelper::Event> event;
+  event = m_interference.Add (Create<Packet> (1000), m_txVector, m_duration,
+                              DbmToW (m_powerDbm->GetValue ()));
+  m_interference.GetEnergyDuration (DbmToW (-62));
+  if (!m_rxing)
+    {
+      m_rxing = true;
+      m_interference.NotifyRxStart ();
+      Simulator::Schedule (m_duration, &InterferenceBenchmark::EndRx, this, event);
+    }
+  if (remaining > 1)
+    {
+      Simulator::Schedule (m_interval, &InterferenceBenchmark::AddSignal, this, remaining - 1);
+    }
+}
+
+void
+InterferenceBenchmark::EndRx (Ptr<InterferenceHelper::Event> event)
+{
+  m_sumPer += m_interference.CalculatePlcpHeaderSnrPer (event).per;
+  m_sumPer += m_interference.CalculatePlcpPayloadSnrPer (event).per;
+  m_interference.NotifyRxEnd ();
+  m_rxing = false;
+  m_nRx++;
+}
+
+void
+InterferenceBenchmark::Run (uint32_t nTotal)
+{
+  Simulator::Schedule (Seconds (0), &InterferenceBenchmark::AddSignal, this, nTotal);
+
+  std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now ();
+  Simulator::Run ();
+  std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now ();
+  Simulator::Destroy ();
+  m_interference.EraseEvents ();
+
+  double seconds = std::chrono::duration<double> (end - begin).count ();
+  std::cout << m_nSignals << "\t" << nTotal << "\t" << m_nRx << "\t"
+            << seconds << "\t" << seconds * 1e9 / nTotal << std::endl;
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t nSignals = 0;
+  uint32_t nTotal = 100000;
+  Time duration = MilliSeconds (1);
+
+  CommandLine cmd;
+  cmd.AddValue ("signals", "Number of concurrent signals (0 runs 10, 30, 100, 300 and 1000 signals)", nSignals);
+  cmd.AddValue ("total", "Number of signals added in each run", nTotal);
+  cmd.AddValue ("duration", "Duration of every signal", duration);
+  cmd.Parse (argc, argv);
+
+  std::vector<uint32_t> sizes;
+  if (nSignals != 0)
+    {
+      sizes.push_back (nSignals);
+    }
+  else
+    {
+      sizes.push_back (10);
+      sizes.push_back (30);
+      sizes.push_back (100);
+      sizes.push_back (300);
+      sizes.push_back (1000);
+    }
+
+  std::cout << "signals\tadded\trxEvaluated\twallSeconds\tnsPerSignal" << std::endl;
+  for (std::vector<uint32_t>::const_iterator n = sizes.begin (); n != sizes.end (); n++)
+    {
+      RngSeedManager::SetSeed (1);
+      RngSeedManager::SetRun (1);
+      InterferenceBenchmark benchmark (*n, duration);
+      benchmark.Run (nTotal);
+    }
+  return 0;
+}
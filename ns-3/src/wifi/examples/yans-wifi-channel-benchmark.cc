@@ -0,0 +1,171 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+//
+// This program measures the cost of YansWifiChannel::Send with and without
+// the MaxRange culling of far away receivers.
+//
+// N ad hoc nodes are placed uniformly at random in a square whose side grows
+// with sqrt (N), so that the node density (and hence the number of nodes in
+// range of a sender) stays constant.  Every node broadcasts one packet per
+// --interval.  For each number of nodes the scenario is run twice: once with
+// MaxRange disabled and once with MaxRange derived from the loss model and
+// the energy detection threshold of the PHYs by
+// YansWifiChannel::ComputeMaxRange.
+//
+// The output lists, per run, the number of transmissions, the number of
+// receptions started by the PHYs (which must be the same in both runs), the
+// wall-clock time, and the number of transmissions simulated per second.
+//
+//   ./waf --run "yans-wifi-channel-benchmark --nodes=412"
+//
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/wifi-module.h"
+#include "ns3/propagation-loss-model.h"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+using namespace ns3;
+
+static uint64_t g_nTx = 0;
+static uint64_t g_nRx = 0;
+
+static void
+PhyTxBegin (Ptr<const Packet> p)
+{
+  g_nTx++;
+}
+
+static void
+PhyRxBegin (Ptr<const Packet> p)
+{
+  g_nRx++;
+}
+
+static void
+Broadcast (Ptr<NetDevice> device, Time interval)
+{
+  device->Send (Create<Packet> (200), device->GetBroadcast (), 1);
+  Simulator::Schedule (interval, &Broadcast, device, interval);
+}
+
+static void
+Run (uint32_t nNodes, double spacing, double maxRange, Time interval, Time simTime)
+{
+  g_nTx = 0;
+  g_nRx = 0;
+  RngSeedManager::SetSeed (1);
+  RngSeedManager::SetRun (1);
+
+  NodeContainer nodes;
+  nodes.Create (nNodes);
+
+  YansWifiChannelHelper channelHelper = YansWifiChannelHelper::Default ();
+  Ptr<YansWifiChannel> channel = channelHelper.Create ();
+  channel->SetAttribute ("MaxRange", DoubleValue (maxRange));
+
+  YansWifiPhyHelper phy = YansWifiPhyHelper::Default ();
+  phy.SetChannel (channel);
+
+  WifiHelper wifi;
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager",
+                                "DataMode", StringValue ("OfdmRate6Mbps"),
+                                "ControlMode", StringValue ("OfdmRate6Mbps"));
+  WifiMacHelper mac;
+  mac.SetType ("ns3::AdhocWifiMac");
+  NetDeviceContainer devices = wifi.Install (phy, mac, nodes);
+
+  std::ostringstream side;
+  side << "ns3::UniformRandomVariable[Min=0.0|Max=" << spacing * std::sqrt (nNodes) << "]";
+  MobilityHelper mobility;
+  mobility.SetPositionAllocator ("ns3::RandomRectanglePositionAllocator",
+                                 "X", StringValue (side.str ()),
+                                 "Y", StringValue (side.str ()));
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (nodes);
+
+  Config::ConnectWithoutContext ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Phy/PhyTxBegin",
+                                 MakeCallback (&PhyTxBegin));
+  Config::ConnectWithoutContext ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Phy/PhyRxBegin",
+                                 MakeCallback (&PhyRxBegin));
+
+  Ptr<UniformRandomVariable> start = CreateObject<UniformRandomVariable> ();
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      Simulator::Schedule (Seconds (start->GetValue (0, interval.GetSeconds ())),
+                           &Broadcast, devices.Get (i), interval);
+    }
+
+  Simulator::Stop (simTime);
+  std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now ();
+  Simulator::Run ();
+  std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now ();
+  Simulator::Destroy ();
+
+  double seconds = std::chrono::duration<double> (end - begin).count ();
+  std::cout << nNodes << "\t" << maxRange << "\t" << g_nTx << "\t" << g_nRx << "\t"
+            << seconds << "\t" << g_nTx / seconds << std::endl;
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t nNodes = 0;
+  double spacing = 100;
+  double txPowerDbm = 16.0206;
+  double edThresholdDbm = -96;
+  Time interval = MilliSeconds (100);
+  Time simTime = Seconds (5);
+
+  CommandLine cmd;
+  cmd.AddValue ("nodes", "Number of nodes (0 runs 50, 100, 200, 400 and 800 nodes)", nNodes);
+  cmd.AddValue ("spacing", "Average distance between neighbouring nodes (m)", spacing);
+  cmd.AddValue ("interval", "Broadcast interval of every node", interval);
+  cmd.AddValue ("simTime", "Simulated time of each run", simTime);
+  cmd.Parse (argc, argv);
+
+  // YansWifiChannelHelper::Default uses the default LogDistancePropagationLossModel
+  // and YansWifiPhyHelper::Default the default TxPowerStart and EnergyDetectionThreshold
+  double maxRange = YansWifiChannel::ComputeMaxRange (CreateObject<LogDistancePropagationLossModel> (),
+                                                      txPowerDbm, edThresholdDbm);
+
+  std::vector<uint32_t> sizes;
+  if (nNodes != 0)
+    {
+      sizes.push_back (nNodes);
+    }
+  else
+    {
+      for (uint32_t n = 50; n <= 800; n *= 2)
+        {
+          sizes.push_back (n);
+        }
+    }
+
+  std::cout << "nodes\tmaxRange\ttx\trxBegin\twallSeconds\ttxPerSecond" << std::endl;
+  for (std::vector<uint32_t>::const_iterator n = sizes.begin (); n != sizes.end (); n++)
+    {
+      Run (*n, spacing, 0, interval, simTime);
+      Run (*n, spacing, maxRange, interval, simTime);
+    }
+  return 0;
+}
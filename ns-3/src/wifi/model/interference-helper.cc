@@ -191,23 +191,18 @@ Time
 InterferenceHelper::GetEnergyDuration (double energyW) const
 {
   Time now = Simulator::Now ();
-  double noiseInterferenceW = 0.0;
-  Time end = now;
-  noiseInterferenceW = m_firstPower;
-  for (NiChanges::const_iterator i = m_niChanges.begin (); i != m_niChanges.end (); i++)
+  // Skip the NI changes in the past, then look for the first one after
+  // which the NI power drops below energyW
+  std::size_t i = std::lower_bound (m_niTimes.begin (), m_niTimes.end (), now) - m_niTimes.begin ();
+  if (i == m_niTimes.size ())
     {
-      noiseInterferenceW += i->GetDelta ();
-      end = i->GetTime ();
-      if (end < now)
-        {
-          continue;
-        }
-      if (noiseInterferenceW < energyW)
-        {
-          break;
-        }
+      return MicroSeconds (0);
     }
-  return end > now ? end - now : MicroSeconds (0);
+  while (i + 1 < m_niTimes.size () && m_niPowers[i] >= energyW)
+    {
+      i++;
+    }
+  return m_niTimes[i] > now ? m_niTimes[i] - now : MicroSeconds (0);
 }
 
 void
@@ -216,20 +211,14 @@ InterferenceHelper::AppendEvent (Ptr<InterferenceHelper::Event> event)
   Time now = Simulator::Now ();
   if (!m_rxing)
     {
-      NiChanges::const_iterator nowIterator = GetPosition (now);
-      for (NiChanges::const_iterator i = m_niChanges.begin (); i != nowIterator; i++)
-        {
-          m_firstPower += i->GetDelta ();
-        }
-      m_niChanges.erase (m_niChanges.begin (), nowIterator);
-      m_niChanges.insert (m_niChanges.begin (), NiChange (event->GetStartTime (), event->GetRxPowerW (), event));
+      PruneNiChanges (GetPosition (now));
+      InsertNiChange (event->GetStartTime (), event->GetRxPowerW (), event, 0);
     }
   else
     {
-      AddNiChangeEvent (NiChange (event->GetStartTime (), event->GetRxPowerW (), event));
+      AddNiChangeEvent (event->GetStartTime (), event->GetRxPowerW (), event);
     }
-  AddNiChangeEvent (NiChange (event->GetEndTime (), -event->GetRxPowerW (), event));
-
+  AddNiChangeEvent (event->GetEndTime (), -event->GetRxPowerW (), event);
 }
 
 
@@ -251,39 +240,20 @@ InterferenceHelper::CalculateSnr (double signal, double noiseInterference, uint8
 double
 InterferenceHelper::CalculateNoiseInterferenceW (Ptr<InterferenceHelper::Event> event, NiChanges *ni) const
 {
-  double noiseInterference = m_firstPower;
-  NiChanges::const_iterator eventIterator = m_niChanges.begin ();
-  while (eventIterator != m_niChanges.end ())
-    {
-      // Iterate the NI change list from the beginning to the end
-      // until find the position of the event in the NI change list
-      // The reason of using the event that causes the NI change to identify
-      // different NI changes is because in some special cases
-      // different NI changes happen at the same time with the same delta
-      // value. Therefore, it may be impossible to identify a NI change that belongs
-      // to which event based on just the NI time and NI delta value
-      if (eventIterator->GetEvent () != event)
-        {
-          // The NI changes which happen before the event should be considered
-          // as the interference. This considers the case that the receiving event
-          // arrives while another receiving event is going on. The SINR of
-          // the newly arrived event is calculated for checking the possibility of frame capture
-          noiseInterference += eventIterator->GetDelta ();
-        }
-      else
-        {
-          break;
-        }
-      ++eventIterator;
-    }
+  // The NI changes which happen before the event should be considered
+  // as the interference. This considers the case that the receiving event
+  // arrives while another receiving event is going on. The SINR of
+  // the newly arrived event is calculated for checking the possibility of frame capture
+  std::size_t start = GetEventStartPosition (event);
+  double noiseInterference = start == 0 ? m_firstPower : m_niPowers[start - 1];
 
-  for (NiChanges::const_iterator i = eventIterator + 1; i != m_niChanges.end (); ++i)
+  for (std::size_t i = start + 1; i < m_niTimes.size (); ++i)
     {
-      if (event->GetEndTime () == i->GetTime () && event == i->GetEvent ())
+      if (event->GetEndTime () == m_niTimes[i] && event == m_niEvents[i])
         {
           break;
         }
-      ni->push_back (*i);
+      ni->push_back (NiChange (m_niTimes[i], m_niDeltas[i], m_niEvents[i]));
     }
   ni->insert (ni->begin (), NiChange (event->GetStartTime (), noiseInterference, event));
   ni->push_back (NiChange (event->GetEndTime (), 0, event));
@@ -864,27 +834,78 @@ InterferenceHelper::CalculatePlcpHeaderSnrPer (Ptr<InterferenceHelper::Event> ev
 void
 InterferenceHelper::EraseEvents (void)
 {
-  m_niChanges.clear ();
+  m_niTimes.clear ();
+  m_niDeltas.clear ();
+  m_niPowers.clear ();
+  m_niEvents.clear ();
   m_rxing = false;
   m_firstPower = 0.0;
 }
 
-InterferenceHelper::NiChanges::const_iterator
-InterferenceHelper::GetPosition (Time moment)
+std::size_t
+InterferenceHelper::GetPosition (Time moment) const
 {
-  return std::upper_bound (m_niChanges.begin (), m_niChanges.end (), NiChange (moment, 0, NULL));
+  return std::upper_bound (m_niTimes.begin (), m_niTimes.end (), moment) - m_niTimes.begin ();
+}
+
+std::size_t
+InterferenceHelper::GetEventStartPosition (Ptr<const InterferenceHelper::Event> event) const
+{
+  // Several NI changes may happen at the same time, possibly with the same
+  // delta value, so the event which causes the NI change identifies it
+  std::size_t i = std::lower_bound (m_niTimes.begin (), m_niTimes.end (), event->GetStartTime ()) - m_niTimes.begin ();
+  while (i < m_niEvents.size () && m_niEvents[i] != event)
+    {
+      i++;
+    }
+  NS_ASSERT_MSG (i < m_niEvents.size (), "event is not in the NI timeline");
+  return i;
 }
 
 void
-InterferenceHelper::AddNiChangeEvent (NiChange change)
+InterferenceHelper::InsertNiChange (Time time, double delta, Ptr<InterferenceHelper::Event> event, std::size_t position)
+{
+  m_niTimes.insert (m_niTimes.begin () + position, time);
+  m_niDeltas.insert (m_niDeltas.begin () + position, delta);
+  m_niEvents.insert (m_niEvents.begin () + position, event);
+  m_niPowers.insert (m_niPowers.begin () + position, 0.0);
+  // Recompute rather than shift the following prefix sums, so that they
+  // are accumulated in the same order as a scan of the timeline would
+  double power = position == 0 ? m_firstPower : m_niPowers[position - 1];
+  for (std::size_t i = position; i < m_niPowers.size (); i++)
+    {
+      power += m_niDeltas[i];
+      m_niPowers[i] = power;
+    }
+}
+
+void
+InterferenceHelper::AddNiChangeEvent (Time time, double delta, Ptr<InterferenceHelper::Event> event)
+{
+  InsertNiChange (time, delta, event, GetPosition (time));
+}
+
+void
+InterferenceHelper::PruneNiChanges (std::size_t position)
 {
-  m_niChanges.insert (GetPosition (change.GetTime ()), change);
+  if (position == 0)
+    {
+      return;
+    }
+  m_firstPower = m_niPowers[position - 1];
+  m_niTimes.erase (m_niTimes.begin (), m_niTimes.begin () + position);
+  m_niDeltas.erase (m_niDeltas.begin (), m_niDeltas.begin () + position);
+  m_niPowers.erase (m_niPowers.begin (), m_niPowers.begin () + position);
+  m_niEvents.erase (m_niEvents.begin (), m_niEvents.begin () + position);
 }
 
 void
 InterferenceHelper::NotifyRxStart ()
 {
   NS_LOG_FUNCTION (this);
+  // The event being received starts now, so only the total power of the
+  // earlier NI changes is still needed
+  PruneNiChanges (std::lower_bound (m_niTimes.begin (), m_niTimes.end (), Simulator::Now ()) - m_niTimes.begin ());
   m_rxing = true;
 }
 
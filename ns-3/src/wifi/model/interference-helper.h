@@ -190,6 +190,9 @@ private:
 
   /**
    * Notify that RX has started.
+   *
+   * The event being received must have started at the current time: the NI
+   * changes before it are no longer needed and are pruned from the timeline.
    */
   void NotifyRxStart ();
   /**
@@ -316,24 +319,60 @@ private:
   double m_noiseFigure; /**< noise figure (linear) */
   Ptr<ErrorRateModel> m_errorRateModel; ///< error rate model
   uint8_t m_numRxAntennas; /**< the number of RX antennas in the corresponding receiver */
-  /// Experimental: needed for energy duration calculation
-  NiChanges m_niChanges;
-  double m_firstPower; ///< first power
+  /**
+   * The NI timeline, sorted by time and stored as parallel arrays: for
+   * the i-th NI change, m_niTimes[i] is its time, m_niDeltas[i] the power
+   * it adds (or removes), m_niPowers[i] the total NI power right after it
+   * (m_firstPower plus all deltas up to and including i) and m_niEvents[i]
+   * the event which causes it.  The prefix sums let the power at any point
+   * of the timeline be found with a binary search on m_niTimes.
+   */
+  std::vector<Time> m_niTimes;
+  std::vector<double> m_niDeltas; ///< power change of every NI change
+  std::vector<double> m_niPowers; ///< NI power right after every NI change
+  std::vector<Ptr<Event> > m_niEvents; ///< event causing every NI change
+  double m_firstPower; ///< NI power before the first NI change in the timeline
   bool m_rxing; ///< flag whether it is in receiving state
 
   /**
-   * Returns a const iterator to the first nichange, which is later than moment
+   * Returns the index of the first NI change which is later than moment
    *
    * \param moment time to check from
-   * \returns an iterator to the list of NiChanges
+   * \returns an index into the NI timeline
+   */
+  std::size_t GetPosition (Time moment) const;
+  /**
+   * Returns the index of the NI change which marks the start of the given event.
+   *
+   * \param event the event, which must still be in the NI timeline
+   * \returns an index into the NI timeline
    */
-  NiChanges::const_iterator GetPosition (Time moment);
+  std::size_t GetEventStartPosition (Ptr<const Event> event) const;
+  /**
+   * Insert a NI change in the timeline at the appropriate position and
+   * update the prefix sums of the following NI changes.
+   *
+   * \param time time of the NI change
+   * \param delta the power change
+   * \param event the event which causes the NI change
+   * \param position index at which to insert the NI change
+   */
+  void InsertNiChange (Time time, double delta, Ptr<Event> event, std::size_t position);
   /**
    * Add NiChange to the list at the appropriate position.
    *
-   * \param change
+   * \param time time of the NI change
+   * \param delta the power change
+   * \param event the event which causes the NI change
+   */
+  void AddNiChangeEvent (Time time, double delta, Ptr<Event> event);
+  /**
+   * Fold the NI changes before the given position into m_firstPower and
+   * remove them from the timeline.
+   *
+   * \param position index of the first NI change to keep
    */
-  void AddNiChangeEvent (NiChange change);
+  void PruneNiChanges (std::size_t position);
 };
 
 } //namespace ns3
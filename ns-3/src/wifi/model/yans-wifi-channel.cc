@@ -21,10 +21,15 @@
 #include "ns3/simulator.h"
 #include "ns3/log.h"
 #include "ns3/pointer.h"
+#include "ns3/double.h"
 #include "yans-wifi-channel.h"
 #include "ns3/propagation-loss-model.h"
 #include "ns3/propagation-delay-model.h"
+#include "ns3/mobility-model.h"
+#include "ns3/constant-position-mobility-model.h"
 #include "wifi-utils.h"
+#include <algorithm>
+#include <cmath>
 
 namespace ns3 {
 
@@ -47,11 +52,32 @@ YansWifiChannel::GetTypeId (void)
                    PointerValue (),
                    MakePointerAccessor (&YansWifiChannel::m_delay),
                    MakePointerChecker<PropagationDelayModel> ())
+    .AddAttribute ("MaxRange",
+                   "Distance (m) beyond which receivers are ignored by Send; "
+                   "0 delivers every packet to every PHY of the channel.",
+                   DoubleValue (0),
+                   MakeDoubleAccessor (&YansWifiChannel::m_maxRange),
+                   MakeDoubleChecker<double> (0))
+    .AddAttribute ("GridRefreshInterval",
+                   "Maximum age of the grid of PHY positions used when MaxRange is set.",
+                   TimeValue (MilliSeconds (100)),
+                   MakeTimeAccessor (&YansWifiChannel::m_gridRefreshInterval),
+                   MakeTimeChecker ())
+    .AddAttribute ("MaxNodeSpeed",
+                   "Upper bound of the speed (m/s) of the nodes, used to widen the "
+                   "search radius while the grid of PHY positions ages.",
+                   DoubleValue (50),
+                   MakeDoubleAccessor (&YansWifiChannel::m_maxNodeSpeed),
+                   MakeDoubleChecker<double> (0))
   ;
   return tid;
 }
 
 YansWifiChannel::YansWifiChannel ()
+  : m_maxRange (0),
+    m_maxNodeSpeed (0),
+    m_gridCellSize (0),
+    m_isGridValid (false)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -80,38 +106,170 @@ YansWifiChannel::Send (Ptr<YansWifiPhy> sender, Ptr<const Packet> packet, double
   NS_LOG_FUNCTION (this << sender << packet << txPowerDbm << duration.GetSeconds ());
   Ptr<MobilityModel> senderMobility = sender->GetMobility ();
   NS_ASSERT (senderMobility != 0);
-  for (PhyList::const_iterator i = m_phyList.begin (); i != m_phyList.end (); i++)
+  PhyList receivers;
+  if (m_maxRange <= 0)
     {
-      if (sender != (*i))
+      for (PhyList::const_iterator i = m_phyList.begin (); i != m_phyList.end (); i++)
         {
           //For now don't account for inter channel interference nor channel bonding
-          if ((*i)->GetChannelNumber () != sender->GetChannelNumber ())
+          if (sender != (*i) && (*i)->GetChannelNumber () == sender->GetChannelNumber ())
             {
-              continue;
+              receivers.push_back (*i);
             }
+        }
+    }
+  else
+    {
+      RefreshGrid ();
+      double radius = m_maxRange + m_maxNodeSpeed * (Simulator::Now () - m_gridTime).GetSeconds ();
+      Vector position = senderMobility->GetPosition ();
+      int64_t xMin = GetCellIndex (position.x - radius);
+      int64_t xMax = GetCellIndex (position.x + radius);
+      int64_t yMin = GetCellIndex (position.y - radius);
+      int64_t yMax = GetCellIndex (position.y + radius);
 
-          Ptr<MobilityModel> receiverMobility = (*i)->GetMobility ()->GetObject<MobilityModel> ();
-          Time delay = m_delay->GetDelay (senderMobility, receiverMobility);
-          double rxPowerDbm = m_loss->CalcRxPower (txPowerDbm, senderMobility, receiverMobility);
-          NS_LOG_DEBUG ("propagation: txPower=" << txPowerDbm << "dbm, rxPower=" << rxPowerDbm << "dbm, " <<
-                        "distance=" << senderMobility->GetDistanceFrom (receiverMobility) << "m, delay=" << delay);
-          Ptr<Packet> copy = packet->Copy ();
-          Ptr<NetDevice> dstNetDevice = (*i)->GetDevice ();
-          uint32_t dstNode;
-          if (dstNetDevice == 0)
+      std::vector<uint32_t> candidates;
+      for (int64_t x = xMin; x <= xMax; x++)
+        {
+          Grid::const_iterator cell = m_grid.lower_bound (std::make_pair (x, yMin));
+          for (; cell != m_grid.end () && cell->first.first == x && cell->first.second <= yMax; cell++)
             {
-              dstNode = 0xffffffff;
+              candidates.insert (candidates.end (), cell->second.begin (), cell->second.end ());
             }
-          else
+        }
+      // keep the order of m_phyList, so that receptions are scheduled in the same
+      // order as without culling
+      std::sort (candidates.begin (), candidates.end ());
+
+      for (std::vector<uint32_t>::const_iterator i = candidates.begin (); i != candidates.end (); i++)
+        {
+          Ptr<YansWifiPhy> receiver = m_phyList[*i];
+          if (sender == receiver || receiver->GetChannelNumber () != sender->GetChannelNumber ())
             {
-              dstNode = dstNetDevice->GetNode ()->GetId ();
+              continue;
+            }
+          if (CalculateDistance (position, receiver->GetMobility ()->GetPosition ()) > m_maxRange)
+            {
+              NS_LOG_LOGIC ("skipping receiver " << receiver << " out of range");
+              continue;
             }
+          receivers.push_back (receiver);
+        }
+    }
+
+  // evaluate the loss model chain for all receivers at once
+  std::vector<Ptr<MobilityModel> > receiverMobilities;
+  receiverMobilities.reserve (receivers.size ());
+  for (PhyList::const_iterator i = receivers.begin (); i != receivers.end (); i++)
+    {
+      receiverMobilities.push_back ((*i)->GetMobility ()->GetObject<MobilityModel> ());
+    }
+  std::vector<double> rxPowerDbm;
+  m_loss->CalcRxPower (txPowerDbm, senderMobility, receiverMobilities, rxPowerDbm);
+
+  for (size_t i = 0; i < receivers.size (); i++)
+    {
+      Deliver (senderMobility, receivers[i], receiverMobilities[i], packet, txPowerDbm, rxPowerDbm[i], duration);
+    }
+}
+
+void
+YansWifiChannel::Deliver (Ptr<MobilityModel> senderMobility, Ptr<YansWifiPhy> receiver,
+                          Ptr<MobilityModel> receiverMobility, Ptr<const Packet> packet,
+                          double txPowerDbm, double rxPowerDbm, Time duration) const
+{
+  Time delay = m_delay->GetDelay (senderMobility, receiverMobility);
+  NS_LOG_DEBUG ("propagation: txPower=" << txPowerDbm << "dbm, rxPower=" << rxPowerDbm << "dbm, " <<
+                "distance=" << senderMobility->GetDistanceFrom (receiverMobility) << "m, delay=" << delay);
+  Ptr<Packet> copy = packet->Copy ();
+  Ptr<NetDevice> dstNetDevice = receiver->GetDevice ();
+  uint32_t dstNode;
+  if (dstNetDevice == 0)
+    {
+      dstNode = 0xffffffff;
+    }
+  else
+    {
+      dstNode = dstNetDevice->GetNode ()->GetId ();
+    }
+
+  Simulator::ScheduleWithContext (dstNode,
+                                  delay, &YansWifiChannel::Receive,
+                                  receiver, copy, rxPowerDbm, duration);
+}
+
+void
+YansWifiChannel::RefreshGrid (void) const
+{
+  Time now = Simulator::Now ();
+  if (m_isGridValid && m_gridCellSize == m_maxRange && now - m_gridTime <= m_gridRefreshInterval)
+    {
+      return;
+    }
+  NS_LOG_FUNCTION (this);
+
+  m_grid.clear ();
+  for (uint32_t i = 0; i < m_phyList.size (); i++)
+    {
+      Vector position = m_phyList[i]->GetMobility ()->GetPosition ();
+      m_grid[std::make_pair (GetCellIndex (position.x), GetCellIndex (position.y))].push_back (i);
+    }
+  m_gridTime = now;
+  m_gridCellSize = m_maxRange;
+  m_isGridValid = true;
+}
+
+int64_t
+YansWifiChannel::GetCellIndex (double x) const
+{
+  return static_cast<int64_t> (std::floor (x / m_maxRange));
+}
 
-          Simulator::ScheduleWithContext (dstNode,
-                                          delay, &YansWifiChannel::Receive,
-                                          (*i), copy, rxPowerDbm, duration);
+double
+YansWifiChannel::ComputeMaxRange (Ptr<PropagationLossModel> loss, double txPowerDbm,
+                                  double minRxPowerDbm, double maxDistance)
+{
+  NS_LOG_FUNCTION (loss << txPowerDbm << minRxPowerDbm << maxDistance);
+  Ptr<MobilityModel> a = CreateObject<ConstantPositionMobilityModel> ();
+  Ptr<MobilityModel> b = CreateObject<ConstantPositionMobilityModel> ();
+  a->SetPosition (Vector (0, 0, 0));
+
+  double inRange = 0;
+  double outOfRange = 1;
+  // find the first power of two that is out of range, then bisect
+  for (;; outOfRange *= 2)
+    {
+      if (outOfRange >= maxDistance)
+        {
+          outOfRange = maxDistance;
+          b->SetPosition (Vector (outOfRange, 0, 0));
+          if (loss->CalcRxPower (txPowerDbm, a, b) >= minRxPowerDbm)
+            {
+              return maxDistance;
+            }
+          break;
+        }
+      b->SetPosition (Vector (outOfRange, 0, 0));
+      if (loss->CalcRxPower (txPowerDbm, a, b) < minRxPowerDbm)
+        {
+          break;
+        }
+      inRange = outOfRange;
+    }
+  while (outOfRange - inRange > 0.01)
+    {
+      double middle = (inRange + outOfRange) / 2;
+      b->SetPosition (Vector (middle, 0, 0));
+      if (loss->CalcRxPower (txPowerDbm, a, b) < minRxPowerDbm)
+        {
+          outOfRange = middle;
+        }
+      else
+        {
+          inRange = middle;
         }
     }
+  return outOfRange;
 }
 
 void
@@ -137,6 +295,7 @@ void
 YansWifiChannel::Add (Ptr<YansWifiPhy> phy)
 {
   m_phyList.push_back (phy);
+  m_isGridValid = false;
 }
 
 int64_t
@@ -22,11 +22,14 @@
 #define YANS_WIFI_CHANNEL_H
 
 #include "ns3/channel.h"
+#include "ns3/nstime.h"
 #include "yans-wifi-phy.h"
+#include <map>
 
 namespace ns3 {
 
 class NetDevice;
+class MobilityModel;
 class PropagationLossModel;
 class PropagationDelayModel;
 
@@ -38,6 +41,21 @@ class PropagationDelayModel;
  * class and supports an ns3::PropagationLossModel and an 
  * ns3::PropagationDelayModel.  By default, no propagation models are set; 
  * it is the caller's responsibility to set them before using the channel.
+ *
+ * When the MaxRange attribute is set, Send does not evaluate the
+ * propagation models (nor schedule a reception) for PHYs that are further
+ * than MaxRange away from the sender.  The candidate receivers are looked
+ * up in a uniform grid of PHY positions, with cells of MaxRange size, which
+ * is rebuilt at most every GridRefreshInterval.  Between two rebuilds the
+ * search radius is widened by MaxNodeSpeed times the age of the grid, and
+ * each candidate is then checked against its current position, so that no
+ * PHY within MaxRange is missed as long as no node moves faster than
+ * MaxNodeSpeed.  Note that skipping far away receivers also skips the
+ * random draws of stochastic loss models for them.
+ *
+ * The propagation loss chain is evaluated once per transmission for all
+ * receivers (see PropagationLossModel::CalcRxPower), which yields the
+ * same rx powers as evaluating it receiver by receiver.
  */
 class YansWifiChannel : public Channel
 {
@@ -95,6 +113,24 @@ public:
    */
   int64_t AssignStreams (int64_t stream);
 
+  /**
+   * \param loss the propagation loss model
+   * \param txPowerDbm the tx power, in dBm
+   * \param minRxPowerDbm the rx power (e.g., the energy detection threshold
+   *        of the receivers), in dBm, below which a receiver can be ignored
+   * \param maxDistance the upper bound of the search, in meters
+   * \return the distance, in meters, at which the rx power computed by \p loss
+   *         drops below \p minRxPowerDbm
+   *
+   * The loss model is evaluated along a straight line and is assumed to
+   * decrease monotonically with the distance.  Stochastic models (e.g.,
+   * Nakagami fading) should not be part of the chain passed here; use the
+   * deterministic part of the chain and, if necessary, add a safety margin
+   * before using the result as the MaxRange attribute.
+   */
+  static double ComputeMaxRange (Ptr<PropagationLossModel> loss, double txPowerDbm,
+                                 double minRxPowerDbm, double maxDistance = 100000);
+
 
 private:
   /**
@@ -114,9 +150,49 @@ private:
    */
   static void Receive (Ptr<YansWifiPhy> receiver, Ptr<Packet> packet, double txPowerDbm, Time duration);
 
+  /**
+   * Evaluate the propagation delay between the sender and the receiver
+   * and schedule the reception of the packet by the receiver.
+   *
+   * \param senderMobility the mobility model of the sender
+   * \param receiver the receiving PHY
+   * \param receiverMobility the mobility model of the receiver
+   * \param packet the packet being sent
+   * \param txPowerDbm the tx power associated to the packet being sent (dBm)
+   * \param rxPowerDbm the rx power at the receiver (dBm)
+   * \param duration the transmission duration associated with the packet being sent
+   */
+  void Deliver (Ptr<MobilityModel> senderMobility, Ptr<YansWifiPhy> receiver,
+                Ptr<MobilityModel> receiverMobility, Ptr<const Packet> packet,
+                double txPowerDbm, double rxPowerDbm, Time duration) const;
+
+  /**
+   * Rebuild the grid of PHY positions if it is older than m_gridRefreshInterval
+   */
+  void RefreshGrid (void) const;
+
+  /**
+   * \param x the coordinate
+   * \return index of the grid cell containing the coordinate
+   */
+  int64_t GetCellIndex (double x) const;
+
   PhyList m_phyList;                   //!< List of YansWifiPhys connected to this YansWifiChannel
   Ptr<PropagationLossModel> m_loss;    //!< Propagation loss model
   Ptr<PropagationDelayModel> m_delay;  //!< Propagation delay model
+
+  double m_maxRange;                   //!< Receivers further than this are ignored (m); 0 disables culling
+  Time m_gridRefreshInterval;          //!< Maximum age of the grid of PHY positions
+  double m_maxNodeSpeed;               //!< Upper bound of node speeds (m/s)
+
+  /**
+   * Grid cell coordinates (x, y) to indices in m_phyList of the PHYs it contains
+   */
+  typedef std::map<std::pair<int64_t, int64_t>, std::vector<uint32_t> > Grid;
+  mutable Grid m_grid;                 //!< PHY positions at m_gridTime
+  mutable Time m_gridTime;             //!< Time the grid was built
+  mutable double m_gridCellSize;       //!< Cell size (m) the grid was built with
+  mutable bool m_isGridValid;          //!< Whether the grid reflects m_phyList
 };
 
 } //namespace ns3
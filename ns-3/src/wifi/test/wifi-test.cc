@@ -37,6 +37,8 @@
 #include "ns3/packet-socket-server.h"
 #include "ns3/packet-socket-client.h"
 #include "ns3/packet-socket-helper.h"
+#include "ns3/double.h"
+#include <cmath>
 
 using namespace ns3;
 
@@ -1154,6 +1156,127 @@ Bug2222TestCase::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ (m_countInternalCollisions, 1, "unexpected number of internal collisions!");
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Make sure that YansWifiChannel only delivers packets to PHYs within MaxRange
+ */
+class YansWifiChannelMaxRangeTest : public TestCase
+{
+public:
+  YansWifiChannelMaxRangeTest ();
+
+  virtual void DoRun (void);
+
+
+private:
+  /**
+   * Send one broadcast packet from the first of three nodes placed at 0 m,
+   * 50 m and 500 m on the x axis
+   * \param maxRange the MaxRange attribute of the channel
+   */
+  void RunOne (double maxRange);
+  /**
+   * Count receptions at the node 50 m away
+   * \param p the packet
+   */
+  void NearRxBegin (Ptr<const Packet> p);
+  /**
+   * Count receptions at the node 500 m away
+   * \param p the packet
+   */
+  void FarRxBegin (Ptr<const Packet> p);
+
+  uint32_t m_nearReceived; ///< number of packets received by the node 50 m away
+  uint32_t m_farReceived;  ///< number of packets received by the node 500 m away
+};
+
+YansWifiChannelMaxRangeTest::YansWifiChannelMaxRangeTest ()
+  : TestCase ("Test YansWifiChannel MaxRange culling"),
+    m_nearReceived (0),
+    m_farReceived (0)
+{
+}
+
+void
+YansWifiChannelMaxRangeTest::NearRxBegin (Ptr<const Packet> p)
+{
+  m_nearReceived++;
+}
+
+void
+YansWifiChannelMaxRangeTest::FarRxBegin (Ptr<const Packet> p)
+{
+  m_farReceived++;
+}
+
+void
+YansWifiChannelMaxRangeTest::RunOne (double maxRange)
+{
+  m_nearReceived = 0;
+  m_farReceived = 0;
+
+  NodeContainer nodes;
+  nodes.Create (3);
+
+  // no propagation loss, so that every PHY of the channel would receive the packet
+  YansWifiChannelHelper channelHelper;
+  channelHelper.SetPropagationDelay ("ns3::ConstantSpeedPropagationDelayModel");
+  channelHelper.AddPropagationLoss ("ns3::MatrixPropagationLossModel",
+                                    "DefaultLoss", DoubleValue (0));
+  Ptr<YansWifiChannel> channel = channelHelper.Create ();
+  channel->SetAttribute ("MaxRange", DoubleValue (maxRange));
+
+  YansWifiPhyHelper phy = YansWifiPhyHelper::Default ();
+  phy.SetChannel (channel);
+
+  WifiHelper wifi;
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager",
+                                "DataMode", StringValue ("OfdmRate6Mbps"),
+                                "ControlMode", StringValue ("OfdmRate6Mbps"));
+  WifiMacHelper mac;
+  mac.SetType ("ns3::AdhocWifiMac");
+  NetDeviceContainer devices = wifi.Install (phy, mac, nodes);
+
+  MobilityHelper mobility;
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  positionAlloc->Add (Vector (0.0, 0.0, 0.0));
+  positionAlloc->Add (Vector (50.0, 0.0, 0.0));
+  positionAlloc->Add (Vector (500.0, 0.0, 0.0));
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (nodes);
+
+  DynamicCast<WifiNetDevice> (devices.Get (1))->GetPhy ()->TraceConnectWithoutContext ("PhyRxBegin", MakeCallback (&YansWifiChannelMaxRangeTest::NearRxBegin, this));
+  DynamicCast<WifiNetDevice> (devices.Get (2))->GetPhy ()->TraceConnectWithoutContext ("PhyRxBegin", MakeCallback (&YansWifiChannelMaxRangeTest::FarRxBegin, this));
+
+  Ptr<NetDevice> sender = devices.Get (0);
+  Simulator::Schedule (Seconds (1.0), &NetDevice::Send, sender, Create<Packet> (100),
+                       sender->GetBroadcast (), 1);
+
+  Simulator::Stop (Seconds (2.0));
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+void
+YansWifiChannelMaxRangeTest::DoRun (void)
+{
+  RunOne (0);
+  NS_TEST_ASSERT_MSG_EQ (m_nearReceived, 1, "near node should receive the broadcast without culling");
+  NS_TEST_ASSERT_MSG_EQ (m_farReceived, 1, "far node should receive the broadcast without culling");
+
+  RunOne (100);
+  NS_TEST_ASSERT_MSG_EQ (m_nearReceived, 1, "near node is within MaxRange");
+  NS_TEST_ASSERT_MSG_EQ (m_farReceived, 0, "far node is beyond MaxRange");
+
+  // 16 dBm - 46.6777 dB at 1 m, exponent 3, -96 dBm threshold
+  Ptr<LogDistancePropagationLossModel> loss = CreateObject<LogDistancePropagationLossModel> ();
+  double range = YansWifiChannel::ComputeMaxRange (loss, 16, -96);
+  NS_TEST_ASSERT_MSG_EQ_TOL (range, std::pow (10.0, (16 + 96 - 46.6777) / 30), 0.02, "unexpected range of LogDistancePropagationLossModel");
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -1176,6 +1299,7 @@ WifiTestSuite::WifiTestSuite ()
   AddTestCase (new Bug730TestCase, TestCase::QUICK); //Bug 730
   AddTestCase (new SetChannelFrequencyTest, TestCase::QUICK);
   AddTestCase (new Bug2222TestCase, TestCase::QUICK); //Bug 2222
+  AddTestCase (new YansWifiChannelMaxRangeTest, TestCase::QUICK);
 }
 
 static WifiTestSuite g_wifiTestSuite; ///< the test suite
@@ -0,0 +1,166 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2017 Regents of the University of California
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include "ns3/core-module.h"
+
+using namespace ns3;
+
+/**
+ * Timer-like workload: a population of pending events, most of which
+ * are removed and rescheduled before they expire, the way per-packet
+ * protocol timers (e.g. NFD PIT entry timers) are.
+ */
+class RemoveBench
+{
+public:
+  /**
+   * constructor
+   * \param population number of pending timers
+   * \param total number of events to run
+   * \param removals number of timers removed and rescheduled per event
+   */
+  RemoveBench (uint32_t population, uint32_t total, uint32_t removals)
+    : m_timers (population),
+      m_total (total),
+      m_removals (removals),
+      m_count (0),
+      m_nRemoved (0)
+  {
+    m_delay = CreateObject<UniformRandomVariable> ();
+    m_delay->SetAttribute ("Min", DoubleValue (1000));
+    m_delay->SetAttribute ("Max", DoubleValue (1000000));
+    m_timer = CreateObject<UniformRandomVariable> ();
+  }
+
+  /**
+   * Run the workload with a scheduler
+   * \param schedulerType TypeId name of the scheduler
+   */
+  void RunBench (const std::string &schedulerType);
+
+private:
+  /**
+   * Timer expiration
+   * \param i timer index
+   */
+  void Cb (uint32_t i);
+  /**
+   * (Re)schedule a timer
+   * \param i timer index
+   */
+  void Start (uint32_t i);
+
+  std::vector<EventId> m_timers; ///< pending timers
+  uint32_t m_total; ///< number of events to run
+  uint32_t m_removals; ///< removals per event
+  uint32_t m_count; ///< number of events run so far
+  uint64_t m_nRemoved; ///< number of removed timers
+  Ptr<UniformRandomVariable> m_delay; ///< timer delay, in ns
+  Ptr<UniformRandomVariable> m_timer; ///< timer selection
+};
+
+void
+RemoveBench::Start (uint32_t i)
+{
+  m_timers[i] = Simulator::Schedule (NanoSeconds (m_delay->GetInteger ()),
+                                     &RemoveBench::Cb, this, i);
+}
+
+void
+RemoveBench::Cb (uint32_t i)
+{
+  if (m_count >= m_total)
+    {
+      return;
+    }
+  ++m_count;
+  Start (i);
+  for (uint32_t k = 0; k < m_removals; ++k)
+    {
+      uint32_t j = m_timer->GetInteger (0, m_timers.size () - 1);
+      Simulator::Remove (m_timers[j]);
+      ++m_nRemoved;
+      Start (j);
+    }
+}
+
+void
+RemoveBench::RunBench (const std::string &schedulerType)
+{
+  Simulator::SetScheduler (ObjectFactory (schedulerType));
+  m_count = 0;
+  m_nRemoved = 0;
+
+  SystemWallClockMs time;
+  time.Start ();
+  for (uint32_t i = 0; i < m_timers.size (); ++i)
+    {
+      Start (i);
+    }
+  Simulator::Run ();
+  double seconds = time.End () / 1000.0;
+  Simulator::Destroy ();
+
+  std::cout << std::left << std::setw (28) << schedulerType
+            << std::setw (12) << seconds
+            << std::setw (14) << m_count / seconds
+            << std::setw (14) << m_nRemoved / seconds
+            << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t pop = 100000;
+  uint32_t total = 1000000;
+  uint32_t removals = 1;
+  std::string schedulers = "ns3::MapScheduler,ns3::HeapScheduler,"
+    "ns3::IndexedHeapScheduler,ns3::CalendarScheduler";
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark event removal with the simulator schedulers.\n"
+             "\n"
+             "Each event reschedules itself, then removes and reschedules\n"
+             "--removals other pending events chosen at random.");
+  cmd.AddValue ("pop",        "number of pending events (default 1E5)",    pop);
+  cmd.AddValue ("total",      "total number of events to run (default 1E6)", total);
+  cmd.AddValue ("removals",   "events removed per event run (default 1)",  removals);
+  cmd.AddValue ("schedulers", "comma-separated list of scheduler types",   schedulers);
+  cmd.Parse (argc, argv);
+
+  std::cout << "population: " << pop << ", total events: " << total
+            << ", removals per event: " << removals << std::endl << std::endl;
+  std::cout << std::left << std::setw (28) << "Scheduler"
+            << std::setw (12) << "Time (s)"
+            << std::setw (14) << "Rate (ev/s)"
+            << std::setw (14) << "Removals/s"
+            << std::endl;
+
+  RemoveBench bench (pop, total, removals);
+  std::istringstream types (schedulers);
+  std::string type;
+  while (std::getline (types, type, ','))
+    {
+      bench.RunBench (type);
+    }
+  return 0;
+}